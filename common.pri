@@ -68,6 +68,12 @@ isEmpty( CXX_CPP11_FLAG) {
     QMAKE_CXXFLAGS += $$CXX_CPP11_FLAG -g
 }
 
+# 2D only build: RS_Vector without z coordinate (24 instead of 32 bytes).
+# Enable with: qmake CONFIG+=vector2d
+vector2d {
+    DEFINES += RS_VECTOR2D=1
+}
+
 # svg support
 QT += svg
 greaterThan( QT_MAJOR_VERSION, 4 ) {
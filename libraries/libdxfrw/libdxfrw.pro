@@ -29,6 +29,7 @@ QT -= svg
 
 SOURCES += \
     src/libdxfrw.cpp \
+    src/drw_arena.cpp \
     src/drw_entities.cpp \
     src/drw_objects.cpp \
     src/intern/drw_textcodec.cpp \
@@ -38,6 +39,7 @@ SOURCES += \
 HEADERS += \
     src/libdxfrw.h \
     src/drw_base.h \
+    src/drw_arena.h \
     src/drw_entities.h \
     src/drw_objects.h \
     src/intern/drw_textcodec.h \
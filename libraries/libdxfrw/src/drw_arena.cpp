@@ -0,0 +1,86 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  Copyright (C) 2011 Rallaz, rallazz@gmail.com                             **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#include <new>
+#include "drw_arena.h"
+
+namespace {
+//! Arena new objects of the calling thread are placed in, NULL for the heap
+thread_local DRW_Arena* activeArena = NULL;
+
+//! Size of the block requested from the heap at once
+const size_t blockSize = 64*1024;
+
+//! Every object is preceded by the arena it's in (NULL if on the heap)
+const size_t alignment = alignof(std::max_align_t);
+const size_t headerSize = (sizeof(DRW_Arena*) + alignment - 1) / alignment * alignment;
+}
+
+DRW_Arena::DRW_Arena(){
+    next = end = NULL;
+}
+
+DRW_Arena::~DRW_Arena(){
+    for (std::vector<char*>::iterator it=blocks.begin(); it!=blocks.end(); ++it)
+        ::operator delete(*it);
+}
+
+/*!
+*  Returns memory for an object of the given size, in the active arena if
+*  there's one.
+*/
+void* DRW_Arena::allocate(size_t size){
+    DRW_Arena *arena = activeArena;
+    size_t total = headerSize + (size + alignment - 1) / alignment * alignment;
+    char *p = (arena != NULL) ? arena->take(total)
+                              : static_cast<char*>(::operator new(total));
+    *reinterpret_cast<DRW_Arena**>(p) = arena;
+    return p + headerSize;
+}
+
+/*!
+*  Frees an object created on the heap, objects in an arena are freed
+*  with their arena.
+*/
+void DRW_Arena::deallocate(void* p){
+    if (p == NULL)
+        return;
+    char *base = static_cast<char*>(p) - headerSize;
+    if (*reinterpret_cast<DRW_Arena**>(base) == NULL)
+        ::operator delete(base);
+}
+
+char* DRW_Arena::take(size_t size){
+    //large objects get a block of their own, the current block stays in use
+    if (size > blockSize/4) {
+        char *block = static_cast<char*>(::operator new(size));
+        blocks.push_back(block);
+        return block;
+    }
+    if (next == NULL || size > static_cast<size_t>(end - next)) {
+        next = static_cast<char*>(::operator new(blockSize));
+        end = next + blockSize;
+        blocks.push_back(next);
+    }
+    char *p = next;
+    next += size;
+    return p;
+}
+
+DRW_Arena::Scope::Scope(DRW_Arena* arena){
+    previous = activeArena;
+    activeArena = arena;
+}
+
+DRW_Arena::Scope::~Scope(){
+    activeArena = previous;
+}
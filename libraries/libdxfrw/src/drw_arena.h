@@ -0,0 +1,70 @@
+/******************************************************************************
+**  libDXFrw - Library to read/write DXF files (ascii & binary)              **
+**                                                                           **
+**  Copyright (C) 2011 Rallaz, rallazz@gmail.com                             **
+**                                                                           **
+**  This library is free software, licensed under the terms of the GNU       **
+**  General Public License as published by the Free Software Foundation,     **
+**  either version 2 of the License, or (at your option) any later version.  **
+**  You should have received a copy of the GNU General Public License        **
+**  along with this program.  If not, see <http://www.gnu.org/licenses/>.    **
+******************************************************************************/
+
+#ifndef DRW_ARENA_H
+#define DRW_ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+//! Memory arena for the records of one read
+/*!
+*  Objects of classes declared with DRW_ARENA_ALLOCATED which are created
+*  while an arena is active on the calling thread (see DRW_Arena::Scope)
+*  are placed in that arena. Deleting them does nothing, the memory of
+*  all of them is released at once when the arena is destroyed. Objects
+*  created without an active arena live on the heap as usual.
+*
+*  dxfRW owns one arena and activates it during read(), so the vertices,
+*  hatch loops and edges and extended data of a read are freed together
+*  with the reader.
+*/
+class DRW_Arena {
+public:
+    DRW_Arena();
+    ~DRW_Arena();
+
+    static void* allocate(size_t size);
+    static void deallocate(void* p);
+
+    //! Makes an arena the active one of the calling thread while it exists
+    class Scope {
+    public:
+        explicit Scope(DRW_Arena* arena);
+        ~Scope();
+    private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+        DRW_Arena* previous;
+    };
+
+private:
+    DRW_Arena(const DRW_Arena&);
+    DRW_Arena& operator=(const DRW_Arena&);
+    char* take(size_t size);
+
+    std::vector<char*> blocks;
+    char* next;
+    char* end;
+};
+
+//! Declares class specific operator new/delete using DRW_Arena
+#define DRW_ARENA_ALLOCATED \
+public: \
+    static void* operator new(size_t size) { return DRW_Arena::allocate(size); } \
+    static void operator delete(void* p) { DRW_Arena::deallocate(p); } \
+    static void* operator new(size_t, void* p) { return p; } \
+    static void operator delete(void*, void*) {}
+
+#endif
+
+// EOF
@@ -17,6 +17,7 @@
 
 #include <string>
 #include <cmath>
+#include "drw_arena.h"
 
 #define UTF8STRING std::string
 #define DRW_UNUSED(x) (void)x
@@ -136,6 +137,8 @@ public:
 *  @author Rallaz
 */
 class DRW_Variant {
+    DRW_ARENA_ALLOCATED
+
 public:
     enum TYPE {
         STRING,
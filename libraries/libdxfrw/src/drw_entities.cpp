@@ -11,10 +11,23 @@
 ******************************************************************************/
 
 #include <cstdlib>
+#include <algorithm>
 #include "drw_entities.h"
 #include "intern/dxfreader.h"
 
 
+//! Reserve room for a count read from the file
+/*!
+*   Negative counts are ignored and huge ones capped, the list grows
+*   beyond that while the items are read.
+*/
+template<class T>
+static void reserveCount(std::vector<T> &list, int count){
+    if (count > 0)
+        list.reserve(std::min(count, 1 << 16));
+}
+
+
 //! Calculate arbitary axis
 /*!
 *   Calculate arbitary axis for apply extrusions
@@ -440,11 +453,11 @@ void DRW_LWPolyline::applyExtrusion(){
     if (haveExtrusion) {
         calculateAxis(extPoint);
         for (unsigned int i=0; i<vertlist.size(); i++) {
-            DRW_Vertex2D *vert = vertlist.at(i);
-            DRW_Coord v(vert->x, vert->y, elevation);
+            DRW_Vertex2D &vert = vertlist.at(i);
+            DRW_Coord v(vert.x, vert.y, elevation);
             extrudePoint(extPoint, &v);
-            vert->x = v.x;
-            vert->y = v.y;
+            vert.x = v.x;
+            vert.y = v.y;
         }
     }
 }
@@ -452,8 +465,7 @@ void DRW_LWPolyline::applyExtrusion(){
 void DRW_LWPolyline::parseCode(int code, dxfReader *reader){
     switch (code) {
     case 10: {
-        vertex = new DRW_Vertex2D();
-        vertlist.push_back(vertex);
+        vertex = addVertex();
         vertex->x = reader->getDouble();
         break; }
     case 20:
@@ -486,7 +498,7 @@ void DRW_LWPolyline::parseCode(int code, dxfReader *reader){
         break;
     case 90:
         vertexnum = reader->getInt32();
-        vertlist.reserve(vertexnum);
+        reserveCount(vertlist, vertexnum);
         break;
     case 210:
         haveExtrusion = true;
@@ -719,16 +731,16 @@ void DRW_Hatch::parseCode(int code, dxfReader *reader){
         break;
     case 91:
         loopsnum = reader->getInt32();
-        looplist.reserve(loopsnum);
+        reserveCount(looplist, loopsnum);
         break;
     case 92:
         loop = new DRW_HatchLoop(reader->getInt32());
-        looplist.push_back(loop);
+        appendLoop(loop);
         if (reader->getInt32() & 2) {
             ispol = true;
             clearEntities();
             pline = new DRW_LWPolyline;
-            loop->objlist.push_back(pline);
+            loop->objlist.push_back(std::shared_ptr<DRW_Entity>(pline));
         } else ispol = false;
         break;
     case 93:
@@ -781,12 +793,15 @@ void DRW_Spline::parseCode(int code, dxfReader *reader){
         break;
     case 72:
         nknots = reader->getInt32();
+        reserveCount(knotslist, nknots);
         break;
     case 73:
         ncontrol = reader->getInt32();
+        reserveCount(controllist, ncontrol);
         break;
     case 74:
         nfit = reader->getInt32();
+        reserveCount(fitlist, nfit);
         break;
     case 42:
         tolknot = reader->getDouble();
@@ -798,8 +813,8 @@ void DRW_Spline::parseCode(int code, dxfReader *reader){
         tolfit = reader->getDouble();
         break;
     case 10: {
-        controlpoint = new DRW_Coord();
-        controllist.push_back(controlpoint);
+        controllist.push_back(DRW_Coord());
+        controlpoint = &controllist.back();
         controlpoint->x = reader->getDouble();
         break; }
     case 20:
@@ -811,8 +826,8 @@ void DRW_Spline::parseCode(int code, dxfReader *reader){
             controlpoint->z = reader->getDouble();
         break;
     case 11: {
-        fitpoint = new DRW_Coord();
-        fitlist.push_back(fitpoint);
+        fitlist.push_back(DRW_Coord());
+        fitpoint = &fitlist.back();
         fitpoint->x = reader->getDouble();
         break; }
     case 21:
@@ -1001,6 +1016,7 @@ void DRW_Leader::parseCode(int code, dxfReader *reader){
         break;
     case 76:
         vertnum = reader->getInt32();
+        reserveCount(vertexlist, vertnum);
         break;
     case 77:
         coloruse = reader->getInt32();
@@ -1012,8 +1028,8 @@ void DRW_Leader::parseCode(int code, dxfReader *reader){
         textwidth = reader->getDouble();
         break;
     case 10: {
-        vertexpoint = new DRW_Coord();
-        vertexlist.push_back(vertexpoint);
+        vertexlist.push_back(DRW_Coord());
+        vertexpoint = &vertexlist.back();
         vertexpoint->x = reader->getDouble();
         break; }
     case 20:
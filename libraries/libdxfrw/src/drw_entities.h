@@ -16,6 +16,7 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include "drw_base.h"
 
 class dxfReader;
@@ -68,6 +69,8 @@ namespace DRW {
 *  @author Rallaz
 */
 class DRW_Entity {
+    DRW_ARENA_ALLOCATED
+
 public:
     //initializes default values
     DRW_Entity() {
@@ -394,28 +397,14 @@ public:
         extPoint.z = 1;
         vertex = NULL;
     }
-    ~DRW_LWPolyline() {
-        while (!vertlist.empty()) {
-           vertlist.pop_back();
-         }
-    }
     virtual void applyExtrusion();
-    void addVertex (DRW_Vertex2D v) {
-        DRW_Vertex2D *vert = new DRW_Vertex2D();
-        vert->x = v.x;
-        vert->y = v.y;
-        vert->stawidth = v.stawidth;
-        vert->endwidth = v.endwidth;
-        vert->bulge = v.bulge;
-        vertlist.push_back(vert);
+    void addVertex (const DRW_Vertex2D &v) {
+        vertlist.push_back(v);
     }
+    /*!< appends a zero initialized vertex, the returned pointer is valid until the next vertex is added */
     DRW_Vertex2D *addVertex () {
-        DRW_Vertex2D *vert = new DRW_Vertex2D();
-        vert->stawidth = 0;
-        vert->endwidth = 0;
-        vert->bulge = 0;
-        vertlist.push_back(vert);
-        return vert;
+        vertlist.push_back(DRW_Vertex2D());
+        return &vertlist.back();
     }
 
     void parseCode(int code, dxfReader *reader);
@@ -428,7 +417,7 @@ public:
     double thickness;         /*!< thickness, code 39 */
     DRW_Coord extPoint;       /*!<  Dir extrusion normal vector, code 210, 220 & 230 */
     DRW_Vertex2D *vertex;       /*!< current vertex to add data */
-    std::vector<DRW_Vertex2D *> vertlist;  /*!< vertex list */
+    std::vector<DRW_Vertex2D> vertlist;  /*!< vertex list */
 };
 
 //! Class to handle insert entries
@@ -620,15 +609,7 @@ public:
         ex = ey = 0.0;
         ez = 1.0;
         tolknot = tolcontrol = tolfit = 0.0000001;
-
-    }
-    ~DRW_Spline() {
-        while (!controllist.empty()) {
-           controllist.pop_back();
-        }
-        while (!fitlist.empty()) {
-           fitlist.pop_back();
-        }
+        controlpoint = fitpoint = NULL;
     }
     virtual void applyExtrusion(){}
 
@@ -654,8 +635,8 @@ public:
     double tolfit;            /*!< fit point tolerance, code 44, default 0.0000001 */
 
     std::vector<double> knotslist;           /*!< knots list, code 40 */
-    std::vector<DRW_Coord *> controllist;  /*!< control points list, code 10, 20 & 30 */
-    std::vector<DRW_Coord *> fitlist;      /*!< fit points list, code 11, 21 & 31 */
+    std::vector<DRW_Coord> controllist;  /*!< control points list, code 10, 20 & 30 */
+    std::vector<DRW_Coord> fitlist;      /*!< fit points list, code 11, 21 & 31 */
 
 private:
     DRW_Coord *controlpoint;   /*!< current control point to add data */
@@ -668,21 +649,14 @@ private:
 *  @author Rallaz
 */
 class DRW_HatchLoop {
+    DRW_ARENA_ALLOCATED
+
 public:
     DRW_HatchLoop(int t) {
         type = t;
         numedges = 0;
     }
 
-    ~DRW_HatchLoop() {
-/*        while (!pollist.empty()) {
-           pollist.pop_back();
-         }*/
-        while (!objlist.empty()) {
-           objlist.pop_back();
-         }
-    }
-
     void update() {
         numedges = objlist.size();
     }
@@ -692,7 +666,7 @@ public:
     int numedges;           /*!< number of edges (if not a polyline), code 93 */
 //TODO: store lwpolylines as entities
 //    std::vector<DRW_LWPolyline *> pollist;  /*!< polyline list */
-    std::vector<DRW_Entity *> objlist;      /*!< entities list */
+    std::vector<std::shared_ptr<DRW_Entity> > objlist;      /*!< entities list */
 };
 
 //! Class to handle hatch entity
@@ -714,14 +688,8 @@ public:
         clearEntities();
     }
 
-    ~DRW_Hatch() {
-        while (!looplist.empty()) {
-           looplist.pop_back();
-         }
-    }
-
     void appendLoop (DRW_HatchLoop *v) {
-        looplist.push_back(v);
+        looplist.push_back(std::shared_ptr<DRW_HatchLoop>(v));
     }
 
     virtual void applyExtrusion(){}
@@ -739,7 +707,7 @@ public:
     double scale;              /*!< hatch pattern scale, code 41 */
     int deflines;              /*!< number of pattern definition lines, code 78 */
 
-    std::vector<DRW_HatchLoop *> looplist;  /*!< polyline list */
+    std::vector<std::shared_ptr<DRW_HatchLoop> > looplist;  /*!< polyline list */
 
 private:
     void clearEntities(){
@@ -755,7 +723,7 @@ private:
         clearEntities();
         if (loop) {
             pt = line = new DRW_Line;
-            loop->objlist.push_back(line);
+            loop->objlist.push_back(std::shared_ptr<DRW_Entity>(line));
         }
     }
 
@@ -763,7 +731,7 @@ private:
         clearEntities();
         if (loop) {
             pt = arc = new DRW_Arc;
-            loop->objlist.push_back(arc);
+            loop->objlist.push_back(std::shared_ptr<DRW_Entity>(arc));
         }
     }
 
@@ -771,7 +739,7 @@ private:
         clearEntities();
         if (loop) {
             pt = ellipse = new DRW_Ellipse;
-            loop->objlist.push_back(ellipse);
+            loop->objlist.push_back(std::shared_ptr<DRW_Entity>(ellipse));
         }
     }
 
@@ -780,7 +748,7 @@ private:
         if (loop) {
             pt = NULL;
             spline = new DRW_Spline;
-            loop->objlist.push_back(spline);
+            loop->objlist.push_back(std::shared_ptr<DRW_Entity>(spline));
         }
     }
 
@@ -1116,11 +1084,7 @@ public:
         extrusionPoint.x = extrusionPoint.y = 0.0;
         arrow = 1;
         extrusionPoint.z = 1.0;
-    }
-    ~DRW_Leader() {
-        while (!vertexlist.empty()) {
-           vertexlist.pop_back();
-        }
+        vertexpoint = NULL;
     }
 
     virtual void applyExtrusion(){}
@@ -1143,7 +1107,7 @@ public:
     DRW_Coord offsetblock;     /*!< Offset of last leader vertex from block, code 212, 222 & 232 */
     DRW_Coord offsettext;      /*!< Offset of last leader vertex from annotation, code 213, 223 & 233 */
 
-    std::vector<DRW_Coord *> vertexlist;  /*!< vertex points list, code 10, 20 & 30 */
+    std::vector<DRW_Coord> vertexlist;  /*!< vertex points list, code 10, 20 & 30 */
 
 private:
     DRW_Coord *vertexpoint;   /*!< current control point to add data */
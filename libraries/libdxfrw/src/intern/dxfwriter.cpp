@@ -23,7 +23,7 @@
 #define DBG(a)
 #endif
 
-//RLZ TODO change std::endl to x0D x0A (13 10)
+//RLZ TODO change '\n' to x0D x0A (13 10)
 /*bool dxfWriter::readRec(int *codeData, bool skip) {
 //    std::string text;
     int code;
@@ -98,19 +98,19 @@
     return (filestr->good());
 }*/
 
-bool dxfWriter::writeUtf8String(int code, std::string text) {
+bool dxfWriter::writeUtf8String(int code, const std::string &text) {
     std::string t = encoder.fromUtf8(text);
     return writeString(code, t);
 }
 
-bool dxfWriter::writeUtf8Caps(int code, std::string text) {
+bool dxfWriter::writeUtf8Caps(int code, const std::string &text) {
     std::string strname = text;
     std::transform(strname.begin(), strname.end(), strname.begin(),::toupper);
     std::string t = encoder.fromUtf8(strname);
     return writeString(code, t);
 }
 
-bool dxfWriterBinary::writeString(int code, std::string text) {
+bool dxfWriterBinary::writeString(int code, const std::string &text) {
     char bufcode[2];
     bufcode[0] =code & 0xFF;
     bufcode[1] =code  >> 8;
@@ -221,8 +221,9 @@ bool dxfWriterBinary::writeBool(int code, bool data) {
     return (filestr->good());
 }
 
-bool dxfWriterAscii::writeString(int code, std::string text) {
-    *filestr << code << std::endl << text << std::endl ;
+//'\n' instead of std::endl, flushing every line makes writing very slow
+bool dxfWriterAscii::writeString(int code, const std::string &text) {
+    *filestr << code << '\n' << text << '\n';
     /*    std::getline(*filestr, strData, '\0');
     DBG(strData); DBG("\n");*/
     return (filestr->good());
@@ -252,7 +253,7 @@ bool dxfWriterAscii::writeString(int code, std::string text) {
 
 bool dxfWriterAscii::writeInt16(int code, int data) {
 //    *filestr << code << "\r\n" << data << "\r\n";
-    *filestr << code << std::endl << data << std::endl;
+    *filestr << code << '\n' << data << '\n';
     return (filestr->good());
 }
 
@@ -261,21 +262,21 @@ bool dxfWriterAscii::writeInt32(int code, int data) {
 }
 
 bool dxfWriterAscii::writeInt64(int code, unsigned long long int data) {
-    *filestr << code << std::endl << data << std::endl;
+    *filestr << code << '\n' << data << '\n';
     return (filestr->good());
 }
 
 bool dxfWriterAscii::writeDouble(int code, double data) {
     std::streamsize prec = filestr->precision();
     filestr->precision(12);
-    *filestr << code << std::endl << data << std::endl;
+    *filestr << code << '\n' << data << '\n';
     filestr->precision(prec);
     return (filestr->good());
 }
 
 //saved as int or add a bool member??
 bool dxfWriterAscii::writeBool(int code, bool data) {
-    *filestr << code << std::endl << data << std::endl;
+    *filestr << code << '\n' << data << '\n';
     return (filestr->good());
 }
 
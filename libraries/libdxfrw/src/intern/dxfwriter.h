@@ -19,9 +19,9 @@ class dxfWriter {
 public:
     dxfWriter(std::ofstream *stream){filestr = stream; /*count =0;*/}
     virtual ~dxfWriter(){}
-    virtual bool writeString(int code, std::string text) = 0;
-    bool writeUtf8String(int code, std::string text);
-    bool writeUtf8Caps(int code, std::string text);
+    virtual bool writeString(int code, const std::string &text) = 0;
+    bool writeUtf8String(int code, const std::string &text);
+    bool writeUtf8Caps(int code, const std::string &text);
     std::string fromUtf8String(std::string t) {return encoder.fromUtf8(t);}
     virtual bool writeInt16(int code, int data) = 0;
     virtual bool writeInt32(int code, int data) = 0;
@@ -41,7 +41,7 @@ class dxfWriterBinary : public dxfWriter {
 public:
     dxfWriterBinary(std::ofstream *stream):dxfWriter(stream){ }
     virtual ~dxfWriterBinary() {}
-    virtual bool writeString(int code, std::string text);
+    virtual bool writeString(int code, const std::string &text);
     virtual bool writeInt16(int code, int data);
     virtual bool writeInt32(int code, int data);
     virtual bool writeInt64(int code, unsigned long long int data);
@@ -53,7 +53,7 @@ class dxfWriterAscii : public dxfWriter {
 public:
     dxfWriterAscii(std::ofstream *stream):dxfWriter(stream){ }
     virtual ~dxfWriterAscii(){}
-    virtual bool writeString(int code, std::string text);
+    virtual bool writeString(int code, const std::string &text);
     virtual bool writeInt16(int code, int data);
     virtual bool writeInt32(int code, int data);
     virtual bool writeInt64(int code, unsigned long long int data);
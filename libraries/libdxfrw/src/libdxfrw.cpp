@@ -77,6 +77,7 @@ bool dxfRW::read(DRW_Interface *interface_, bool ext){
     filestr.read (line, 22);
     filestr.close();
     iface = interface_;
+    DRW_Arena::Scope arenaScope(&arena);
     DBG("dxfRW::read 2\n");
     if (strcmp(line, line2) == 0) {
         filestr.open (fileName.c_str(), std::ios_base::in | std::ios::binary);
@@ -157,26 +158,33 @@ bool dxfRW::write(DRW_Interface *interface_, DRW::Version ver, bool bin){
 bool dxfRW::writeEntity(DRW_Entity *ent) {
     ent->handle = ++entCount;
     writer->writeString(5, toHexStr(ent->handle));
+    writeEntityAttributes(ent->space, ent->layer, ent->lineType, ent->color,
+                          ent->color24, ent->lWeight);
+    return true;
+}
+
+void dxfRW::writeEntityAttributes(int space, const std::string &layer,
+                                  const std::string &lineType, int color,
+                                  int color24, DRW_LW_Conv::lineWidth lWeight) {
     if (version > DRW::AC1009) {
         writer->writeString(100, "AcDbEntity");
     }
-    if (ent->space == 1)
+    if (space == 1)
         writer->writeInt16(67, 1);
     if (version > DRW::AC1009) {
-        writer->writeUtf8String(8, ent->layer);
-        writer->writeUtf8String(6, ent->lineType);
+        writer->writeUtf8String(8, layer);
+        writer->writeUtf8String(6, lineType);
     } else {
-        writer->writeUtf8Caps(8, ent->layer);
-        writer->writeUtf8Caps(6, ent->lineType);
+        writer->writeUtf8Caps(8, layer);
+        writer->writeUtf8Caps(6, lineType);
     }
-    writer->writeInt16(62, ent->color);
-    if (version > DRW::AC1015 && ent->color24 >= 0) {
-        writer->writeInt32(420, ent->color24);
+    writer->writeInt16(62, color);
+    if (version > DRW::AC1015 && color24 >= 0) {
+        writer->writeInt32(420, color24);
     }
     if (version > DRW::AC1014) {
-        writer->writeInt16(370, DRW_LW_Conv::lineWidth2dxfInt(ent->lWeight));
+        writer->writeInt16(370, DRW_LW_Conv::lineWidth2dxfInt(lWeight));
     }
-    return true;
 }
 
 bool dxfRW::writeLineType(DRW_LType *ent){
@@ -728,15 +736,15 @@ bool dxfRW::writeLWPolyline(DRW_LWPolyline *ent){
         if (ent->thickness != 0)
             writer->writeDouble(39, ent->thickness);
         for (int i = 0;  i< ent->vertexnum; i++){
-            DRW_Vertex2D *v = ent->vertlist.at(i);
-            writer->writeDouble(10, v->x);
-            writer->writeDouble(20, v->y);
-            if (v->stawidth != 0)
-                writer->writeDouble(40, v->stawidth);
-            if (v->endwidth != 0)
-                writer->writeDouble(41, v->endwidth);
-            if (v->bulge != 0)
-                writer->writeDouble(42, v->bulge);
+            const DRW_Vertex2D &v = ent->vertlist.at(i);
+            writer->writeDouble(10, v.x);
+            writer->writeDouble(20, v.y);
+            if (v.stawidth != 0)
+                writer->writeDouble(40, v.stawidth);
+            if (v.endwidth != 0)
+                writer->writeDouble(41, v.endwidth);
+            if (v.bulge != 0)
+                writer->writeDouble(42, v.bulge);
         }
     } else {
         //RLZ: TODO convert lwpolyline in polyline (not exist in acad 12)
@@ -744,6 +752,93 @@ bool dxfRW::writeLWPolyline(DRW_LWPolyline *ent){
     return true;
 }
 
+bool dxfRW::streamPoint(const EntityStyle &style, double x, double y) {
+    writer->writeString(0, "POINT");
+    writer->writeString(5, toHexStr(++entCount));
+    writeEntityAttributes(0, *style.layer, *style.lineType, style.color,
+                          style.color24, style.lWeight);
+    if (version > DRW::AC1009) {
+        writer->writeString(100, "AcDbPoint");
+    }
+    writer->writeDouble(10, x);
+    writer->writeDouble(20, y);
+    return true;
+}
+
+bool dxfRW::streamLine(const EntityStyle &style, double x1, double y1,
+                       double x2, double y2) {
+    writer->writeString(0, "LINE");
+    writer->writeString(5, toHexStr(++entCount));
+    writeEntityAttributes(0, *style.layer, *style.lineType, style.color,
+                          style.color24, style.lWeight);
+    if (version > DRW::AC1009) {
+        writer->writeString(100, "AcDbLine");
+    }
+    writer->writeDouble(10, x1);
+    writer->writeDouble(20, y1);
+    writer->writeDouble(11, x2);
+    writer->writeDouble(21, y2);
+    return true;
+}
+
+bool dxfRW::streamCircle(const EntityStyle &style, double cx, double cy,
+                         double radius) {
+    writer->writeString(0, "CIRCLE");
+    writer->writeString(5, toHexStr(++entCount));
+    writeEntityAttributes(0, *style.layer, *style.lineType, style.color,
+                          style.color24, style.lWeight);
+    if (version > DRW::AC1009) {
+        writer->writeString(100, "AcDbCircle");
+    }
+    writer->writeDouble(10, cx);
+    writer->writeDouble(20, cy);
+    writer->writeDouble(40, radius);
+    return true;
+}
+
+bool dxfRW::streamArc(const EntityStyle &style, double cx, double cy,
+                      double radius, double staangle, double endangle) {
+    writer->writeString(0, "ARC");
+    writer->writeString(5, toHexStr(++entCount));
+    writeEntityAttributes(0, *style.layer, *style.lineType, style.color,
+                          style.color24, style.lWeight);
+    if (version > DRW::AC1009) {
+        writer->writeString(100, "AcDbCircle");
+    }
+    writer->writeDouble(10, cx);
+    writer->writeDouble(20, cy);
+    writer->writeDouble(40, radius);
+    if (version > DRW::AC1009) {
+        writer->writeString(100, "AcDbArc");
+    }
+    writer->writeDouble(50, staangle*ARAD);
+    writer->writeDouble(51, endangle*ARAD);
+    return true;
+}
+
+bool dxfRW::streamLWPolyline(const EntityStyle &style, int vertexnum, int flags) {
+    //lwpolyline not exist in acad 12, the caller must write a polyline
+    if (version <= DRW::AC1009)
+        return false;
+    writer->writeString(0, "LWPOLYLINE");
+    writer->writeString(5, toHexStr(++entCount));
+    writeEntityAttributes(0, *style.layer, *style.lineType, style.color,
+                          style.color24, style.lWeight);
+    writer->writeString(100, "AcDbPolyline");
+    writer->writeInt32(90, vertexnum);
+    writer->writeInt16(70, flags);
+    writer->writeDouble(43, 0.0);
+    return true;
+}
+
+bool dxfRW::streamVertex2D(double x, double y, double bulge) {
+    writer->writeDouble(10, x);
+    writer->writeDouble(20, y);
+    if (bulge != 0)
+        writer->writeDouble(42, bulge);
+    return true;
+}
+
 bool dxfRW::writePolyline(DRW_Polyline *ent) {
     writer->writeString(0, "POLYLINE");
     writeEntity(ent);
@@ -860,10 +955,10 @@ bool dxfRW::writeSpline(DRW_Spline *ent){
             writer->writeDouble(40, ent->knotslist.at(i));
         }
         for (int i = 0;  i< ent->ncontrol; i++){
-            DRW_Coord *crd = ent->controllist.at(i);
-            writer->writeDouble(10, crd->x);
-            writer->writeDouble(20, crd->y);
-            writer->writeDouble(30, crd->z);
+            const DRW_Coord &crd = ent->controllist.at(i);
+            writer->writeDouble(10, crd.x);
+            writer->writeDouble(20, crd.y);
+            writer->writeDouble(30, crd.z);
         }
     } else {
         //RLZ: TODO convert spline in polyline (not exist in acad 12)
@@ -889,7 +984,7 @@ bool dxfRW::writeHatch(DRW_Hatch *ent){
         writer->writeInt16(91, ent->loopsnum);
         //write paths data
         for (int i = 0;  i< ent->loopsnum; i++){
-            DRW_HatchLoop *loop = ent->looplist.at(i);
+            DRW_HatchLoop *loop = ent->looplist.at(i).get();
             writer->writeInt16(92, loop->type);
             if ( (loop->type & 2) == 2){
                 //RLZ: polyline boundary writeme
@@ -901,7 +996,7 @@ bool dxfRW::writeHatch(DRW_Hatch *ent){
                     switch ( (loop->objlist.at(j))->eType) {
                     case DRW::LINE: {
                         writer->writeInt16(72, 1);
-                        DRW_Line* l = (DRW_Line*)loop->objlist.at(j);
+                        DRW_Line* l = (DRW_Line*)loop->objlist.at(j).get();
                         writer->writeDouble(10, l->basePoint.x);
                         writer->writeDouble(20, l->basePoint.y);
                         writer->writeDouble(11, l->secPoint.x);
@@ -909,7 +1004,7 @@ bool dxfRW::writeHatch(DRW_Hatch *ent){
                         break; }
                     case DRW::ARC: {
                         writer->writeInt16(72, 2);
-                        DRW_Arc* a = (DRW_Arc*)loop->objlist.at(j);
+                        DRW_Arc* a = (DRW_Arc*)loop->objlist.at(j).get();
                         writer->writeDouble(10, a->basePoint.x);
                         writer->writeDouble(20, a->basePoint.y);
                         writer->writeDouble(40, a->radious);
@@ -919,7 +1014,7 @@ bool dxfRW::writeHatch(DRW_Hatch *ent){
                         break; }
                     case DRW::ELLIPSE: {
                         writer->writeInt16(72, 3);
-                        DRW_Ellipse* a = (DRW_Ellipse*)loop->objlist.at(j);
+                        DRW_Ellipse* a = (DRW_Ellipse*)loop->objlist.at(j).get();
                         a->correctAxis();
                         writer->writeDouble(10, a->basePoint.x);
                         writer->writeDouble(20, a->basePoint.y);
@@ -975,10 +1070,10 @@ bool dxfRW::writeLeader(DRW_Leader *ent){
         writer->writeDouble(76, ent->vertnum);
         writer->writeDouble(76, ent->vertexlist.size());
         for (unsigned int i=0; i<ent->vertexlist.size(); i++) {
-            DRW_Coord *vert = ent->vertexlist.at(i);
-            writer->writeDouble(10, vert->x);
-            writer->writeDouble(20, vert->y);
-            writer->writeDouble(30, vert->z);
+            const DRW_Coord &vert = ent->vertexlist.at(i);
+            writer->writeDouble(10, vert.x);
+            writer->writeDouble(20, vert.y);
+            writer->writeDouble(30, vert.z);
         }
     } else  {
         //RLZ: todo not supported by acad 12 saved as unnamed block
@@ -69,6 +69,28 @@ public:
     bool writeDimension(DRW_Dimension *ent);
     void setEllipseParts(int parts){elParts = parts;} /*!< set parts munber when convert ellipse to polyline */
 
+    /*!
+     * Common attributes of an entity written by the streaming writers.
+     * The strings are referenced, not copied; they must outlive the call.
+     */
+    struct EntityStyle {
+        const std::string *layer;
+        const std::string *lineType;
+        int color;
+        int color24;
+        DRW_LW_Conv::lineWidth lWeight;
+    };
+    /// streaming writers, write 2D entities without a DRW_Entity record
+    bool streamPoint(const EntityStyle &style, double x, double y);
+    bool streamLine(const EntityStyle &style, double x1, double y1, double x2, double y2);
+    bool streamCircle(const EntityStyle &style, double cx, double cy, double radius);
+    /// angles in radians
+    bool streamArc(const EntityStyle &style, double cx, double cy, double radius,
+                   double staangle, double endangle);
+    /// must be followed by exactly 'vertexnum' calls of streamVertex2D()
+    bool streamLWPolyline(const EntityStyle &style, int vertexnum, int flags);
+    bool streamVertex2D(double x, double y, double bulge);
+
 private:
     /// used by read() to parse the content of the file
     bool processDxf();
@@ -112,6 +134,9 @@ private:
 
 //    bool writeHeader();
     bool writeEntity(DRW_Entity *ent);
+    void writeEntityAttributes(int space, const std::string &layer,
+                               const std::string &lineType, int color,
+                               int color24, DRW_LW_Conv::lineWidth lWeight);
     bool writeTables();
     bool writeBlocks();
     bool writeObjects();
@@ -126,6 +151,7 @@ private:
     dxfReader *reader;
     dxfWriter *writer;
     DRW_Interface *iface;
+    DRW_Arena arena; //records created by read(), declared before all users
     DRW_Header header;
 //    int section;
     std::string nextentity;
@@ -9,3 +9,9 @@ TEMPLATE = subdirs
 TARGET = librecad
 
 SUBDIRS = src
+
+# headless benchmarks, see src/bench.pro
+benchmarks {
+    SUBDIRS += bench
+    bench.file = src/bench.pro
+}
@@ -82,7 +82,7 @@ void LC_ActionDrawCircle2PR::trigger() {
             document->endUndoCycle();
         }
         RS_Vector rz = graphicView->getRelativeZero();
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(circle);
         graphicView->moveRelativeZero(rz);
         drawSnapper();
 
@@ -89,7 +89,7 @@ void LC_ActionDrawSplinePoints::trigger()
 
 	// upd view
 	RS_Vector r = graphicView->getRelativeZero();
-	graphicView->redraw(RS2::RedrawDrawing);
+	graphicView->drawEntity(spline);
 	graphicView->moveRelativeZero(r);
 	RS_DEBUG->print("RS_ActionDrawSplinePoints::trigger(): spline added: %d",
 		spline->getId());
@@ -60,17 +60,10 @@ void LC_ActionLayersToggleConstruction::trigger() {
         if (layer!=NULL) {
             graphic->toggleLayerConstruction( layer);
 
-            // deselect entities on locked layer:
-            for (RS_Entity* e=container->firstEntity(); e!=NULL;
-                 e=container->nextEntity()) {
-                if (e!=NULL && e->isVisible() && e->getLayer()==layer) {
-                    if (graphicView!=NULL) {
-                        graphicView->deleteEntity(e);
-                    }
-                    if (graphicView!=NULL) {
-                        graphicView->drawEntity(e);
-                    }
-                }
+            // lines on the layer change between segments and lines
+            // across the whole view:
+            if (graphicView!=NULL) {
+                graphicView->redraw(RS2::RedrawDrawing);
             }
         }
     }
@@ -90,7 +90,7 @@ void RS_ActionDimAligned::trigger() {
     }
 
     RS_Vector rz = graphicView->getRelativeZero();
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(dim);
     graphicView->moveRelativeZero(rz);
 
     RS_DEBUG->print("RS_ActionDimAligned::trigger():"
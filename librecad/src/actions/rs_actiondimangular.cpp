@@ -89,7 +89,7 @@ void RS_ActionDimAngular::trigger() {
             document->endUndoCycle();
         }
         RS_Vector rz = graphicView->getRelativeZero();
-		graphicView->redraw(RS2::RedrawDrawing);
+		graphicView->drawEntity(newEntity);
         graphicView->moveRelativeZero(rz);
 
     } else {
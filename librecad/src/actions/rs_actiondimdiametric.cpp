@@ -84,7 +84,7 @@ void RS_ActionDimDiametric::trigger() {
             document->endUndoCycle();
         }
         RS_Vector rz = graphicView->getRelativeZero();
-		graphicView->redraw(RS2::RedrawDrawing);
+		graphicView->drawEntity(newEntity);
         graphicView->moveRelativeZero(rz);
 
     } else {
@@ -95,7 +95,7 @@ void RS_ActionDimLeader::trigger() {
 
         deletePreview();
         RS_Vector rz = graphicView->getRelativeZero();
-		graphicView->redraw(RS2::RedrawDrawing);
+		graphicView->drawEntity(leader);
         graphicView->moveRelativeZero(rz);
         //drawSnapper();
 
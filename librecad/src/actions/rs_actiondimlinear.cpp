@@ -134,7 +134,7 @@ void RS_ActionDimLinear::trigger() {
     }
 
     RS_Vector rz = graphicView->getRelativeZero();
-	graphicView->redraw(RS2::RedrawDrawing);
+	graphicView->drawEntity(dim);
     graphicView->moveRelativeZero(rz);
 
     RS_DEBUG->print("RS_ActionDimLinear::trigger():"
@@ -85,7 +85,7 @@ void RS_ActionDimRadial::trigger() {
             document->endUndoCycle();
         }
         RS_Vector rz = graphicView->getRelativeZero();
-		graphicView->redraw(RS2::RedrawDrawing);
+		graphicView->drawEntity(newEntity);
         graphicView->moveRelativeZero(rz);
         //drawSnapper();
 
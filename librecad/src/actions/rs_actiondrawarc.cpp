@@ -96,7 +96,7 @@ void RS_ActionDrawArc::trigger() {
         document->endUndoCycle();
     }
 
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(arc);
     graphicView->moveRelativeZero(arc->getCenter());
 
     setStatus(SetCenter);
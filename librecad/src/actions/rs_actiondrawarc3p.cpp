@@ -91,7 +91,7 @@ void RS_ActionDrawArc3P::trigger() {
             document->endUndoCycle();
         }
 
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(arc);
         graphicView->moveRelativeZero(arc->getEndpoint());
 
         setStatus(SetPoint1);
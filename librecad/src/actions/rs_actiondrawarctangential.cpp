@@ -98,7 +98,7 @@ void RS_ActionDrawArcTangential::trigger() {
         document->endUndoCycle();
     }
 
-    graphicView->redraw(RS2::RedrawDrawing);
+    graphicView->drawEntity(arc);
     graphicView->moveRelativeZero(arc->getCenter());
 
     setStatus(SetBaseEntity);
@@ -85,7 +85,7 @@ void RS_ActionDrawCircle::trigger() {
         document->addUndoable(circle);
         document->endUndoCycle();
     }
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(circle);
     graphicView->moveRelativeZero(circle->getCenter());
 
     setStatus(SetCenter);
@@ -90,7 +90,7 @@ void RS_ActionDrawCircle2P::trigger() {
         }
 
         RS_Vector rz = graphicView->getRelativeZero();
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(circle);
         graphicView->moveRelativeZero(rz);
 
         setStatus(SetPoint1);
@@ -90,7 +90,7 @@ void RS_ActionDrawCircle3P::trigger() {
             document->endUndoCycle();
         }
         RS_Vector rz = graphicView->getRelativeZero();
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(circle);
         graphicView->moveRelativeZero(rz);
         drawSnapper();
 
@@ -83,7 +83,7 @@ void RS_ActionDrawCircleCR::trigger() {
         document->addUndoable(circle);
         document->endUndoCycle();
     }
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(circle);
     graphicView->moveRelativeZero(circle->getCenter());
 
     setStatus(SetCenter);
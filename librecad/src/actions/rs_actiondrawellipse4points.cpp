@@ -83,7 +83,7 @@ void RS_ActionDrawEllipse4Points::trigger() {
         document->endUndoCycle();
     }
     RS_Vector rz = graphicView->getRelativeZero();
-    graphicView->redraw(RS2::RedrawDrawing);
+    graphicView->drawEntity(en);
     graphicView->moveRelativeZero(rz);
     drawSnapper();
     setStatus(SetPoint1);
@@ -117,7 +117,7 @@ void RS_ActionDrawEllipseAxis::trigger() {
     }
 
     RS_Vector rz = graphicView->getRelativeZero();
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(ellipse);
     graphicView->moveRelativeZero(rz);
     drawSnapper();
 
@@ -86,7 +86,7 @@ void RS_ActionDrawEllipseCenter3Points::trigger() {
     }
 
     graphicView->moveRelativeZero(ellipse->getCenter());
-    graphicView->redraw(RS2::RedrawDrawing);
+    graphicView->drawEntity(ellipse);
     drawSnapper();
 
     setStatus(SetCenter);
@@ -89,7 +89,7 @@ void RS_ActionDrawEllipseFociPoint::trigger() {
 
 //    RS_Vector rz = graphicView->getRelativeZero();
     graphicView->moveRelativeZero(ellipse->getCenter());
-    graphicView->redraw(RS2::RedrawDrawing);
+    graphicView->drawEntity(ellipse);
     drawSnapper();
 
     setStatus(SetFocus1);
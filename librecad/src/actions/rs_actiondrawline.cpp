@@ -97,7 +97,7 @@ void RS_ActionDrawLine::trigger() {
         document->endUndoCycle();
     }
 
-    graphicView->redraw(RS2::RedrawDrawing);
+    graphicView->drawEntity(line);
     graphicView->moveRelativeZero(history.at(historyIndex));
     //    graphicView->moveRelativeZero(line->getEndpoint());
     RS_DEBUG->print("RS_ActionDrawLine::trigger(): line added: %d",
@@ -121,7 +121,7 @@ void RS_ActionDrawLineAngle::trigger() {
     }
 
     graphicView->moveRelativeZero(data.startpoint);
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(line);
     RS_DEBUG->print("RS_ActionDrawLineAngle::trigger(): line added: %d",
                     line->getId());
 }
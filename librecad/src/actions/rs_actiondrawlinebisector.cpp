@@ -85,7 +85,7 @@ void RS_ActionDrawLineBisector::trigger() {
             document->addUndoable(newEntity);
             document->endUndoCycle();
         }
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(newEntity);
         setStatus(SetLine1);
 }
     //reset();
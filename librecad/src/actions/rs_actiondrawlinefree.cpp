@@ -67,7 +67,7 @@ void RS_ActionDrawLineFree::trigger() {
                         document->addUndoable(polyline);
                         document->endUndoCycle();
                 }
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(polyline);
         RS_DEBUG->print("RS_ActionDrawLineFree::trigger():"
                         " polyline added: %d", polyline->getId());
             } else {
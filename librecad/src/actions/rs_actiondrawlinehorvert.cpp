@@ -86,7 +86,7 @@ void RS_ActionDrawLineHorVert::trigger() {
         document->endUndoCycle();
     }
 
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(line);
     graphicView->moveRelativeZero(line->getMiddlePoint());
     RS_DEBUG->print("RS_ActionDrawLineHorVert::trigger():"
                     " line added: %d", line->getId());
@@ -96,7 +96,9 @@ void RS_ActionDrawLineRectangle::trigger() {
     }
 
     // upd. view
-        graphicView->redraw(RS2::RedrawDrawing);
+    for (int i=0; i<4; ++i) {
+        graphicView->drawEntity(line[i]);
+    }
     graphicView->moveRelativeZero(corner2);
 }
 
@@ -78,7 +78,7 @@ void RS_ActionDrawLineTangent1::trigger() {
                 document->endUndoCycle();
             }
 
-                        graphicView->redraw(RS2::RedrawDrawing);
+                        graphicView->drawEntity(newEntity);
 
             setStatus(SetPoint);
         }
@@ -121,7 +121,7 @@ void RS_ActionDrawMText::trigger() {
             document->endUndoCycle();
         }
 
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(text);
 
         textChanged = true;
         setStatus(SetPos);
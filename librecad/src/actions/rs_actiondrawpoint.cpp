@@ -61,7 +61,7 @@ void RS_ActionDrawPoint::trigger() {
             document->endUndoCycle();
         }
 
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(point);
         graphicView->moveRelativeZero(pt);
     }
 }
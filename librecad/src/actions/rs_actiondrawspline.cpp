@@ -104,7 +104,7 @@ void RS_ActionDrawSpline::trigger() {
 
         // upd view
         RS_Vector r = graphicView->getRelativeZero();
-        graphicView->redraw(RS2::RedrawDrawing);
+        graphicView->drawEntity(spline);
     graphicView->moveRelativeZero(r);
     RS_DEBUG->print("RS_ActionDrawSpline::trigger(): spline added: %d",
                     spline->getId());
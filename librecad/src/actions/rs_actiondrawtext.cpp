@@ -120,7 +120,7 @@ void RS_ActionDrawText::trigger() {
             document->endUndoCycle();
         }
 
-                graphicView->redraw(RS2::RedrawDrawing);
+                graphicView->drawEntity(text);
 
         textChanged = true;
         secPos = RS_Vector(false);
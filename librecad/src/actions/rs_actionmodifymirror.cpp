@@ -82,9 +82,13 @@ void RS_ActionModifyMirror::mouseMoveEvent(QMouseEvent* e) {
             if (axisPoint1.valid) {
                 axisPoint2 = mouse;
 
-                deletePreview();
-                preview->addSelectionFrom(*container);
-                preview->mirror(axisPoint1, axisPoint2);
+                if (!preview->hasCapture()) {
+                    preview->captureSelectionFrom(*container);
+                }
+                // only the axis line is rebuilt, the selection is transformed:
+                preview->clear();
+                preview->resetTransform();
+                preview->transformMirror(axisPoint1, axisPoint2);
 
                 preview->addEntity(new RS_Line(preview,
                                                RS_LineData(axisPoint1,
@@ -75,9 +75,11 @@ void RS_ActionModifyMove::mouseMoveEvent(QMouseEvent* e) {
             if (referencePoint.valid) {
                 targetPoint = mouse;
 
-                deletePreview();
-                preview->addSelectionFrom(*container);
-                preview->move(targetPoint-referencePoint);
+                if (!preview->hasCapture()) {
+                    preview->captureSelectionFrom(*container);
+                }
+                preview->resetTransform();
+                preview->transformMove(targetPoint-referencePoint);
                 drawPreview();
             }
             break;
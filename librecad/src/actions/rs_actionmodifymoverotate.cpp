@@ -85,10 +85,12 @@ void RS_ActionModifyMoveRotate::mouseMoveEvent(QMouseEvent* e) {
                 targetPoint = mouse;
                 data.offset = targetPoint-data.referencePoint;
 
-                deletePreview();
-                preview->addSelectionFrom(*container);
-                preview->rotate(data.referencePoint, data.angle);
-                preview->move(data.offset);
+                if (!preview->hasCapture()) {
+                    preview->captureSelectionFrom(*container);
+                }
+                preview->resetTransform();
+                preview->transformRotate(data.referencePoint, data.angle);
+                preview->transformMove(data.offset);
                 drawPreview();
             }
             break;
@@ -75,9 +75,11 @@ void RS_ActionModifyRotate::mouseMoveEvent(QMouseEvent* e) {
 
     case setTargetPoint:
         if( ! mouse.valid ) return;
-        deletePreview();
-        preview->addSelectionFrom(*container);
-        preview->rotate(data.center,RS_Math::correctAngle((mouse - data.center).angle() - data.angle));
+        if (!preview->hasCapture()) {
+            preview->captureSelectionFrom(*container);
+        }
+        preview->resetTransform();
+        preview->transformRotate(data.center,RS_Math::correctAngle((mouse - data.center).angle() - data.angle));
         drawPreview();
     }
 
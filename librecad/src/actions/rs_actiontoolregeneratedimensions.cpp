@@ -62,19 +62,20 @@ void RS_ActionToolRegenerateDimensions::trigger() {
 
     RS_DEBUG->print("RS_ActionToolRegenerateDimensions::trigger()");
 
-    int num = 0;
+    std::vector<RS_Dimension*> dims;
     for (RS_Entity* e = container->firstEntity(RS2::ResolveNone);
             e != NULL;
             e = container->nextEntity(RS2::ResolveNone)) {
 
         if (RS_Information::isDimension(e->rtti()) && e->isVisible()) {
-			num++;
 			if (((RS_Dimension*)e)->getLabel()==";;") {
 				((RS_Dimension*)e)->setLabel("");
 			}
-            ((RS_Dimension*)e)->updateDim(true);
+            dims.push_back((RS_Dimension*)e);
         }
     }
+    RS_Dimension::updateDims(dims, true);
+    int num = dims.size();
 
     if (num>0) {
     	graphicView->redraw();
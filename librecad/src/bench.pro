@@ -0,0 +1,41 @@
+# Headless benchmarks for the library code (librecad/src/bench).
+#
+# Builds all of LibreCAD with a benchmark runner instead of main/main.cpp.
+# Enable from the top level with: qmake CONFIG+=benchmarks
+# Run: unix/librecad_bench --help
+
+include(src.pro)
+
+# own object files, so both targets can be built side by side
+GENERATED_DIR = ../../generated/librecad_bench
+OBJECTS_DIR = $${GENERATED_DIR}/obj
+MOC_DIR = $${GENERATED_DIR}/moc
+RCC_DIR = $${GENERATED_DIR}/rcc
+UI_DIR = $${GENERATED_DIR}/ui
+UI_HEADERS_DIR = $${GENERATED_DIR}/ui
+UI_SOURCES_DIR = $${GENERATED_DIR}/ui
+
+TARGET = librecad_bench
+CONFIG += console
+CONFIG -= app_bundle
+QMAKE_POST_LINK =
+TRANSLATIONS =
+
+SOURCES -= main/main.cpp
+
+DEPENDPATH += bench
+INCLUDEPATH += bench
+
+HEADERS += \
+    bench/lc_benchmark.h \
+    bench/lc_benchdrawing.h
+
+SOURCES += \
+    bench/lc_benchmark.cpp \
+    bench/lc_benchmain.cpp \
+    bench/lc_benchgeometry.cpp \
+    bench/lc_benchdrawing.cpp \
+    bench/lc_benchfileio.cpp \
+    bench/lc_benchrender.cpp \
+    bench/lc_benchmemory.cpp \
+    bench/lc_benchvector.cpp
@@ -0,0 +1,320 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include "lc_benchdrawing.h"
+
+#include <cmath>
+#include <random>
+#include <QStringList>
+
+#include "lc_splinepoints.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_dimaligned.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_insert.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_polyline.h"
+#include "rs_spline.h"
+#include "rs_text.h"
+
+namespace {
+
+const char* const partName = "bench_part";
+
+/**
+ * Adds the entities of one kind at a time, all positions come from
+ * a generator with a fixed seed.
+ */
+class Generator {
+public:
+    Generator(RS_Graphic& graphic, double extent)
+        : graphic(graphic),
+          gen(42),
+          extent(extent) {}
+
+    double value(double min, double max) {
+        return std::uniform_real_distribution<double>(min, max)(gen);
+    }
+    RS_Vector point() {
+        return RS_Vector(value(0., extent), value(0., extent));
+    }
+    double size() {
+        return value(extent*0.005, extent*0.05);
+    }
+    RS_Vector offset(const RS_Vector& p) {
+        return p + RS_Vector(value(0., 2.*M_PI))*size();
+    }
+
+    void lines(int n) {
+        for (int i=0; i<n; ++i) {
+            RS_Vector p = point();
+            graphic.addEntity(new RS_Line(&graphic, RS_LineData(p, offset(p))));
+        }
+    }
+
+    /** Alternates between arcs and circles. */
+    void arcs(int n) {
+        for (int i=0; i<n; ++i) {
+            if (i%2==0) {
+                double a1 = value(0., 2.*M_PI);
+                graphic.addEntity(new RS_Arc(&graphic,
+                                             RS_ArcData(point(), size(),
+                                                        a1, a1 + value(0.1, 1.9*M_PI), false)));
+            } else {
+                graphic.addEntity(new RS_Circle(&graphic, RS_CircleData(point(), size())));
+            }
+        }
+    }
+
+    /** Closed polylines of 8 vertices, every third segment an arc. */
+    void polylines(int n) {
+        for (int i=0; i<n; ++i) {
+            RS_Polyline* pl = new RS_Polyline(&graphic,
+                                              RS_PolylineData(RS_Vector(false), RS_Vector(false),
+                                                              i%2==0));
+            RS_Vector c = point();
+            double r = size();
+            for (int k=0; k<8; ++k) {
+                pl->addVertex(c + RS_Vector(k*M_PI/4.)*r, k%3==0 ? 0.3 : 0.);
+            }
+            graphic.addEntity(pl);
+        }
+    }
+
+    /** Rectangular hatches, alternating between a pattern and solid fill. */
+    void hatches(int n) {
+        for (int i=0; i<n; ++i) {
+            bool solid = i%2==1;
+            RS_Hatch* hatch = new RS_Hatch(&graphic,
+                                           RS_HatchData(solid, 1., 0., solid ? "SOLID" : "ANSI31"));
+            graphic.addEntity(hatch);
+
+            RS_EntityContainer* loop = new RS_EntityContainer(hatch);
+            loop->setLayer(NULL);
+            hatch->addEntity(loop);
+            RS_Vector p = point();
+            double w = size();
+            const RS_Vector corners[] = {
+                p, p + RS_Vector(w, 0.), p + RS_Vector(w, w), p + RS_Vector(0., w)
+            };
+            for (int k=0; k<4; ++k) {
+                RS_Line* l = new RS_Line(loop, RS_LineData(corners[k], corners[(k+1)%4]));
+                l->setLayer(NULL);
+                loop->addEntity(l);
+            }
+            hatch->update();
+        }
+    }
+
+    void inserts(int n) {
+        if (n<=0) {
+            return;
+        }
+        if (graphic.findBlock(partName)==NULL) {
+            RS_Block* block = new RS_Block(&graphic, RS_BlockData(partName, RS_Vector(0., 0.), false));
+            const RS_Vector outline[] = {
+                RS_Vector(0., 0.), RS_Vector(10., 0.), RS_Vector(10., 6.), RS_Vector(0., 6.)
+            };
+            for (int k=0; k<4; ++k) {
+                block->addEntity(new RS_Line(block, RS_LineData(outline[k], outline[(k+1)%4])));
+            }
+            block->addEntity(new RS_Circle(block, RS_CircleData(RS_Vector(3., 3.), 1.5)));
+            block->addEntity(new RS_Arc(block, RS_ArcData(RS_Vector(7., 3.), 2., 0., M_PI, false)));
+            graphic.addBlock(block);
+        }
+        for (int i=0; i<n; ++i) {
+            double scale = value(0.5, 2.);
+            RS_Insert* insert = new RS_Insert(&graphic,
+                                              RS_InsertData(partName, point(),
+                                                            RS_Vector(scale, scale), value(0., 2.*M_PI),
+                                                            1, 1, RS_Vector(0., 0.)));
+            graphic.addEntity(insert);
+            insert->update();
+        }
+    }
+
+    void texts(int n) {
+        for (int i=0; i<n; ++i) {
+            RS_Vector p = point();
+            RS_Text* text = new RS_Text(&graphic,
+                                        RS_TextData(p, p, 2.5, 1.,
+                                                    RS_TextData::VABaseline, RS_TextData::HALeft,
+                                                    RS_TextData::None,
+                                                    QString("Part %1 - %2 mm").arg(i).arg(size(), 0, 'f', 2),
+                                                    "standard", value(0., 2.*M_PI)));
+            graphic.addEntity(text);
+            text->update();
+        }
+    }
+
+    /** Alternates between control point splines and spline points. */
+    void splines(int n) {
+        for (int i=0; i<n; ++i) {
+            RS_Vector p = point();
+            if (i%2==0) {
+                RS_Spline* spline = new RS_Spline(&graphic, RS_SplineData(3, false));
+                for (int k=0; k<6; ++k) {
+                    p = offset(p);
+                    spline->addControlPoint(p);
+                }
+                graphic.addEntity(spline);
+                spline->update();
+            } else {
+                LC_SplinePointsData data(false, false);
+                for (int k=0; k<6; ++k) {
+                    p = offset(p);
+                    data.splinePoints.push_back(p);
+                }
+                LC_SplinePoints* spline = new LC_SplinePoints(&graphic, data);
+                graphic.addEntity(spline);
+                spline->update();
+            }
+        }
+    }
+
+    void dimensions(int n) {
+        for (int i=0; i<n; ++i) {
+            RS_Vector p1 = point();
+            RS_Vector p2 = offset(p1);
+            RS_Vector def = p2 + RS_Vector(p1.angleTo(p2) + M_PI_2)*5.;
+            RS_DimAligned* dim = new RS_DimAligned(&graphic,
+                                                   RS_DimensionData(def, RS_Vector(false),
+                                                                    RS_MTextData::VAMiddle,
+                                                                    RS_MTextData::HACenter,
+                                                                    RS_MTextData::Exact,
+                                                                    1.0, "", "Standard", 0.0),
+                                                   RS_DimAlignedData(p1, p2));
+            graphic.addEntity(dim);
+            dim->update();
+        }
+    }
+
+private:
+    RS_Graphic& graphic;
+    std::mt19937 gen;
+    double extent;
+};
+
+}
+
+
+
+LC_BenchDrawing::Composition LC_BenchDrawing::defaultComposition(int size) {
+    Composition c;
+    c.lines = size*2/5;
+    c.arcs = size/10;
+    c.polylines = size/10;
+    c.hatches = qMax(1, size/50);
+    c.inserts = size/10;
+    c.texts = size/10;
+    c.splines = size/20;
+    c.dimensions = size/20;
+    return c;
+}
+
+
+
+bool LC_BenchDrawing::parse(const QString& spec, Composition& c) {
+    Composition ret = c;
+    for (const QString& item: spec.split(',', QString::SkipEmptyParts)) {
+        QStringList kv = item.split('=');
+        bool ok = false;
+        int n = kv.size()==2 ? kv.at(1).trimmed().toInt(&ok) : 0;
+        if (!ok || n<0) {
+            return false;
+        }
+        QString kind = kv.at(0).trimmed().toLower();
+        if (kind=="lines") {
+            ret.lines = n;
+        } else if (kind=="arcs") {
+            ret.arcs = n;
+        } else if (kind=="polylines") {
+            ret.polylines = n;
+        } else if (kind=="hatches") {
+            ret.hatches = n;
+        } else if (kind=="inserts") {
+            ret.inserts = n;
+        } else if (kind=="texts") {
+            ret.texts = n;
+        } else if (kind=="splines") {
+            ret.splines = n;
+        } else if (kind=="dimensions") {
+            ret.dimensions = n;
+        } else {
+            return false;
+        }
+    }
+    c = ret;
+    return true;
+}
+
+
+
+QString LC_BenchDrawing::toString(const Composition& c) {
+    return QString("lines=%1,arcs=%2,polylines=%3,hatches=%4,inserts=%5,texts=%6,splines=%7,dimensions=%8")
+            .arg(c.lines).arg(c.arcs).arg(c.polylines).arg(c.hatches).arg(c.inserts)
+            .arg(c.texts).arg(c.splines).arg(c.dimensions);
+}
+
+
+
+void LC_BenchDrawing::create(RS_Graphic& graphic, const Composition& c,
+                             double extent) {
+    Generator g(graphic, extent);
+    g.lines(c.lines);
+    g.arcs(c.arcs);
+    g.polylines(c.polylines);
+    g.hatches(c.hatches);
+    g.inserts(c.inserts);
+    g.texts(c.texts);
+    g.splines(c.splines);
+    g.dimensions(c.dimensions);
+}
+
+
+
+void LC_BenchDrawing::createFont(RS_Graphic& graphic, int glyphs) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(0., 9.);
+    for (int i=0; i<glyphs; ++i) {
+        // printable code points below the surrogates
+        ushort code = 0x21 + i%(0xd800 - 0x21);
+        QString name = QString("[%1] %2").arg(code, 4, 16, QChar('0')).arg(QChar(code));
+        RS_Block* letter = new RS_Block(&graphic, RS_BlockData(name, RS_Vector(0., 0.), false));
+        RS_Vector p(coord(gen), coord(gen));
+        for (int k=0; k<4; ++k) {
+            RS_Vector q(coord(gen), coord(gen));
+            letter->addEntity(new RS_Line(letter, RS_LineData(p, q)));
+            p = q;
+        }
+        letter->addEntity(new RS_Arc(letter, RS_ArcData(p, 2., 0., M_PI, false)));
+        graphic.addBlock(letter);
+    }
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_BENCHDRAWING_H
+#define LC_BENCHDRAWING_H
+
+#include <QString>
+
+class RS_Graphic;
+
+/**
+ * Synthetic drawings for the benchmarks which need a "real" document
+ * (file filters, rendering) rather than single entities.
+ *
+ * Drawings are reproducible: the same composition always gives the
+ * same entities, so numbers can be compared across releases.
+ */
+class LC_BenchDrawing {
+public:
+    /**
+     * Number of entities of each kind in a drawing.
+     */
+    struct Composition {
+        int lines = 0;
+        int arcs = 0;
+        int polylines = 0;
+        int hatches = 0;
+        int inserts = 0;
+        int texts = 0;
+        int splines = 0;
+        int dimensions = 0;
+
+        int total() const {
+            return lines + arcs + polylines + hatches + inserts + texts + splines + dimensions;
+        }
+    };
+
+    /**
+     * @return a mix resembling a typical mechanical drawing with
+     * about size entities, mostly lines and arcs.
+     */
+    static Composition defaultComposition(int size);
+
+    /**
+     * Overrides counts of c from a specification like
+     * "lines=10000,texts=200,hatches=0".
+     *
+     * @return false if the specification contains unknown kinds or
+     * invalid numbers, c is unchanged in that case.
+     */
+    static bool parse(const QString& spec, Composition& c);
+    static QString toString(const Composition& c);
+
+    /**
+     * Fills graphic with the entities of c, spread over a square of
+     * extent drawing units. Inserts reference a block "bench_part"
+     * which is added to the graphic.
+     */
+    static void create(RS_Graphic& graphic, const Composition& c,
+                       double extent = 1000.);
+
+    /**
+     * Fills graphic with glyphs letter blocks named like "[0041] A",
+     * made of lines and arcs, as the font filters (LFF, CXF) expect.
+     */
+    static void createFont(RS_Graphic& graphic, int glyphs);
+};
+
+#endif
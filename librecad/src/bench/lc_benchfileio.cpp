@@ -0,0 +1,223 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+/**
+ * Write and read throughput of the file filters on synthetic drawings
+ * (see LC_BenchDrawing): every supported DXF version in ASCII and
+ * binary, JWW, and the LFF / CXF font formats.
+ *
+ * Besides the time per entity, every case reports MB/s, entities/s
+ * and the peak memory above the level before the case (Linux only).
+ * Files are written to a temporary directory, or kept in the
+ * directory given with --corpus to be used as test corpus.
+ */
+
+#include <iostream>
+#include <memory>
+#include <QDir>
+#include <QFileInfo>
+
+#include "lc_benchdrawing.h"
+#include "lc_benchmark.h"
+#include "rs_filtercxf.h"
+#include "rs_filterdxf1.h"
+#include "rs_filterdxfrw.h"
+#include "rs_filterjww.h"
+#include "rs_filterlff.h"
+#include "rs_graphic.h"
+
+namespace {
+
+struct Format {
+    const char* name;
+    RS2::FormatType type;
+    const char* suffix;
+    bool binary;
+};
+
+/** Formats written, each file is read back by the filter which wrote it. */
+const Format formats[] = {
+    {"dxf_r12",         RS2::FormatDXFRW12,   "dxf", false},
+    {"dxf_r14",         RS2::FormatDXFRW14,   "dxf", false},
+    {"dxf_2000",        RS2::FormatDXFRW2000, "dxf", false},
+    {"dxf_2004",        RS2::FormatDXFRW2004, "dxf", false},
+    {"dxf_2007",        RS2::FormatDXFRW,     "dxf", false},
+    {"dxf_2007_binary", RS2::FormatDXFRW,     "dxf", true},
+    {"jww",             RS2::FormatJWW,       "jww", false},
+    {"lff",             RS2::FormatLFF,       "lff", false},
+    {"cxf",             RS2::FormatCXF,       "cxf", false}
+};
+
+RS_FilterInterface* createFilter(const Format& format) {
+    switch (format.type) {
+    case RS2::FormatJWW:
+        return new RS_FilterJWW();
+    case RS2::FormatLFF:
+        return new RS_FilterLFF();
+    case RS2::FormatCXF:
+        return new RS_FilterCXF();
+    default: {
+        RS_FilterDXFRW* filter = new RS_FilterDXFRW();
+        filter->setExportBinary(format.binary);
+        return filter;
+    }
+    }
+}
+
+/** Import type for the file written as format. */
+RS2::FormatType importType(const Format& format) {
+    switch (format.type) {
+    case RS2::FormatJWW:
+    case RS2::FormatLFF:
+    case RS2::FormatCXF:
+        return format.type;
+    default:
+        return RS2::FormatDXFRW;
+    }
+}
+
+bool isFont(const Format& format) {
+    return format.type==RS2::FormatLFF || format.type==RS2::FormatCXF;
+}
+
+/** Entities of a drawing, letters of a font. */
+size_t countItems(RS_Graphic& graphic, bool font) {
+    return font ? graphic.countBlocks() : graphic.count();
+}
+
+/**
+ * Times fn for case name and reports the derived rates: bytes and
+ * items (entities, letters) processed per second, and peak memory.
+ */
+template <class F>
+void measureIO(LC_Benchmark& bench, const QString& name, size_t items,
+               const QString& file, F fn) {
+    if (!bench.enabled(name)) {
+        return;
+    }
+    LC_Benchmark::resetPeakMemory();
+    long base = LC_Benchmark::peakMemory();
+    double ns = bench.measure(name, items, fn);
+    long peak = LC_Benchmark::peakMemory();
+
+    double seconds = ns*1e-9;
+    if (seconds>0.) {
+        bench.reportValue(name + "_throughput", "MB/s",
+                          QFileInfo(file).size()/seconds/(1024.*1024.));
+        bench.reportValue(name + "_rate", "entities/s", items/seconds);
+    }
+    if (base>=0 && peak>=0) {
+        bench.reportValue(name + "_peak", "KiB", peak - base);
+    }
+}
+
+}
+
+
+
+LC_BENCHMARK_SUITE(fileio) {
+    LC_BenchDrawing::Composition composition =
+            LC_BenchDrawing::defaultComposition(bench.size());
+    if (!LC_BenchDrawing::parse(bench.option("composition"), composition)) {
+        std::cerr << "fileio: invalid composition '"
+                  << bench.option("composition").toStdString() << "'\n";
+        return;
+    }
+
+    QString corpus = bench.option("corpus");
+    QDir dir(corpus.isEmpty()
+             ? QDir::tempPath() + "/librecad_bench_fileio"
+             : corpus);
+    if (!dir.mkpath(".")) {
+        std::cerr << "fileio: cannot create " << dir.path().toStdString() << "\n";
+        return;
+    }
+
+    RS_Graphic drawing;
+    LC_BenchDrawing::create(drawing, composition);
+    RS_Graphic font;
+    LC_BenchDrawing::createFont(font, qMax(1, bench.size()/10));
+
+    for (const Format& format: formats) {
+        const QString name = format.name;
+        const bool fontFormat = isFont(format);
+        RS_Graphic& graphic = fontFormat ? font : drawing;
+        const size_t items = countItems(graphic, fontFormat);
+        const QString file = dir.filePath(QString("bench_%1.%2").arg(name, format.suffix));
+
+        bool ok = true;
+        measureIO(bench, name + "/write", items, file, [&]() {
+            std::unique_ptr<RS_FilterInterface> filter(createFilter(format));
+            ok = filter->fileExport(graphic, file, format.type) && ok;
+        });
+        if (!ok) {
+            std::cerr << "fileio: " << format.name << ": export failed\n";
+        }
+
+        // reading needs a file, also if writing was filtered out
+        if (!QFileInfo(file).exists()) {
+            std::unique_ptr<RS_FilterInterface> filter(createFilter(format));
+            filter->fileExport(graphic, file, format.type);
+        }
+        if (!QFileInfo(file).exists()) {
+            continue;
+        }
+
+        size_t read = 0;
+        ok = true;
+        measureIO(bench, name + "/read", items, file, [&]() {
+            RS_Graphic g;
+            std::unique_ptr<RS_FilterInterface> filter(createFilter(format));
+            ok = filter->fileImport(g, file, importType(format)) && ok;
+            read = countItems(g, fontFormat);
+        });
+        if (bench.enabled(name + "/read") && (!ok || read!=items)) {
+            std::cerr << "fileio: " << format.name << ": import "
+                      << (ok ? "incomplete" : "failed")
+                      << ", read " << read << " of " << items << "\n";
+        }
+
+        // the legacy DXF 1 importer reads only R12
+        if (format.type==RS2::FormatDXFRW12) {
+            ok = true;
+            measureIO(bench, name + "/read_dxf1", items, file, [&]() {
+                RS_Graphic g;
+                RS_FilterDXF1 filter;
+                ok = filter.fileImport(g, file, RS2::FormatDXF1) && ok;
+            });
+            if (!ok) {
+                std::cerr << "fileio: " << format.name << ": DXF 1 import failed\n";
+            }
+        }
+
+        if (corpus.isEmpty()) {
+            QFile::remove(file);
+        }
+    }
+    if (corpus.isEmpty()) {
+        QDir().rmdir(dir.path());
+    }
+}
@@ -0,0 +1,377 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+/**
+ * Benchmarks for the core geometry of the library: intersections,
+ * equation solvers, nearest points, hatch and insert updates and
+ * bounding boxes, all on synthetic data of the requested size.
+ */
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "lc_benchmark.h"
+#include "lc_quadratic.h"
+#include "lc_splinepoints.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_information.h"
+#include "rs_insert.h"
+#include "rs_line.h"
+#include "rs_math.h"
+
+namespace {
+
+/**
+ * Creates random entities in the square (0,0)-(extent,extent), with
+ * a fixed seed so every run and every release sees the same data.
+ */
+class EntityFactory {
+public:
+    explicit EntityFactory(double extent = 1000.)
+        : gen(42),
+          extent(extent) {}
+
+    double value(double min, double max) {
+        return std::uniform_real_distribution<double>(min, max)(gen);
+    }
+    RS_Vector point() {
+        return RS_Vector(value(0., extent), value(0., extent));
+    }
+    double size() {
+        return value(extent*0.01, extent*0.1);
+    }
+
+    RS_Entity* create(RS2::EntityType type, RS_EntityContainer* parent) {
+        switch (type) {
+        case RS2::EntityLine: {
+            RS_Vector p = point();
+            return new RS_Line(parent, RS_LineData(p, p + RS_Vector(value(0., 2.*M_PI))*size()));
+        }
+        case RS2::EntityArc:
+            return new RS_Arc(parent, RS_ArcData(point(), size(),
+                                                 value(0., M_PI), value(M_PI, 2.*M_PI),
+                                                 false));
+        case RS2::EntityCircle:
+            return new RS_Circle(parent, RS_CircleData(point(), size()));
+        case RS2::EntityEllipse:
+            return new RS_Ellipse(parent, RS_EllipseData(point(),
+                                                         RS_Vector(value(0., 2.*M_PI))*size(),
+                                                         value(0.2, 0.9), 0., 0., false));
+        case RS2::EntitySplinePoints: {
+            LC_SplinePoints* s = new LC_SplinePoints(parent, LC_SplinePointsData(false, false));
+            RS_Vector p = point();
+            for (int i=0; i<6; ++i) {
+                s->addControlPoint(p);
+                p += RS_Vector(value(0., 2.*M_PI))*size();
+            }
+            s->update();
+            return s;
+        }
+        default:
+            return NULL;
+        }
+    }
+
+    /** Fills the container with count entities of the given type. */
+    void fill(RS_EntityContainer& c, RS2::EntityType type, int count) {
+        for (int i=0; i<count; ++i) {
+            c.addEntity(create(type, &c));
+        }
+    }
+
+    /** Fills the container with count entities of mixed types. */
+    void fillMixed(RS_EntityContainer& c, int count) {
+        static const RS2::EntityType types[] = {
+            RS2::EntityLine, RS2::EntityLine, RS2::EntityLine, RS2::EntityArc,
+            RS2::EntityCircle, RS2::EntityEllipse, RS2::EntitySplinePoints
+        };
+        for (int i=0; i<count; ++i) {
+            c.addEntity(create(types[i%7], &c));
+        }
+    }
+
+private:
+    std::mt19937 gen;
+    double extent;
+};
+
+struct TypeName {
+    RS2::EntityType type;
+    const char* name;
+};
+
+const TypeName atomicTypes[] = {
+    {RS2::EntityLine, "Line"},
+    {RS2::EntityArc, "Arc"},
+    {RS2::EntityCircle, "Circle"},
+    {RS2::EntityEllipse, "Ellipse"},
+    {RS2::EntitySplinePoints, "SplinePoints"}
+};
+const int atomicTypeCount = sizeof(atomicTypes)/sizeof(atomicTypes[0]);
+
+}
+
+
+
+/**
+ * RS_Information::getIntersection for every pair of atomic entity types.
+ */
+LC_BENCHMARK_SUITE(intersection) {
+    const int n = bench.size();
+    EntityFactory factory;
+    std::vector<RS_EntityContainer*> sets;
+    for (int i=0; i<atomicTypeCount; ++i) {
+        RS_EntityContainer* c = new RS_EntityContainer(NULL, true);
+        factory.fill(*c, atomicTypes[i].type, n);
+        sets.push_back(c);
+    }
+
+    for (int i=0; i<atomicTypeCount; ++i) {
+        for (int j=i; j<atomicTypeCount; ++j) {
+            RS_EntityContainer* c1 = sets[i];
+            RS_EntityContainer* c2 = sets[j];
+            bench.measure(QString("%1-%2").arg(atomicTypes[i].name).arg(atomicTypes[j].name),
+                          n, [&]() {
+                size_t found = 0;
+                for (int k=0; k<n; ++k) {
+                    // pair each entity with a different one of the other set
+                    RS_VectorSolutions sol = RS_Information::getIntersection(
+                                c1->entityAt(k), c2->entityAt((k*7 + 1)%n), false);
+                    found += sol.getNumber();
+                }
+                LC_Benchmark::consume(found);
+            });
+        }
+    }
+
+    for (RS_EntityContainer* c: sets) {
+        delete c;
+    }
+}
+
+
+
+/**
+ * LC_Quadratic::getIntersection for the quadratic forms of lines,
+ * circles and ellipses.
+ */
+LC_BENCHMARK_SUITE(quadratic) {
+    const int n = bench.size();
+    EntityFactory factory;
+    const int types = 4; // Line, Arc, Circle, Ellipse
+    std::vector<std::vector<LC_Quadratic> > forms(types);
+    RS_EntityContainer c(NULL, true);
+    for (int i=0; i<types; ++i) {
+        for (int k=0; k<n; ++k) {
+            RS_Entity* e = factory.create(atomicTypes[i].type, &c);
+            forms[i].push_back(e->getQuadratic());
+            delete e;
+        }
+    }
+
+    for (int i=0; i<types; ++i) {
+        for (int j=i; j<types; ++j) {
+            const std::vector<LC_Quadratic>& q1 = forms[i];
+            const std::vector<LC_Quadratic>& q2 = forms[j];
+            bench.measure(QString("%1-%2").arg(atomicTypes[i].name).arg(atomicTypes[j].name),
+                          n, [&]() {
+                size_t found = 0;
+                for (int k=0; k<n; ++k) {
+                    found += LC_Quadratic::getIntersection(q1[k], q2[(k*7 + 1)%n]).getNumber();
+                }
+                LC_Benchmark::consume(found);
+            });
+        }
+    }
+}
+
+
+
+/**
+ * Polynomial solvers of RS_Math.
+ */
+LC_BENCHMARK_SUITE(solver) {
+    const int n = bench.size();
+    EntityFactory factory;
+    std::vector<std::vector<double> > cubic(n), quartic(n);
+    for (int k=0; k<n; ++k) {
+        for (int i=0; i<3; ++i) {
+            cubic[k].push_back(factory.value(-10., 10.));
+        }
+        for (int i=0; i<4; ++i) {
+            quartic[k].push_back(factory.value(-10., 10.));
+        }
+    }
+
+    bench.measure("cubicSolver", n, [&]() {
+        size_t roots = 0;
+        for (int k=0; k<n; ++k) {
+            roots += RS_Math::cubicSolver(cubic[k]).size();
+        }
+        LC_Benchmark::consume(roots);
+    });
+    bench.measure("quarticSolver", n, [&]() {
+        size_t roots = 0;
+        for (int k=0; k<n; ++k) {
+            roots += RS_Math::quarticSolver(quartic[k]).size();
+        }
+        LC_Benchmark::consume(roots);
+    });
+}
+
+
+
+/**
+ * getNearestPointOnEntity for curves without closed form solution.
+ */
+LC_BENCHMARK_SUITE(nearest) {
+    const int n = bench.size();
+    EntityFactory factory;
+    std::vector<RS_Vector> points;
+    for (int k=0; k<n; ++k) {
+        points.push_back(factory.point());
+    }
+
+    const TypeName curves[] = {
+        {RS2::EntityEllipse, "Ellipse"},
+        {RS2::EntitySplinePoints, "SplinePoints"}
+    };
+    for (const TypeName& t: curves) {
+        RS_EntityContainer c(NULL, true);
+        factory.fill(c, t.type, n);
+        bench.measure(t.name, n, [&]() {
+            double sum = 0.;
+            for (int k=0; k<n; ++k) {
+                double dist = 0.;
+                c.entityAt(k)->getNearestPointOnEntity(points[k], true, &dist);
+                sum += dist;
+            }
+            LC_Benchmark::consume(sum);
+        });
+    }
+}
+
+
+
+/**
+ * RS_Hatch::update of a pattern hatch with size() circular islands.
+ */
+LC_BENCHMARK_SUITE(hatch) {
+    const int n = bench.size();
+    const int side = qMax(1, int(sqrt(double(n))));
+    const double extent = side*10.;
+
+    RS_Graphic graphic;
+    RS_Hatch* hatch = new RS_Hatch(&graphic, RS_HatchData(false, 1., 0., "ANSI31"));
+    graphic.addEntity(hatch);
+
+    RS_EntityContainer* loop = new RS_EntityContainer(hatch);
+    loop->setLayer(NULL);
+    hatch->addEntity(loop);
+    const RS_Vector corners[] = {
+        RS_Vector(0., 0.), RS_Vector(extent, 0.),
+        RS_Vector(extent, extent), RS_Vector(0., extent)
+    };
+    for (int i=0; i<4; ++i) {
+        RS_Line* l = new RS_Line(loop, RS_LineData(corners[i], corners[(i+1)%4]));
+        l->setLayer(NULL);
+        loop->addEntity(l);
+    }
+    for (int k=0; k<n; ++k) {
+        RS_EntityContainer* island = new RS_EntityContainer(hatch);
+        island->setLayer(NULL);
+        hatch->addEntity(island);
+        RS_Circle* c = new RS_Circle(island,
+                                     RS_CircleData(RS_Vector(5. + 10.*(k%side), 5. + 10.*(k/side)), 3.));
+        c->setLayer(NULL);
+        island->addEntity(c);
+    }
+
+    bench.measure("ANSI31", 1, [&]() {
+        hatch->update();
+    });
+    if (hatch->getUpdateError()!=RS_Hatch::HATCH_OK) {
+        std::cerr << "hatch: update failed with error " << hatch->getUpdateError()
+                  << " (pattern library not found?)\n";
+    }
+}
+
+
+
+/**
+ * RS_Insert::update of inserts of a block with size() entities.
+ */
+LC_BENCHMARK_SUITE(insert) {
+    const int n = bench.size();
+    const int inserts = 10;
+    EntityFactory factory(100.);
+
+    RS_Graphic graphic;
+    RS_Block* block = new RS_Block(&graphic, RS_BlockData("bench", RS_Vector(0., 0.), false));
+    factory.fillMixed(*block, n);
+    graphic.addBlock(block);
+
+    for (int i=0; i<inserts; ++i) {
+        RS_Insert* insert = new RS_Insert(&graphic,
+                                          RS_InsertData("bench", RS_Vector(i*150., 0.),
+                                                        RS_Vector(1.5, 1.5), 0.3*i,
+                                                        1, 1, RS_Vector(0., 0.)));
+        graphic.addEntity(insert);
+    }
+
+    bench.measure("update", inserts, [&]() {
+        for (RS_Entity* e=graphic.firstEntity(RS2::ResolveNone); e!=NULL;
+             e=graphic.nextEntity(RS2::ResolveNone)) {
+            if (e->rtti()==RS2::EntityInsert) {
+                static_cast<RS_Insert*>(e)->update();
+            }
+        }
+    });
+}
+
+
+
+/**
+ * RS_EntityContainer::calculateBorders of a drawing with size() entities.
+ */
+LC_BENCHMARK_SUITE(borders) {
+    const int n = bench.size();
+    EntityFactory factory;
+    RS_Graphic graphic;
+    factory.fillMixed(graphic, n);
+
+    bench.measure("calculateBorders", n, [&]() {
+        graphic.calculateBorders();
+        LC_Benchmark::consume(graphic.getSize().x);
+    });
+}
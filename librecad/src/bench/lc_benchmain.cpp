@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include <iostream>
+#include <QApplication>
+#include <QFileInfo>
+#include <QMap>
+#include <QSplashScreen>
+
+#include "main.h"
+#include "rs_debug.h"
+#include "rs_fileio.h"
+#include "rs_filtercxf.h"
+#include "rs_filterdxf1.h"
+#include "rs_filterdxfrw.h"
+#include "rs_filterjww.h"
+#include "rs_filterlff.h"
+#include "rs_fontlist.h"
+#include "rs_patternlist.h"
+#include "rs_settings.h"
+#include "rs_system.h"
+#include "lc_benchmark.h"
+
+//! referenced by QC_ApplicationWindow, there is no splash screen here
+QSplashScreen *splash=nullptr;
+
+namespace {
+void usage() {
+    std::cout << "Usage: librecad_bench [options]\n"
+              << "  --size N     size of the synthetic data (default 1000)\n"
+              << "  --repeat N   runs per case, best and mean are reported (default 5)\n"
+              << "  --filter S   only run cases whose \"suite/case\" contains S\n"
+              << "  --json       print results as JSON instead of tab separated values\n"
+              << "  --corpus DIR keep the files written by the fileio suite in DIR\n"
+              << "  --drawing F  render the drawing F instead of a synthetic one\n"
+              << "  --image WxH  size of the rendered images (default 1920x1080)\n"
+              << "  --composition lines=N,arcs=N,polylines=N,hatches=N,inserts=N,texts=N,splines=N,dimensions=N\n"
+              << "               entities of the synthetic drawings, unset kinds follow --size\n"
+              << "  --list       list the benchmark suites\n";
+}
+}
+
+
+/**
+ * Headless benchmark runner for the library code, see LC_Benchmark.
+ */
+int main(int argc, char** argv) {
+#if QT_VERSION >= 0x050000
+    // no display needed
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty()) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+#else
+    QApplication app(argc, argv, false);
+#endif
+    QCoreApplication::setApplicationName(XSTR(QC_APPNAME));
+
+    RS_DEBUG->setLevel(RS_Debug::D_NOTHING);
+
+    int size = 1000;
+    int repeat = 5;
+    QString filter;
+    bool json = false;
+    QMap<QString, QString> options;
+
+    QStringList args = app.arguments();
+    for (int i=1; i<args.size(); ++i) {
+        const QString& a = args.at(i);
+        if (a=="--size" && i+1<args.size()) {
+            size = args.at(++i).toInt();
+        } else if (a=="--repeat" && i+1<args.size()) {
+            repeat = args.at(++i).toInt();
+        } else if (a=="--filter" && i+1<args.size()) {
+            filter = args.at(++i);
+        } else if ((a=="--corpus" || a=="--composition"
+                    || a=="--drawing" || a=="--image") && i+1<args.size()) {
+            options[a.mid(2)] = args.at(++i);
+        } else if (a=="--json") {
+            json = true;
+        } else if (a=="--list") {
+            for (const QString& s: LC_Benchmark::suiteNames()) {
+                std::cout << s.toStdString() << "\n";
+            }
+            return 0;
+        } else {
+            usage();
+            return a=="--help" ? 0 : 1;
+        }
+    }
+
+    QFileInfo prgInfo(QFile::decodeName(argv[0]));
+    RS_SETTINGS->init(XSTR(QC_COMPANYKEY), XSTR(QC_APPKEY));
+    RS_SYSTEM->init(XSTR(QC_APPNAME), XSTR(QC_VERSION), XSTR(QC_APPDIR),
+                    prgInfo.absolutePath());
+    RS_FONTLIST->init();
+    RS_PATTERNLIST->init();
+
+    RS_FileIO::instance()->registerFilter(&(RS_FilterLFF::createFilter));
+    RS_FileIO::instance()->registerFilter(&(RS_FilterDXFRW::createFilter));
+    RS_FileIO::instance()->registerFilter(&(RS_FilterCXF::createFilter));
+    RS_FileIO::instance()->registerFilter(&(RS_FilterJWW::createFilter));
+    RS_FileIO::instance()->registerFilter(&(RS_FilterDXF1::createFilter));
+
+    LC_Benchmark bench(std::cout, size, repeat, filter, json);
+    for (auto it=options.constBegin(); it!=options.constEnd(); ++it) {
+        bench.setOption(it.key(), it.value());
+    }
+    bench.run();
+    return bench.failed() ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include "lc_benchmark.h"
+
+#include <iostream>
+#include <QFile>
+#include <QMap>
+
+namespace {
+QMap<QString, LC_Benchmark::Suite>& suites() {
+    static QMap<QString, LC_Benchmark::Suite> s;
+    return s;
+}
+
+volatile double sink = 0.;
+}
+
+
+LC_Benchmark::LC_Benchmark(std::ostream& out, int size, int repeat,
+                           const QString& filter, bool json)
+    : out(out),
+      sizeValue(size>0 ? size : 1),
+      repeatValue(repeat>0 ? repeat : 1),
+      filter(filter),
+      json(json),
+      first(true),
+      failedValue(false) {
+
+    if (json) {
+        out << "[\n";
+    } else {
+        out << "suite\tcase\tsize\tops\tbest_ns_per_op\tmean_ns_per_op\n";
+    }
+}
+
+
+
+LC_Benchmark::~LC_Benchmark() {
+    if (json) {
+        out << "\n]\n";
+    }
+    out.flush();
+}
+
+
+
+bool LC_Benchmark::registerSuite(const char* name, Suite suite) {
+    suites().insert(name, suite);
+    return true;
+}
+
+
+
+QList<QString> LC_Benchmark::suiteNames() {
+    return suites().keys();
+}
+
+
+
+void LC_Benchmark::run() {
+    for (auto it=suites().constBegin(); it!=suites().constEnd(); ++it) {
+        suite = it.key();
+        it.value()(*this);
+    }
+    suite.clear();
+}
+
+
+
+bool LC_Benchmark::enabled(const QString& name) const {
+    return filter.isEmpty()
+            || (suite + "/" + name).contains(filter, Qt::CaseInsensitive);
+}
+
+
+
+void LC_Benchmark::separator() {
+    if (json && !first) {
+        out << ",\n";
+    }
+    first = false;
+}
+
+
+
+void LC_Benchmark::report(const QString& name, size_t ops,
+                          double best, double mean) {
+    if (ops==0) {
+        ops = 1;
+    }
+    separator();
+    if (json) {
+        out << "  {\"suite\": \"" << suite.toStdString()
+            << "\", \"case\": \"" << name.toStdString()
+            << "\", \"size\": " << sizeValue
+            << ", \"ops\": " << ops
+            << ", \"best_ns_per_op\": " << best/ops
+            << ", \"mean_ns_per_op\": " << mean/ops << "}";
+    } else {
+        out << suite.toStdString() << "\t" << name.toStdString()
+            << "\t" << sizeValue << "\t" << ops
+            << "\t" << best/ops << "\t" << mean/ops << "\n";
+    }
+    out.flush();
+}
+
+
+
+void LC_Benchmark::reportValue(const QString& name, const QString& unit,
+                               double value) {
+    if (!enabled(name)) {
+        return;
+    }
+    separator();
+    if (json) {
+        out << "  {\"suite\": \"" << suite.toStdString()
+            << "\", \"case\": \"" << name.toStdString()
+            << "\", \"size\": " << sizeValue
+            << ", \"unit\": \"" << unit.toStdString()
+            << "\", \"value\": " << value << "}";
+    } else {
+        out << suite.toStdString() << "\t" << name.toStdString()
+            << " [" << unit.toStdString() << "]"
+            << "\t" << sizeValue << "\t1\t" << value << "\t" << value << "\n";
+    }
+    out.flush();
+}
+
+
+
+void LC_Benchmark::fail(const QString& message) {
+    std::cerr << "FAILED " << suite.toStdString() << ": "
+              << message.toStdString() << std::endl;
+    failedValue = true;
+}
+
+
+
+void LC_Benchmark::consume(double v) {
+    sink = sink + v;
+}
+
+
+
+void LC_Benchmark::resetPeakMemory() {
+#ifdef Q_OS_LINUX
+    // "5" resets VmHWM to the current resident size, see proc(5)
+    QFile f("/proc/self/clear_refs");
+    if (f.open(QIODevice::WriteOnly)) {
+        f.write("5");
+    }
+#endif
+}
+
+
+
+long LC_Benchmark::peakMemory() {
+#ifdef Q_OS_LINUX
+    QFile f("/proc/self/status");
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!f.atEnd()) {
+            QByteArray line = f.readLine();
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toLong();
+            }
+        }
+    }
+#endif
+    return -1;
+}
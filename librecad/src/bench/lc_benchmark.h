@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_BENCHMARK_H
+#define LC_BENCHMARK_H
+
+#include <chrono>
+#include <functional>
+#include <iosfwd>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+/**
+ * Minimal benchmark runner for the library code.
+ *
+ * Suites are registered with LC_BENCHMARK_SUITE and get the runner
+ * passed. They set up their data for the requested size() and time
+ * cases with measure(). Every case is repeated repeat() times, the
+ * fastest and the mean run are reported.
+ *
+ * Output is one line per case, either tab separated:
+ * <pre>
+ *   suite  case  size  ops  best_ns_per_op  mean_ns_per_op
+ * </pre>
+ * or a JSON array of objects with the same fields (--json), so
+ * results can be compared across releases by scripts.
+ */
+class LC_Benchmark {
+public:
+    typedef std::function<void(LC_Benchmark&)> Suite;
+
+    LC_Benchmark(std::ostream& out, int size, int repeat,
+                 const QString& filter, bool json);
+
+    /** Registers a suite, used by LC_BENCHMARK_SUITE. */
+    static bool registerSuite(const char* name, Suite suite);
+    static QList<QString> suiteNames();
+
+    /** Runs all suites with a name containing the filter. */
+    void run();
+
+    /** Size of the synthetic data (entities, equations, ...) */
+    int size() const {
+        return sizeValue;
+    }
+    int repeat() const {
+        return repeatValue;
+    }
+
+    /**
+     * Free form options of the command line (--corpus DIR, ...) for
+     * suites that need more than the size.
+     */
+    void setOption(const QString& key, const QString& value) {
+        options[key] = value;
+    }
+    QString option(const QString& key, const QString& def = QString()) const {
+        return options.value(key, def);
+    }
+
+    /**
+     * Times fn, which performs ops operations, and reports it as
+     * case name of the current suite. fn is called repeat() times.
+     *
+     * @return fastest run in ns, 0 if the case is filtered out.
+     */
+    template <class F>
+    double measure(const QString& name, size_t ops, F fn) {
+        if (!enabled(name)) {
+            return 0.;
+        }
+        double best = 0.;
+        double total = 0.;
+        for (int i=0; i<repeatValue; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            std::chrono::duration<double, std::nano> t =
+                    std::chrono::steady_clock::now() - start;
+            total += t.count();
+            if (i==0 || t.count()<best) {
+                best = t.count();
+            }
+        }
+        report(name, ops, best, total/repeatValue);
+        return best;
+    }
+
+    /**
+     * Reports a value measured by the suite itself (e.g. bytes or
+     * a rate) instead of a time per operation.
+     */
+    void reportValue(const QString& name, const QString& unit, double value);
+
+    /**
+     * @return true if the case name of the current suite passes the
+     * filter. Suites can use it to skip expensive setup.
+     */
+    bool enabled(const QString& name) const;
+
+    /**
+     * Reports a failed self check of a suite, e.g. two implementations
+     * with different results. The runner exits with status 1.
+     */
+    void fail(const QString& message);
+    bool failed() const {
+        return failedValue;
+    }
+
+    /** Keeps the optimizer from dropping results of benchmarked code. */
+    static void consume(double v);
+
+    /**
+     * Resets the peak resident memory of the process, so the next
+     * peakMemory() covers only what ran in between.
+     * Only supported on Linux, a no-op elsewhere.
+     */
+    static void resetPeakMemory();
+    /**
+     * @return peak resident memory of the process in KiB, or -1 if
+     * the platform offers no way to read it.
+     */
+    static long peakMemory();
+
+    ~LC_Benchmark();
+
+private:
+    void report(const QString& name, size_t ops, double best, double mean);
+    void separator();
+
+    std::ostream& out;
+    int sizeValue;
+    int repeatValue;
+    QString filter;
+    QMap<QString, QString> options;
+    bool json;
+    bool first;
+    bool failedValue;
+    QString suite;
+};
+
+
+/**
+ * Registers the function following the macro as benchmark suite:
+ * <pre>
+ *   LC_BENCHMARK_SUITE(math) {
+ *       bench.measure("cubicSolver", n, [&]() { ... });
+ *   }
+ * </pre>
+ */
+#define LC_BENCHMARK_SUITE(name) \
+    static void lc_benchmark_##name(LC_Benchmark& bench); \
+    static const bool lc_benchmark_##name##_registered = \
+        LC_Benchmark::registerSuite(#name, lc_benchmark_##name); \
+    static void lc_benchmark_##name(LC_Benchmark& bench)
+
+#endif
@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+/**
+ * Memory per entity. For every kind of entity a drawing of size()
+ * entities is built and kept, and the suite reports:
+ * - the resident memory it took, per entity (Linux only; includes
+ *   entity pools, heap data and allocator overhead)
+ * - the bytes per entity estimated by LC_MemoryReport
+ * - sizeof() of the classes the entity header changes affect
+ *
+ * Run with a large size to get stable numbers, e.g.
+ * <pre>
+ *   librecad_bench --filter memory --size 1000000
+ * </pre>
+ */
+
+#include <QStringList>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "lc_benchdrawing.h"
+#include "lc_benchmark.h"
+#include "lc_memoryreport.h"
+#include "rs_arc.h"
+#include "rs_graphic.h"
+#include "rs_line.h"
+
+LC_BENCHMARK_SUITE(memory) {
+    bench.reportValue("sizeof/RS_Color", "bytes", sizeof(RS_Color));
+    bench.reportValue("sizeof/RS_Pen", "bytes", sizeof(RS_Pen));
+    bench.reportValue("sizeof/RS_Entity", "bytes", sizeof(RS_Entity));
+    bench.reportValue("sizeof/RS_Line", "bytes", sizeof(RS_Line));
+    bench.reportValue("sizeof/RS_Arc", "bytes", sizeof(RS_Arc));
+
+    const QStringList kinds = QStringList() << "lines" << "arcs" << "polylines"
+                                            << "texts" << "inserts" << "hatches";
+    for (const QString& kind: kinds) {
+        if (!bench.enabled(kind + "/resident") && !bench.enabled(kind + "/estimated")) {
+            continue;
+        }
+        LC_BenchDrawing::Composition c;
+        LC_BenchDrawing::parse(QString("%1=%2").arg(kind).arg(bench.size()), c);
+
+#ifdef __GLIBC__
+        // memory freed by the previous kind would be reused unnoticed:
+        malloc_trim(0);
+#endif
+        LC_Benchmark::resetPeakMemory();
+        long base = LC_Benchmark::peakMemory();
+        RS_Graphic* graphic = new RS_Graphic();
+        LC_BenchDrawing::create(*graphic, c);
+        long peak = LC_Benchmark::peakMemory();
+
+        if (base>=0 && peak>=0) {
+            bench.reportValue(kind + "/resident", "bytes/entity",
+                              (peak - base)*1024./bench.size());
+        }
+        LC_MemoryReport::Row total = LC_MemoryReport(graphic).total();
+        bench.reportValue(kind + "/estimated", "bytes/entity",
+                          double(total.objectBytes + total.extraBytes)/bench.size());
+        delete graphic;
+    }
+}
@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+/**
+ * Frame times of the screen rendering, headless: a drawing is
+ * rendered through RS_StaticGraphicView and RS_PainterQt into
+ * offscreen images at several zoom levels and viewport positions.
+ *
+ * Frames are composed like QG_GraphicView::paintEvent() does it: grid,
+ * entities and overlay are drawn to images of their own and blitted
+ * to the screen image. Every view reports the time of each phase, of
+ * the whole frame and per entity for every top level entity type.
+ *
+ * The entities are also drawn by RS_GraphicView::drawLayer2Parallel()
+ * on all threads of the global pool, which is reported as speedup over
+ * the single threaded entities phase. Drawings with less top level
+ * entities than the parallel path needs are drawn single threaded and
+ * report "parallel" 0.
+ *
+ * The drawing is synthetic (see LC_BenchDrawing) unless a file is
+ * given with --drawing, so customer drawings can be measured too.
+ */
+
+#include <iostream>
+#include <QImage>
+#include <QMap>
+#include <QPainter>
+#include <QStringList>
+#include <QThreadPool>
+
+#include "lc_benchdrawing.h"
+#include "lc_benchmark.h"
+#include "lc_memoryreport.h"
+#include "rs_graphic.h"
+#include "rs_painterqt.h"
+#include "rs_staticgraphicview.h"
+
+namespace {
+
+/**
+ * Viewport as zoom factor relative to the drawing extents and
+ * center position in fractions of the extents.
+ */
+struct View {
+    const char* name;
+    double zoom;
+    double x;
+    double y;
+};
+
+const View views[] = {
+    {"extents",    1.,  0.5,   0.5},
+    {"x4_center",  4.,  0.5,   0.5},
+    {"x4_corner",  4.,  0.125, 0.125},
+    {"x16_center", 16., 0.5,   0.5},
+    {"x16_corner", 16., 0.875, 0.875},
+    {"x64_center", 64., 0.5,   0.5}
+};
+
+/** The offscreen images of one frame. */
+struct Frame {
+    Frame(int w, int h)
+        : grid(w, h, QImage::Format_ARGB32_Premultiplied),
+          entities(w, h, QImage::Format_ARGB32_Premultiplied),
+          overlay(w, h, QImage::Format_ARGB32_Premultiplied),
+          screen(w, h, QImage::Format_RGB32) {}
+
+    void drawGrid(RS_GraphicView& view) {
+        grid.fill(0xffffffff);
+        RS_PainterQt painter(&grid);
+        view.drawLayer1(&painter);
+        painter.end();
+    }
+
+    void drawEntities(RS_GraphicView& view) {
+        entities.fill(0);
+        RS_PainterQt painter(&entities);
+        painter.setDrawSelectedOnly(false);
+        view.drawLayer2(&painter);
+        painter.setDrawSelectedOnly(true);
+        view.drawLayer2(&painter);
+        painter.end();
+    }
+
+    /** @return false if the drawing was drawn single threaded. */
+    bool drawEntitiesParallel(RS_GraphicView& view) {
+        entities.fill(0);
+        RS_PainterQt painter(&entities);
+        const bool parallel = view.drawLayer2Parallel(&painter);
+        if (!parallel) {
+            painter.setDrawSelectedOnly(false);
+            view.drawLayer2(&painter);
+            painter.setDrawSelectedOnly(true);
+            view.drawLayer2(&painter);
+        }
+        painter.end();
+        return parallel;
+    }
+
+    void drawOverlay(RS_GraphicView& view) {
+        overlay.fill(0);
+        RS_PainterQt painter(&overlay);
+        view.drawLayer3(&painter);
+        painter.end();
+    }
+
+    void compose() {
+        QPainter painter(&screen);
+        painter.drawImage(0, 0, grid);
+        painter.drawImage(0, 0, entities);
+        painter.drawImage(0, 0, overlay);
+        painter.end();
+    }
+
+    QImage grid;
+    QImage entities;
+    QImage overlay;
+    QImage screen;
+};
+
+}
+
+
+
+LC_BENCHMARK_SUITE(render) {
+    RS_Graphic graphic;
+    QString file = bench.option("drawing");
+    if (file.isEmpty()) {
+        LC_BenchDrawing::Composition composition =
+                LC_BenchDrawing::defaultComposition(bench.size());
+        if (!LC_BenchDrawing::parse(bench.option("composition"), composition)) {
+            std::cerr << "render: invalid composition '"
+                      << bench.option("composition").toStdString() << "'\n";
+            return;
+        }
+        LC_BenchDrawing::create(graphic, composition);
+    } else if (!graphic.open(file, RS2::FormatUnknown)) {
+        std::cerr << "render: cannot open " << file.toStdString() << "\n";
+        return;
+    }
+    graphic.calculateBorders();
+
+    QStringList image = bench.option("image", "1920x1080").split('x');
+    int w = image.size()==2 ? image.at(0).toInt() : 0;
+    int h = image.size()==2 ? image.at(1).toInt() : 0;
+    if (w<=0 || h<=0) {
+        std::cerr << "render: invalid image size '"
+                  << bench.option("image").toStdString() << "'\n";
+        return;
+    }
+
+    // top level entities by type, inserts and hatches include their contents
+    QMap<RS2::EntityType, QList<RS_Entity*> > byType;
+    for (RS_Entity* e=graphic.firstEntity(RS2::ResolveNone); e!=NULL;
+         e=graphic.nextEntity(RS2::ResolveNone)) {
+        byType[e->rtti()].append(e);
+    }
+
+    Frame frame(w, h);
+    // painters are created per phase and frame, as QG_GraphicView does
+    RS_StaticGraphicView view(w, h, NULL);
+    view.setContainer(&graphic);
+
+    const RS_Vector min = graphic.getMin();
+    const RS_Vector size = graphic.getSize();
+    bench.reportValue("threads", "", QThreadPool::globalInstance()->maxThreadCount());
+    for (const View& v: views) {
+        const QString name = v.name;
+        const RS_Vector center(min.x + size.x*v.x, min.y + size.y*v.y);
+        const RS_Vector half = size*(0.5/v.zoom);
+        view.zoomWindow(center - half, center + half);
+
+        bench.measure(name + "/grid", 1, [&]() {
+            frame.drawGrid(view);
+        });
+        const double serial = bench.measure(name + "/entities", 1, [&]() {
+            frame.drawEntities(view);
+        });
+        bool parallel = false;
+        const double threaded = bench.measure(name + "/entities_parallel", 1, [&]() {
+            parallel = frame.drawEntitiesParallel(view);
+        });
+        if (serial>0. && threaded>0.) {
+            bench.reportValue(name + "/parallel", "", parallel ? 1. : 0.);
+            bench.reportValue(name + "/parallel_speedup", "x", serial/threaded);
+        }
+        bench.measure(name + "/overlay", 1, [&]() {
+            frame.drawOverlay(view);
+        });
+        bench.measure(name + "/frame", 1, [&]() {
+            frame.drawGrid(view);
+            frame.drawEntities(view);
+            frame.drawOverlay(view);
+            frame.compose();
+        });
+
+        for (auto it=byType.constBegin(); it!=byType.constEnd(); ++it) {
+            const QList<RS_Entity*>& entities = it.value();
+            QString type = QString(LC_MemoryReport::typeName(it.key())).toLower();
+            bench.measure(name + "/" + type, entities.size(), [&]() {
+                frame.entities.fill(0);
+                RS_PainterQt painter(&frame.entities);
+                view.updateRenderContext(&painter);
+                for (RS_Entity* e: entities) {
+                    view.drawEntity(&painter, e);
+                }
+                painter.end();
+            });
+        }
+    }
+}
@@ -0,0 +1,199 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+/**
+ * Bulk point operations of LC_VectorOps against the RS_Vector member
+ * functions they replace, on size() random points: bounding boxes of
+ * points (extend) and of entity borders (box, as in
+ * RS_EntityContainer::calculateBorders), move, rotate, scale and the
+ * closest point.
+ *
+ * The layout is the one of the build, compare a normal build with one
+ * configured with CONFIG+=vector2d (see scripts/check-vector2d.sh).
+ * Every case also checks that both implementations give the same
+ * result and fails the run otherwise.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "lc_benchmark.h"
+#include "lc_vectorops.h"
+#include "rs_vector.h"
+
+namespace {
+
+typedef std::vector<RS_Vector> Points;
+
+//! equal up to rounding, compilers may contract a*b+c differently
+bool same(const RS_Vector& a, const RS_Vector& b) {
+    return std::abs(a.x - b.x)<=1e-12*std::max(1., std::abs(a.x))
+            && std::abs(a.y - b.y)<=1e-12*std::max(1., std::abs(a.y));
+}
+
+bool same(const Points& a, const Points& b) {
+    for (size_t i=0; i<a.size(); ++i) {
+        if (!same(a[i], b[i])) {
+            return false;
+        }
+    }
+    return a.size()==b.size();
+}
+
+/**
+ * Times the RS_Vector version "rs_vector" and the LC_VectorOps version
+ * "lc_vectorops" of operation op on copies of pts, then compares the
+ * points they leave behind.
+ */
+template <class F1, class F2>
+void compare(LC_Benchmark& bench, const QString& op, const Points& pts,
+             F1 member, F2 bulk) {
+    const QString layout = sizeof(RS_Vector)==3*sizeof(double) ? "2d" : "3d";
+    Points p1 = pts;
+    Points p2 = pts;
+    bench.measure(op + "/" + layout + "/rs_vector", pts.size(), [&]() {
+        member(p1);
+    });
+    bench.measure(op + "/" + layout + "/lc_vectorops", pts.size(), [&]() {
+        bulk(p2);
+    });
+    p1 = pts;
+    p2 = pts;
+    member(p1);
+    bulk(p2);
+    if (!same(p1, p2)) {
+        bench.fail(op + ": LC_VectorOps differs from RS_Vector");
+    }
+}
+
+}
+
+
+LC_BENCHMARK_SUITE(vector) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> value(0., 1000.);
+    Points pts(bench.size());
+    for (RS_Vector& p: pts) {
+        p = RS_Vector(value(gen), value(gen));
+    }
+    Points boxMax(pts.size());
+    for (size_t i=0; i<pts.size(); ++i) {
+        boxMax[i] = pts[i] + RS_Vector(value(gen), value(gen))*0.01;
+    }
+
+    const RS_Vector center(10., 20.);
+    const RS_Vector angle(1e-3);
+    const RS_Vector offset(1e-3, -1e-3);
+    const RS_Vector factor(1.0001, 0.9999);
+
+    RS_Vector min1, max1, min2, max2;
+    compare(bench, "extend", pts, [&](Points& p) {
+        min1 = RS_Vector(RS_MAXDOUBLE, RS_MAXDOUBLE);
+        max1 = RS_Vector(RS_MINDOUBLE, RS_MINDOUBLE);
+        for (const RS_Vector& v: p) {
+            if (v.valid) {
+                min1 = RS_Vector::minimum(min1, v);
+                max1 = RS_Vector::maximum(max1, v);
+            }
+        }
+    }, [&](Points& p) {
+        min2 = RS_Vector(RS_MAXDOUBLE, RS_MAXDOUBLE);
+        max2 = RS_Vector(RS_MINDOUBLE, RS_MINDOUBLE);
+        LC_VectorOps::extend(p.begin(), p.end(), min2, max2);
+    });
+    if (!same(min1, min2) || !same(max1, max2)) {
+        bench.fail("extend: LC_VectorOps differs from RS_Vector");
+    }
+
+    compare(bench, "box", pts, [&](Points& p) {
+        min1 = RS_Vector(RS_MAXDOUBLE, RS_MAXDOUBLE);
+        max1 = RS_Vector(RS_MINDOUBLE, RS_MINDOUBLE);
+        for (size_t i=0; i<p.size(); ++i) {
+            min1 = RS_Vector::minimum(p[i], min1);
+            max1 = RS_Vector::maximum(boxMax[i], max1);
+        }
+    }, [&](Points& p) {
+        min2 = RS_Vector(RS_MAXDOUBLE, RS_MAXDOUBLE);
+        max2 = RS_Vector(RS_MINDOUBLE, RS_MINDOUBLE);
+        for (size_t i=0; i<p.size(); ++i) {
+            LC_VectorOps::extendBox(p[i], boxMax[i], min2, max2);
+        }
+    });
+    if (!same(min1, min2) || !same(max1, max2)) {
+        bench.fail("box: LC_VectorOps differs from RS_Vector");
+    }
+
+    compare(bench, "move", pts, [&](Points& p) {
+        for (RS_Vector& v: p) {
+            if (v.valid) {
+                v.move(offset);
+            }
+        }
+    }, [&](Points& p) {
+        LC_VectorOps::move(p.begin(), p.end(), offset);
+    });
+
+    compare(bench, "rotate", pts, [&](Points& p) {
+        for (RS_Vector& v: p) {
+            if (v.valid) {
+                v.rotate(center, angle);
+            }
+        }
+    }, [&](Points& p) {
+        LC_VectorOps::rotate(p.begin(), p.end(), center, angle);
+    });
+
+    compare(bench, "scale", pts, [&](Points& p) {
+        for (RS_Vector& v: p) {
+            if (v.valid) {
+                v.scale(center, factor);
+            }
+        }
+    }, [&](Points& p) {
+        LC_VectorOps::scale(p.begin(), p.end(), center, factor);
+    });
+
+    size_t closest1 = 0, closest2 = 0;
+    compare(bench, "closest", pts, [&](Points& p) {
+        double minDist = RS_MAXDOUBLE;
+        for (size_t i=0; i<p.size(); ++i) {
+            if (p[i].valid) {
+                double d = p[i].distanceTo(center);
+                if (d<minDist) {
+                    minDist = d;
+                    closest1 = i;
+                }
+            }
+        }
+    }, [&](Points& p) {
+        closest2 = LC_VectorOps::closest(p.begin(), p.end(), center) - p.begin();
+    });
+    if (closest1!=closest2) {
+        bench.fail("closest: LC_VectorOps differs from RS_Vector");
+    }
+}
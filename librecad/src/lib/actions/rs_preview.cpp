@@ -27,17 +27,117 @@
 
 #include "rs_preview.h"
 
+#include "rs_arc.h"
+#include "rs_circle.h"
+#include "rs_ellipse.h"
 #include "rs_entitycontainer.h"
 #include "rs_graphicview.h"
 #include "rs_information.h"
+#include "rs_line.h"
+#include "rs_painter.h"
+#include "rs_point.h"
 #include "rs_settings.h"
+#include "rs_solid.h"
+#include "lc_splinepoints.h"
+
+
+namespace {
+
+void addBorderToPath(QPainterPath& path, const RS_Vector& min, const RS_Vector& max) {
+    path.addRect(QRectF(QPointF(min.x, min.y), QPointF(max.x, max.y)));
+}
+
+/**
+ * Appends the outline of an atomic entity in world coordinates.
+ * Angles are negated as QPainterPath assumes a y-down coordinate system.
+ * Entities without an exact outline are represented by their border.
+ */
+void addAtomicToPath(QPainterPath& path, RS_Entity* e) {
+    switch (e->rtti()) {
+    case RS2::EntityLine: {
+        RS_Line* l = static_cast<RS_Line*>(e);
+        path.moveTo(l->getStartpoint().x, l->getStartpoint().y);
+        path.lineTo(l->getEndpoint().x, l->getEndpoint().y);
+        break;
+    }
+    case RS2::EntityArc: {
+        RS_Arc* a = static_cast<RS_Arc*>(e);
+        RS_Vector c = a->getCenter();
+        double r = a->getRadius();
+        QRectF rect(c.x-r, c.y-r, 2.*r, 2.*r);
+        double start = -RS_Math::rad2deg(a->getAngle1());
+        double sweep = RS_Math::rad2deg(a->getAngleLength());
+        path.arcMoveTo(rect, start);
+        path.arcTo(rect, start, a->isReversed() ? sweep : -sweep);
+        break;
+    }
+    case RS2::EntityCircle: {
+        RS_Circle* ci = static_cast<RS_Circle*>(e);
+        RS_Vector c = ci->getCenter();
+        path.addEllipse(QPointF(c.x, c.y), ci->getRadius(), ci->getRadius());
+        break;
+    }
+    case RS2::EntityEllipse: {
+        RS_Ellipse* el = static_cast<RS_Ellipse*>(e);
+        double ra = el->getMajorRadius();
+        double rb = ra*el->getRatio();
+        QRectF rect(-ra, -rb, 2.*ra, 2.*rb);
+        QPainterPath local;
+        if (el->isArc()) {
+            double start = -RS_Math::rad2deg(el->getAngle1());
+            double sweep = RS_Math::rad2deg(el->getAngleLength());
+            local.arcMoveTo(rect, start);
+            local.arcTo(rect, start, el->isReversed() ? sweep : -sweep);
+        } else {
+            local.addEllipse(rect);
+        }
+        QTransform t;
+        t.translate(el->getCenter().x, el->getCenter().y);
+        t.rotate(RS_Math::rad2deg(el->getAngle()));
+        path.addPath(t.map(local));
+        break;
+    }
+    case RS2::EntityPoint: {
+        RS_Vector p = static_cast<RS_Point*>(e)->getPos();
+        path.moveTo(p.x, p.y);
+        path.lineTo(p.x, p.y);
+        break;
+    }
+    case RS2::EntitySolid: {
+        RS_Solid* so = static_cast<RS_Solid*>(e);
+        int corners = so->isTriangle() ? 3 : 4;
+        path.moveTo(so->getCorner(0).x, so->getCorner(0).y);
+        for (int i=1; i<corners; ++i) {
+            path.lineTo(so->getCorner(i).x, so->getCorner(i).y);
+        }
+        path.closeSubpath();
+        break;
+    }
+    case RS2::EntitySplinePoints: {
+        QList<RS_Vector> points = static_cast<LC_SplinePoints*>(e)->getStrokePoints();
+        if (!points.isEmpty()) {
+            path.moveTo(points.first().x, points.first().y);
+            for (int i=1; i<points.size(); ++i) {
+                path.lineTo(points.at(i).x, points.at(i).y);
+            }
+        }
+        break;
+    }
+    default:
+        addBorderToPath(path, e->getMin(), e->getMax());
+        break;
+    }
+}
+
+}
 
 
 /**
  * Constructor.
  */
 RS_Preview::RS_Preview(RS_EntityContainer* parent)
-        : RS_EntityContainer(parent) {
+        : RS_EntityContainer(parent),
+          captured(false) {
 
     RS_SETTINGS->beginGroup("/Appearance");
     maxEntities = RS_SETTINGS->readNumEntry("/MaxPreview", 100);
@@ -165,18 +265,15 @@ void RS_Preview::addAllFrom(RS_EntityContainer& container) {
  */
 void RS_Preview::addSelectionFrom(RS_EntityContainer& container) {
     int c=0;
-    for (RS_Entity* e=container.firstEntity();
-            e!=NULL; e=container.nextEntity()) {
-
-        if (e->isSelected() && c<maxEntities) {
-            RS_Entity* clone = e->clone();
-            clone->setSelected(false);
-            clone->reparent(this);
-
-            c+=clone->countDeep();
-            addEntity(clone);
-            // clone might be NULL after this point
-        }
+    QList<RS_Entity*> selection = container.getSelection();
+    for (int i=0; i<selection.size() && c<maxEntities; ++i) {
+        RS_Entity* clone = selection.at(i)->clone();
+        clone->setSelected(false);
+        clone->reparent(this);
+
+        c+=clone->countDeep();
+        addEntity(clone);
+        // clone might be NULL after this point
     }
 }
 
@@ -212,3 +309,160 @@ void RS_Preview::addStretchablesFrom(RS_EntityContainer& container,
 }
 
 
+
+/**
+ * Captures the outline of all selected entities from 'container' once.
+ * Live previews of move, rotate and mirror operations then only update
+ * the transformation instead of cloning the selection on every mouse move.
+ * Beyond maxEntities the remaining selection is shown as its border.
+ */
+void RS_Preview::captureSelectionFrom(RS_EntityContainer& container) {
+    capturedPath = QPainterPath();
+    transform.reset();
+    captured = true;
+
+    int c=0;
+    bool overflow = false;
+    RS_Vector min(RS_MAXDOUBLE, RS_MAXDOUBLE);
+    RS_Vector max(RS_MINDOUBLE, RS_MINDOUBLE);
+    QList<RS_Entity*> selection = container.getSelection();
+    for (int i=0; i<selection.size(); ++i) {
+        RS_Entity* e = selection.at(i);
+        if (e->isUndone()) {
+            continue;
+        }
+        if (c<maxEntities) {
+            capture(e, c);
+        } else {
+            overflow = true;
+            min = RS_Vector::minimum(min, e->getMin());
+            max = RS_Vector::maximum(max, e->getMax());
+        }
+    }
+    if (overflow) {
+        addBorderToPath(capturedPath, min, max);
+    }
+}
+
+
+
+/**
+ * Adds the outline of 'entity' to the captured path. Uses the same
+ * border rules as addEntity().
+ */
+void RS_Preview::capture(RS_Entity* entity, int& c) {
+    int n = entity->countDeep();
+    bool addBorder = false;
+
+    if (entity->rtti()==RS2::EntityImage || entity->rtti()==RS2::EntityHatch ||
+                entity->rtti()==RS2::EntityInsert) {
+        addBorder = true;
+    } else if (entity->isContainer() && entity->rtti()!=RS2::EntitySpline) {
+        addBorder = n > maxEntities-c;
+    }
+    c+=n;
+
+    if (addBorder) {
+        addBorderToPath(capturedPath, entity->getMin(), entity->getMax());
+    } else if (entity->isContainer()) {
+        RS_EntityContainer* ec = static_cast<RS_EntityContainer*>(entity);
+        for (RS_Entity* e=ec->firstEntity(RS2::ResolveAll);
+                e!=NULL; e=ec->nextEntity(RS2::ResolveAll)) {
+            addAtomicToPath(capturedPath, e);
+        }
+    } else {
+        addAtomicToPath(capturedPath, entity);
+    }
+}
+
+
+
+/**
+ * Drops the captured selection.
+ */
+void RS_Preview::releaseCapture() {
+    capturedPath = QPainterPath();
+    transform.reset();
+    captured = false;
+}
+
+
+
+/**
+ * Resets the transformation of the captured selection.
+ */
+void RS_Preview::resetTransform() {
+    transform.reset();
+}
+
+
+
+/**
+ * Moves the captured selection by the given offset.
+ */
+void RS_Preview::transformMove(const RS_Vector& offset) {
+    transform *= QTransform::fromTranslate(offset.x, offset.y);
+}
+
+
+
+/**
+ * Rotates the captured selection around the given center (angle in rad).
+ */
+void RS_Preview::transformRotate(const RS_Vector& center, double angle) {
+    QTransform t;
+    t.translate(center.x, center.y);
+    t.rotate(RS_Math::rad2deg(angle));
+    t.translate(-center.x, -center.y);
+    transform *= t;
+}
+
+
+
+/**
+ * Scales the captured selection around the given center.
+ */
+void RS_Preview::transformScale(const RS_Vector& center, const RS_Vector& factor) {
+    QTransform t;
+    t.translate(center.x, center.y);
+    t.scale(factor.x, factor.y);
+    t.translate(-center.x, -center.y);
+    transform *= t;
+}
+
+
+
+/**
+ * Mirrors the captured selection at the axis given by two points.
+ */
+void RS_Preview::transformMirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2) {
+    double angle = RS_Math::rad2deg((axisPoint2-axisPoint1).angle());
+    QTransform t;
+    t.translate(axisPoint1.x, axisPoint1.y);
+    t.rotate(angle);
+    t.scale(1., -1.);
+    t.rotate(-angle);
+    t.translate(-axisPoint1.x, -axisPoint1.y);
+    transform *= t;
+}
+
+
+
+/**
+ * Draws the captured selection through the current transformation,
+ * followed by all entities added to this preview.
+ */
+void RS_Preview::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset) {
+    if (painter==NULL || view==NULL) {
+        return;
+    }
+
+    if (captured && !capturedPath.isEmpty()) {
+        RS_Vector factor = view->getFactor();
+        QTransform toGui(factor.x, 0., 0., -factor.y,
+                         view->getOffsetX(), view->getHeight()-view->getOffsetY());
+        painter->drawTransformedPath(capturedPath, transform*toGui);
+    }
+
+    RS_EntityContainer::draw(painter, view, patternOffset);
+}
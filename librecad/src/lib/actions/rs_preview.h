@@ -29,6 +29,8 @@
 #define RS_PREVIEW_H
 
 #include "rs_entitycontainer.h"
+#include <QPainterPath>
+#include <QTransform>
 
 class RS_Entity;
 class RS_Vector;
@@ -55,8 +57,33 @@ public:
     virtual void addStretchablesFrom(RS_EntityContainer& container,
 	       const RS_Vector& v1, const RS_Vector& v2);
 
+    void captureSelectionFrom(RS_EntityContainer& container);
+    void releaseCapture();
+    /** @return true if a selection has been captured for transform-only preview. */
+    bool hasCapture() const {
+        return captured;
+    }
+    void resetTransform();
+    void transformMove(const RS_Vector& offset);
+    void transformRotate(const RS_Vector& center, double angle);
+    void transformScale(const RS_Vector& center, const RS_Vector& factor);
+    void transformMirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2);
+
+    virtual void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset);
+
 private:
+    void capture(RS_Entity* entity, int& c);
+
 	int maxEntities;
+    /**
+     * Outline of the captured selection in world coordinates. It is built
+     * once and drawn through 'transform' on every frame, so dragging
+     * does not clone or modify any entities.
+     */
+    QPainterPath capturedPath;
+    /** World space transformation applied to the captured outline. */
+    QTransform transform;
+    bool captured;
 };
 
 #endif
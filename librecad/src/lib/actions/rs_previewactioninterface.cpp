@@ -106,6 +106,9 @@ void RS_PreviewActionInterface::deletePreview() {
             preview->clear();
             hasPreview=false;
         }
+        if (preview!=NULL) {
+            preview->releaseCapture();
+        }
         graphicView->redraw(RS2::RedrawOverlay);
 }
 
@@ -32,6 +32,7 @@
 #include "rs_grid.h"
 #include "rs_settings.h"
 #include "rs_overlayline.h"
+#include "lc_profiler.h"
 
 /**
  * Constructor.
@@ -110,6 +111,7 @@ RS_Vector RS_Snapper::snapFree(QMouseEvent* e) {
  */
 RS_Vector RS_Snapper::snapPoint(QMouseEvent* e) {
         RS_DEBUG->print("RS_Snapper::snapPoint");
+    LC_PROFILE_SCOPE("snap");
 
     snapSpot = RS_Vector(false);
     RS_Vector t(false);
@@ -284,6 +286,7 @@ RS_Vector RS_Snapper::snapFree(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapEndpoint(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/endpoint");
     RS_Vector vec(false);
 
     vec = container->getNearestEndpoint(coord,
@@ -300,6 +303,7 @@ RS_Vector RS_Snapper::snapEndpoint(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapGrid(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/grid");
 
 //    RS_DEBUG->print("RS_Snapper::snapGrid begin");
 
@@ -318,6 +322,7 @@ RS_Vector RS_Snapper::snapGrid(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapOnEntity(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/on entity");
 
     RS_Vector vec(false);
     vec = container->getNearestPointOnEntity(coord, true, NULL, &keyEntity);
@@ -333,6 +338,7 @@ RS_Vector RS_Snapper::snapOnEntity(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapCenter(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/center");
     RS_Vector vec(false);
 
     vec = container->getNearestCenter(coord, NULL);
@@ -348,6 +354,7 @@ RS_Vector RS_Snapper::snapCenter(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapMiddle(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/middle");
 //std::cout<<"RS_Snapper::snapMiddle(): middlePoints="<<middlePoints<<std::endl;
     return container->getNearestMiddle(coord,static_cast<double *>(NULL),middlePoints);
 }
@@ -361,6 +368,7 @@ RS_Vector RS_Snapper::snapMiddle(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapDist(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/distance");
     RS_Vector vec;
 
 //std::cout<<" RS_Snapper::snapDist(RS_Vector coord): distance="<<distance<<std::endl;
@@ -379,6 +387,7 @@ RS_Vector RS_Snapper::snapDist(const RS_Vector& coord) {
  * @return The coordinates of the point or an invalid vector.
  */
 RS_Vector RS_Snapper::snapIntersection(const RS_Vector& coord) {
+    LC_PROFILE_SCOPE("snap/intersection");
     RS_Vector vec(false);
 
     vec = container->getNearestIntersection(coord,
@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include "lc_memoryreport.h"
+
+#include "lc_hyperbola.h"
+#include "lc_splinepoints.h"
+#include "rs_arc.h"
+#include "rs_block.h"
+#include "rs_circle.h"
+#include "rs_constructionline.h"
+#include "rs_dimaligned.h"
+#include "rs_dimangular.h"
+#include "rs_dimdiametric.h"
+#include "rs_dimlinear.h"
+#include "rs_dimradial.h"
+#include "rs_ellipse.h"
+#include "rs_fontchar.h"
+#include "rs_graphic.h"
+#include "rs_hatch.h"
+#include "rs_image.h"
+#include "rs_insert.h"
+#include "rs_leader.h"
+#include "rs_line.h"
+#include "rs_mtext.h"
+#include "rs_overlaybox.h"
+#include "rs_point.h"
+#include "rs_polyline.h"
+#include "rs_solid.h"
+#include "rs_spline.h"
+#include "rs_text.h"
+
+namespace {
+//! QList stores one pointer per item and large items in their own node
+template <class T>
+size_t listBytes(const QList<T>& list) {
+    return list.size() * (sizeof(void*) + (QTypeInfo<T>::isLarge ? sizeof(T) : 0));
+}
+}
+
+/**
+ * Collects the report for all entities in the given container,
+ * including the contents of sub containers (blocks inserts,
+ * dimensions, hatches, ...).
+ */
+LC_MemoryReport::LC_MemoryReport(RS_EntityContainer* container) {
+    if (container!=NULL) {
+        add(container);
+    }
+}
+
+
+
+void LC_MemoryReport::add(RS_Entity* e) {
+    Row& row = table[e->rtti()];
+    row.count++;
+    row.objectBytes += objectSize(e->rtti());
+    if (e->getFlag(RS2::FlagUserVars)) {
+        for (const QString& key: e->getAllKeys()) {
+            row.extraBytes += 2*sizeof(void*)
+                    + (key.size() + e->getUserDefVar(key).size())*sizeof(QChar);
+        }
+    }
+
+    switch (e->rtti()) {
+    case RS2::EntitySpline: {
+        RS_Spline* s = static_cast<RS_Spline*>(e);
+        row.extraBytes += listBytes(s->getData().controlPoints);
+        break;
+    }
+    case RS2::EntitySplinePoints: {
+        LC_SplinePointsData d = static_cast<LC_SplinePoints*>(e)->getData();
+        row.extraBytes += listBytes(d.splinePoints) + listBytes(d.controlPoints);
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (e->isContainer()) {
+        RS_EntityContainer* c = static_cast<RS_EntityContainer*>(e);
+        row.extraBytes += c->count()*sizeof(RS_Entity*);
+        for (int i=0; i<c->count(); ++i) {
+            RS_Entity* child = c->entityAt(i);
+            if (child!=NULL) {
+                add(child);
+            }
+        }
+    }
+}
+
+
+
+LC_MemoryReport::Row LC_MemoryReport::total() const {
+    Row sum;
+    for (const Row& r: table) {
+        sum.count += r.count;
+        sum.objectBytes += r.objectBytes;
+        sum.extraBytes += r.extraBytes;
+    }
+    return sum;
+}
+
+
+
+size_t LC_MemoryReport::objectSize(RS2::EntityType type) {
+    switch (type) {
+    case RS2::EntityContainer:
+        return sizeof(RS_EntityContainer);
+    case RS2::EntityBlock:
+        return sizeof(RS_Block);
+    case RS2::EntityFontChar:
+        return sizeof(RS_FontChar);
+    case RS2::EntityInsert:
+        return sizeof(RS_Insert);
+    case RS2::EntityGraphic:
+        return sizeof(RS_Graphic);
+    case RS2::EntityPoint:
+        return sizeof(RS_Point);
+    case RS2::EntityLine:
+        return sizeof(RS_Line);
+    case RS2::EntityPolyline:
+        return sizeof(RS_Polyline);
+    case RS2::EntityArc:
+        return sizeof(RS_Arc);
+    case RS2::EntityCircle:
+        return sizeof(RS_Circle);
+    case RS2::EntityEllipse:
+        return sizeof(RS_Ellipse);
+    case RS2::EntityHyperbola:
+        return sizeof(LC_Hyperbola);
+    case RS2::EntitySolid:
+        return sizeof(RS_Solid);
+    case RS2::EntityConstructionLine:
+        return sizeof(RS_ConstructionLine);
+    case RS2::EntityMText:
+        return sizeof(RS_MText);
+    case RS2::EntityText:
+        return sizeof(RS_Text);
+    case RS2::EntityDimAligned:
+        return sizeof(RS_DimAligned);
+    case RS2::EntityDimLinear:
+        return sizeof(RS_DimLinear);
+    case RS2::EntityDimRadial:
+        return sizeof(RS_DimRadial);
+    case RS2::EntityDimDiametric:
+        return sizeof(RS_DimDiametric);
+    case RS2::EntityDimAngular:
+        return sizeof(RS_DimAngular);
+    case RS2::EntityDimLeader:
+        return sizeof(RS_Leader);
+    case RS2::EntityHatch:
+        return sizeof(RS_Hatch);
+    case RS2::EntityImage:
+        return sizeof(RS_Image);
+    case RS2::EntitySpline:
+        return sizeof(RS_Spline);
+    case RS2::EntitySplinePoints:
+        return sizeof(LC_SplinePoints);
+    case RS2::EntityOverlayBox:
+        return sizeof(RS_OverlayBox);
+    default:
+        return sizeof(RS_EntityContainer);
+    }
+}
+
+
+
+const char* LC_MemoryReport::typeName(RS2::EntityType type) {
+    switch (type) {
+    case RS2::EntityContainer:       return "Container";
+    case RS2::EntityBlock:           return "Block";
+    case RS2::EntityFontChar:        return "FontChar";
+    case RS2::EntityInsert:          return "Insert";
+    case RS2::EntityGraphic:         return "Graphic";
+    case RS2::EntityPoint:           return "Point";
+    case RS2::EntityLine:            return "Line";
+    case RS2::EntityPolyline:        return "Polyline";
+    case RS2::EntityArc:             return "Arc";
+    case RS2::EntityCircle:          return "Circle";
+    case RS2::EntityEllipse:         return "Ellipse";
+    case RS2::EntityHyperbola:       return "Hyperbola";
+    case RS2::EntitySolid:           return "Solid";
+    case RS2::EntityConstructionLine: return "ConstructionLine";
+    case RS2::EntityMText:           return "MText";
+    case RS2::EntityText:            return "Text";
+    case RS2::EntityDimAligned:      return "DimAligned";
+    case RS2::EntityDimLinear:       return "DimLinear";
+    case RS2::EntityDimRadial:       return "DimRadial";
+    case RS2::EntityDimDiametric:    return "DimDiametric";
+    case RS2::EntityDimAngular:      return "DimAngular";
+    case RS2::EntityDimLeader:       return "Leader";
+    case RS2::EntityHatch:           return "Hatch";
+    case RS2::EntityImage:           return "Image";
+    case RS2::EntitySpline:          return "Spline";
+    case RS2::EntitySplinePoints:    return "SplinePoints";
+    case RS2::EntityOverlayBox:      return "OverlayBox";
+    case RS2::EntityPreview:         return "Preview";
+    default:                         return "Unknown";
+    }
+}
+
+
+
+/**
+ * Formats the report as a table, one line per entity type.
+ */
+QString LC_MemoryReport::toString() const {
+    QString ret = QString("%1%2%3%4%5%6\n")
+            .arg("type", -18).arg("count", 10).arg("sizeof", 8)
+            .arg("objects", 14).arg("extra", 12).arg("avg", 10);
+
+    auto printRow = [&ret](const char* name, size_t size, const Row& row) {
+        ret += QString("%1%2%3%4%5%6\n")
+                .arg(name, -18)
+                .arg((qulonglong)row.count, 10)
+                .arg((qulonglong)size, 8)
+                .arg((qulonglong)row.objectBytes, 14)
+                .arg((qulonglong)row.extraBytes, 12)
+                .arg((qulonglong)(row.count>0 ? (row.objectBytes+row.extraBytes)/row.count : 0), 10);
+    };
+
+    for (auto it=table.constBegin(); it!=table.constEnd(); ++it) {
+        printRow(typeName(it.key()), objectSize(it.key()), it.value());
+    }
+    printRow("total", 0, total());
+    ret += QString("entities with user variables: %1\n")
+            .arg(RS_Entity::countUserDefVarEntities());
+    return ret;
+}
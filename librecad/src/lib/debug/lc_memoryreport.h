@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_MEMORYREPORT_H
+#define LC_MEMORYREPORT_H
+
+#include <cstddef>
+#include <QMap>
+#include <QString>
+#include "rs.h"
+
+class RS_Entity;
+class RS_EntityContainer;
+
+/**
+ * Memory report for the entities of a drawing: number of entities and
+ * bytes used per entity type.
+ *
+ * Object bytes are the sizeof() of the entity classes. Extra bytes are
+ * an estimate of the heap memory owned by the entities (child lists of
+ * containers, spline point lists, user defined variables). Allocator
+ * overhead is not included.
+ *
+ * Usage:
+ * <pre>
+ *   LC_MemoryReport report(graphic);
+ *   RS_DEBUG->print("%s", report.toString().toLatin1().data());
+ * </pre>
+ */
+class LC_MemoryReport {
+public:
+    struct Row {
+        size_t count = 0;
+        size_t objectBytes = 0;
+        size_t extraBytes = 0;
+    };
+
+    explicit LC_MemoryReport(RS_EntityContainer* container);
+
+    const QMap<RS2::EntityType, Row>& rows() const {
+        return table;
+    }
+    /** @return Sum of all rows. */
+    Row total() const;
+
+    /** @return sizeof() of the class implementing the given entity type. */
+    static size_t objectSize(RS2::EntityType type);
+    static const char* typeName(RS2::EntityType type);
+
+    /** @return The report as a table, one line per entity type. */
+    QString toString() const;
+
+private:
+    void add(RS_Entity* e);
+
+    QMap<RS2::EntityType, Row> table;
+};
+
+#endif
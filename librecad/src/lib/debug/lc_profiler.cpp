@@ -0,0 +1,164 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include "lc_profiler.h"
+
+#include <algorithm>
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+
+std::atomic<bool> LC_Profiler::enabled(false);
+
+
+LC_Profiler::LC_Profiler()
+    : overlay(false) {
+    period.start();
+    if (!qgetenv("LIBRECAD_PROFILE").isEmpty()) {
+        setEnabled(true);
+    }
+}
+
+
+
+LC_Profiler* LC_Profiler::instance() {
+    static LC_Profiler* uniqueInstance = new LC_Profiler();
+    return uniqueInstance;
+}
+
+
+
+void LC_Profiler::setEnabled(bool on) {
+    enabled.store(on, std::memory_order_relaxed);
+}
+
+
+
+void LC_Profiler::addTime(const char* name, qint64 ns) {
+    // names are literals, no need to copy them
+    QByteArray key = QByteArray::fromRawData(name, qstrlen(name));
+    QMutexLocker lock(&mutex);
+    Entry& e = table[key];
+    ++e.calls;
+    e.totalNs += ns;
+    e.maxNs = qMax(e.maxNs, ns);
+}
+
+
+
+void LC_Profiler::addCount(const char* name, qint64 n) {
+    QByteArray key = QByteArray::fromRawData(name, qstrlen(name));
+    QMutexLocker lock(&mutex);
+    Entry& e = table[key];
+    ++e.calls;
+    e.value += n;
+}
+
+
+
+void LC_Profiler::addCount(const QByteArray& name, qint64 n) {
+    QMutexLocker lock(&mutex);
+    Entry& e = table[name];
+    ++e.calls;
+    e.value += n;
+}
+
+
+
+void LC_Profiler::reset() {
+    QMutexLocker lock(&mutex);
+    table.clear();
+    period.restart();
+}
+
+
+
+QHash<QString, LC_Profiler::Entry> LC_Profiler::entries() const {
+    QHash<QString, Entry> ret;
+    QMutexLocker lock(&mutex);
+    for (auto it=table.constBegin(); it!=table.constEnd(); ++it) {
+        ret.insert(QString::fromLatin1(it.key()), it.value());
+    }
+    return ret;
+}
+
+
+
+QStringList LC_Profiler::summary(int maxLines) const {
+    QHash<QString, Entry> all = entries();
+    QList<QString> names = all.keys();
+    std::sort(names.begin(), names.end(), [&all](const QString& a, const QString& b) {
+        return all.value(a).totalNs > all.value(b).totalNs;
+    });
+
+    QStringList ret;
+    for (const QString& n: names) {
+        const Entry& e = all[n];
+        if (e.totalNs==0) {
+            continue;
+        }
+        if (ret.size()>=maxLines) {
+            break;
+        }
+        ret << QString("%1: %2x  %3 ms avg  %4 ms max")
+               .arg(n).arg(e.calls)
+               .arg(e.totalNs*1e-6/e.calls, 0, 'f', 2)
+               .arg(e.maxNs*1e-6, 0, 'f', 2);
+    }
+    return ret;
+}
+
+
+
+bool LC_Profiler::dump(const QString& fileName) const {
+    QFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+    QHash<QString, Entry> all = entries();
+    QList<QString> names = all.keys();
+    std::sort(names.begin(), names.end());
+
+    QTextStream ts(&f);
+    ts << "# LibreCAD performance counters, "
+       << QDateTime::currentDateTime().toString(Qt::ISODate)
+       << ", collected over " << period.elapsed()/1000 << " s\n";
+    ts << "name\tcalls\ttotal_ms\tmean_ms\tmax_ms\tvalue\n";
+    for (const QString& n: names) {
+        const Entry& e = all[n];
+        ts << n << "\t" << e.calls;
+        if (e.totalNs>0) {
+            ts << "\t" << e.totalNs*1e-6
+               << "\t" << e.totalNs*1e-6/e.calls
+               << "\t" << e.maxNs*1e-6 << "\t";
+        } else {
+            ts << "\t\t\t\t" << e.value;
+        }
+        ts << "\n";
+    }
+    ts.flush();
+    return f.error()==QFile::NoError;
+}
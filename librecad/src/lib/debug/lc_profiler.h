@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_PROFILER_H
+#define LC_PROFILER_H
+
+#include <atomic>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+#define LC_PROFILER LC_Profiler::instance()
+
+#define LC_PROFILE_CONCAT2(a, b) a##b
+#define LC_PROFILE_CONCAT(a, b) LC_PROFILE_CONCAT2(a, b)
+
+/**
+ * Times the rest of the enclosing scope as "name", name must be a
+ * string literal.
+ */
+#define LC_PROFILE_SCOPE(name) \
+    LC_ScopedTimer LC_PROFILE_CONCAT(lc_profileScope, __LINE__)(name)
+
+/** Adds n to the counter "name", name must be a string literal. */
+#define LC_PROFILE_COUNT(name, n) \
+    do { \
+        if (LC_Profiler::isEnabled()) { \
+            LC_PROFILER->addCount(name, n); \
+        } \
+    } while (false)
+
+/**
+ * Timers and counters for the hot paths (painting, snapping, event
+ * dispatch, file I/O, hatch and insert updates), so slow drawings can
+ * be diagnosed on user machines.
+ *
+ * Instrumentation is always compiled in. While the profiler is
+ * disabled, which is the default, a timer costs one relaxed atomic
+ * load. It is enabled from the View menu, which also shows the
+ * results as overlay on the drawing, or at startup by setting the
+ * environment variable LIBRECAD_PROFILE.
+ *
+ * Timers are inclusive: a nested insert is part of the time of the
+ * insert containing it.
+ */
+class LC_Profiler {
+public:
+    struct Entry {
+        /** Number of timed calls, or of additions to a counter. */
+        qint64 calls = 0;
+        /** Total time of a timer in ns, 0 for counters. */
+        qint64 totalNs = 0;
+        /** Longest single call of a timer in ns. */
+        qint64 maxNs = 0;
+        /** Sum of a counter. */
+        qint64 value = 0;
+    };
+
+    static LC_Profiler* instance();
+
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    void setEnabled(bool on);
+
+    /** Whether graphic views show the summary() on top of the drawing. */
+    bool isOverlayVisible() const {
+        return overlay;
+    }
+    void setOverlayVisible(bool on) {
+        overlay = on;
+    }
+
+    void addTime(const char* name, qint64 ns);
+    void addCount(const char* name, qint64 n);
+    /** Like addCount(const char*, qint64) for names built at runtime. */
+    void addCount(const QByteArray& name, qint64 n);
+
+    /** Clears all timers and counters. */
+    void reset();
+
+    /** @return copy of all timers and counters by name. */
+    QHash<QString, Entry> entries() const;
+
+    /**
+     * @return one line per timer for the overlay, the maxLines
+     * timers with the most total time first.
+     */
+    QStringList summary(int maxLines) const;
+
+    /**
+     * Writes all timers and counters as tab separated text.
+     *
+     * @return false if the file could not be written.
+     */
+    bool dump(const QString& fileName) const;
+
+private:
+    LC_Profiler();
+
+    static std::atomic<bool> enabled;
+
+    mutable QMutex mutex;
+    QHash<QByteArray, Entry> table;
+    /** Time since the last reset. */
+    QElapsedTimer period;
+    bool overlay;
+};
+
+
+/**
+ * Adds the lifetime of the object to a timer of LC_Profiler, see
+ * LC_PROFILE_SCOPE.
+ */
+class LC_ScopedTimer {
+public:
+    explicit LC_ScopedTimer(const char* name)
+        : name(LC_Profiler::isEnabled() ? name : NULL) {
+        if (this->name!=NULL) {
+            timer.start();
+        }
+    }
+
+    ~LC_ScopedTimer() {
+        if (name!=NULL) {
+            LC_PROFILER->addTime(name, timer.nsecsElapsed());
+        }
+    }
+
+private:
+    LC_ScopedTimer(const LC_ScopedTimer&) = delete;
+    LC_ScopedTimer& operator = (const LC_ScopedTimer&) = delete;
+
+    const char* name;
+    QElapsedTimer timer;
+};
+
+#endif
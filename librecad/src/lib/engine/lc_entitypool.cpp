@@ -0,0 +1,164 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include <new>
+
+#include "lc_entitypool.h"
+
+namespace {
+size_t alignedSize(size_t size) {
+    const size_t a = alignof(std::max_align_t);
+    return (size + a - 1) / a * a;
+}
+}
+
+
+/**
+ * Constructor.
+ *
+ * @param objectSize Size of the objects managed by this pool.
+ * @param objectsPerChunk Number of objects allocated from the system
+ *        at once.
+ */
+LC_EntityPool::LC_EntityPool(size_t objectSize, size_t objectsPerChunk):
+    objectSize(objectSize),
+    slotSize(alignedSize(objectSize < sizeof(FreeNode) ? sizeof(FreeNode) : objectSize)),
+    chunkSize(slotSize * objectsPerChunk),
+    live(0)
+{
+}
+
+
+/**
+ * Destructor. Frees all memory of this pool, objects still allocated
+ * from this pool become invalid.
+ */
+LC_EntityPool::~LC_EntityPool() {
+    for (auto& c: chunks) {
+        ::operator delete(c.first);
+        delete c.second;
+    }
+}
+
+
+/**
+ * @return Memory for an object of the given size.
+ */
+void* LC_EntityPool::allocate(size_t size) {
+    if (size > objectSize) {
+        return ::operator new(size);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Chunk* c = available.empty() ? newChunk() : available.back();
+    void* p;
+    if (c->freeList!=NULL) {
+        p = c->freeList;
+        c->freeList = c->freeList->next;
+    } else {
+        p = c->next;
+        c->next += slotSize;
+    }
+    if (c->freeList==NULL && c->next==c->memory + chunkSize) {
+        setAvailable(c, false);
+    }
+    ++c->live;
+    ++live;
+    return p;
+}
+
+
+/**
+ * Gives the memory of an object back to the pool.
+ */
+void LC_EntityPool::deallocate(void* p, size_t size) {
+    if (p==NULL) {
+        return;
+    }
+    if (size > objectSize) {
+        ::operator delete(p);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // the chunk starting at or before p:
+    auto it = chunks.upper_bound(static_cast<char*>(p));
+    --it;
+    Chunk* c = it->second;
+    FreeNode* node = static_cast<FreeNode*>(p);
+    node->next = c->freeList;
+    c->freeList = node;
+    --live;
+    if (--c->live==0 && available.size()>1) {
+        releaseChunk(c);
+    } else {
+        setAvailable(c, true);
+    }
+}
+
+
+LC_EntityPool::Chunk* LC_EntityPool::newChunk() {
+    Chunk* c = new Chunk;
+    c->memory = static_cast<char*>(::operator new(chunkSize));
+    c->freeList = NULL;
+    c->next = c->memory;
+    c->live = 0;
+    c->available = -1;
+    chunks[c->memory] = c;
+    setAvailable(c, true);
+    return c;
+}
+
+
+/**
+ * Frees an empty chunk.
+ */
+void LC_EntityPool::releaseChunk(Chunk* chunk) {
+    setAvailable(chunk, false);
+    chunks.erase(chunk->memory);
+    ::operator delete(chunk->memory);
+    delete chunk;
+}
+
+
+/**
+ * Adds a chunk to or removes it from the chunks with free slots.
+ */
+void LC_EntityPool::setAvailable(Chunk* chunk, bool on) {
+    if (on==(chunk->available>=0)) {
+        return;
+    }
+    if (on) {
+        chunk->available = available.size();
+        available.push_back(chunk);
+    } else {
+        Chunk* last = available.back();
+        available[chunk->available] = last;
+        last->available = chunk->available;
+        available.pop_back();
+        chunk->available = -1;
+    }
+}
@@ -0,0 +1,133 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_ENTITYPOOL_H
+#define LC_ENTITYPOOL_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/**
+ * Fixed size object pool used for the most frequent entity types.
+ *
+ * Memory is taken from the system in chunks of many objects. Deleted
+ * objects go to the free list of their chunk and are reused by the next
+ * allocation. A chunk whose objects were all deleted is given back to
+ * the system at once, only one empty chunk is kept. Closing a drawing
+ * therefore frees the chunks filled by that drawing even while other
+ * drawings or the fonts still use the pool.
+ *
+ * Requests bigger than the object size of the pool (derived classes)
+ * are forwarded to the global operator new / delete.
+ *
+ * Use LC_POOL_ALLOCATED in the class declaration and
+ * LC_DEFINE_POOL_ALLOCATED in the implementation file to make a class
+ * use a pool.
+ */
+class LC_EntityPool {
+public:
+    LC_EntityPool(size_t objectSize, size_t objectsPerChunk = 1024);
+    ~LC_EntityPool();
+
+    void* allocate(size_t size);
+    void deallocate(void* p, size_t size);
+
+    /** @return Number of objects currently allocated from this pool. */
+    size_t count() const {
+        return live;
+    }
+    /** @return Number of bytes currently reserved by this pool. */
+    size_t reserved() const {
+        return chunks.size() * chunkSize;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct Chunk {
+        char* memory;
+        //! deleted objects of this chunk
+        FreeNode* freeList;
+        //! next never used slot
+        char* next;
+        //! objects allocated from this chunk
+        size_t live;
+        //! position in available, -1 if the chunk is full
+        int available;
+    };
+
+    Chunk* newChunk();
+    void releaseChunk(Chunk* chunk);
+    void setAvailable(Chunk* chunk, bool on);
+
+    size_t objectSize;
+    size_t slotSize;
+    size_t chunkSize;
+    //! all chunks by address
+    std::map<char*, Chunk*> chunks;
+    //! chunks with free slots
+    std::vector<Chunk*> available;
+    size_t live;
+    std::mutex mutex;
+};
+
+
+/**
+ * Declares class specific operator new / delete using a LC_EntityPool.
+ * Placement new is declared as well since it would be hidden otherwise
+ * (e.g. for QVector<RS_Line>).
+ */
+#define LC_POOL_ALLOCATED \
+public: \
+    static void* operator new(size_t size); \
+    static void operator delete(void* p, size_t size); \
+    static void* operator new(size_t, void* p) { return p; } \
+    static void operator delete(void*, void*) {} \
+    static LC_EntityPool& pool();
+
+
+/**
+ * Defines the operators declared by LC_POOL_ALLOCATED for the given class.
+ * The pool is never destroyed so entities may safely outlive static
+ * destruction.
+ */
+#define LC_DEFINE_POOL_ALLOCATED(Class) \
+LC_EntityPool& Class::pool() { \
+    static LC_EntityPool* p = new LC_EntityPool(sizeof(Class)); \
+    return *p; \
+} \
+void* Class::operator new(size_t size) { \
+    return pool().allocate(size); \
+} \
+void Class::operator delete(void* p, size_t size) { \
+    pool().deallocate(p, size); \
+}
+
+#endif
@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include <algorithm>
+#include <atomic>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include "lc_parallel.h"
+
+namespace {
+thread_local bool inParallelLoop = false;
+
+/**
+ * State shared by the threads of one loop, items are handed out one
+ * by one as they are expensive (a whole insert or dimension).
+ */
+struct Loop {
+    Loop(int count, const std::function<void(int)>& func)
+        : count(count), func(func), next(0) {}
+
+    void work() {
+        const bool wasInLoop = inParallelLoop;
+        inParallelLoop = true;
+        for (int i = next++; i < count; i = next++) {
+            func(i);
+        }
+        inParallelLoop = wasInLoop;
+    }
+
+    const int count;
+    const std::function<void(int)>& func;
+    std::atomic<int> next;
+    QSemaphore finished;
+};
+
+class LoopWorker : public QRunnable {
+public:
+    explicit LoopWorker(Loop& loop) : loop(loop) {}
+
+    virtual void run() {
+        loop.work();
+        loop.finished.release();
+    }
+
+private:
+    Loop& loop;
+};
+}
+
+
+
+void LC_Parallel::forEach(int count, const std::function<void(int)>& func) {
+    if (count<=0) {
+        return;
+    }
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    // the calling thread does its share too:
+    const int helpers = std::min(count, pool->maxThreadCount()) - 1;
+
+    if (helpers<=0 || inParallelLoop) {
+        for (int i=0; i<count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    Loop loop(count, func);
+    int started = 0;
+    for (; started<helpers; ++started) {
+        // don't wait for a busy pool, this thread works on instead:
+        LoopWorker* w = new LoopWorker(loop);
+        if (!pool->tryStart(w)) {
+            delete w;
+            break;
+        }
+    }
+    loop.work();
+    loop.finished.acquire(started);
+}
+
+
+
+bool LC_Parallel::inLoop() {
+    return inParallelLoop;
+}
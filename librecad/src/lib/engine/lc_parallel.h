@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+
+#ifndef LC_PARALLEL_H
+#define LC_PARALLEL_H
+
+#include <functional>
+
+/**
+ * Runs independent pieces of work on the global thread pool, used to
+ * regenerate inserts, dimensions and splines of large drawings.
+ *
+ * The work done in a parallel loop must not change objects shared
+ * with other items of the same loop. This is why entities which are
+ * updated inside a loop only mark their own borders as outdated and
+ * inserts don't update the inserts inside their block (the caller
+ * does this before, see RS_Insert::updateInserts()).
+ */
+class LC_Parallel {
+public:
+    /**
+     * Calls func(i) for i = 0 .. count-1 on all available cores,
+     * including the calling thread, and returns when all calls have
+     * finished. Calls are made in no particular order. Loops nested in
+     * another loop run serially.
+     */
+    static void forEach(int count, const std::function<void(int)>& func);
+
+    /**
+     * @return true while the calling thread executes the work of a
+     * parallel loop.
+     */
+    static bool inLoop();
+};
+
+#endif
@@ -30,6 +30,7 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #include "rs_graphic.h"
 #include "rs_painterqt.h"
 #include "lc_quadratic.h"
+#include "lc_vectorops.h"
 
 RS_Vector GetQuadPoint(const RS_Vector& x1,
 	const RS_Vector& c1, const RS_Vector& x2, double dt)
@@ -988,14 +989,8 @@ printf("getNearestDist\n");
 
 void LC_SplinePoints::move(const RS_Vector& offset)
 {
-	for(int i = 0; i < data.splinePoints.count(); i++)
-	{
-		data.splinePoints[i].move(offset);
-	}
-	for(int i = 0; i < data.controlPoints.count(); i++)
-	{
-		data.controlPoints[i].move(offset);
-	}
+	LC_VectorOps::move(data.splinePoints.begin(), data.splinePoints.end(), offset);
+	LC_VectorOps::move(data.controlPoints.begin(), data.controlPoints.end(), offset);
 	update();
 }
 
@@ -1006,27 +1001,19 @@ void LC_SplinePoints::rotate(const RS_Vector& center, const double& angle)
 
 void LC_SplinePoints::rotate(const RS_Vector& center, const RS_Vector& angleVector)
 {
-	for(int i = 0; i < data.splinePoints.count(); i++)
-	{
-		data.splinePoints[i].rotate(center, angleVector);
-	}
-	for(int i = 0; i < data.controlPoints.count(); i++)
-	{
-		data.controlPoints[i].rotate(center, angleVector);
-	}
+	LC_VectorOps::rotate(data.splinePoints.begin(), data.splinePoints.end(),
+		center, angleVector);
+	LC_VectorOps::rotate(data.controlPoints.begin(), data.controlPoints.end(),
+		center, angleVector);
 	update();
 }
 
 void LC_SplinePoints::scale(const RS_Vector& center, const RS_Vector& factor)
 {
-	for(int i = 0; i < data.splinePoints.count(); i++)
-	{
-		data.splinePoints[i].scale(center, factor);
-	}
-	for(int i = 0; i < data.controlPoints.count(); i++)
-	{
-		data.controlPoints[i].scale(center, factor);
-	}
+	LC_VectorOps::scale(data.splinePoints.begin(), data.splinePoints.end(),
+		center, factor);
+	LC_VectorOps::scale(data.controlPoints.begin(), data.controlPoints.end(),
+		center, factor);
 	update();
 }
 
@@ -1614,7 +1601,7 @@ void LC_SplinePoints::drawPattern(RS_Painter* painter, RS_GraphicView* view,
 	int n = data.controlPoints.count();
 	if(n < 2) return;
 
-	double dpmm = static_cast<RS_PainterQt*>(painter)->getDpmm();
+	double dpmm = view->getRenderContext(painter).dpmm;
 	double* ds = new double[pat->num];
 	for(int i = 0; i < pat->num; i++)
 	{
@@ -0,0 +1,348 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include <algorithm>
+#include <QPolygonF>
+
+#include "lc_textlayout.h"
+#include "rs_graphicview.h"
+#include "rs_line.h"
+#include "rs_math.h"
+#include "rs_painter.h"
+#include "lc_rendercontext.h"
+
+namespace {
+/**
+ * @return Distance from p to the segment a-b.
+ */
+double distanceToSegment(const RS_Vector& a, const RS_Vector& b,
+                         const RS_Vector& p) {
+    RS_Vector ab = b - a;
+    double l2 = ab.squared();
+    double t = l2<RS_TOLERANCE2 ? 0.0 : RS_Vector::dotP(p - a, ab)/l2;
+    t = std::max(0.0, std::min(1.0, t));
+    return p.distanceTo(a + ab*t);
+}
+}
+
+
+
+LC_TextLayout::LC_TextLayout()
+    : boxMin(0.0, 0.0),
+      boxMax(0.0, 0.0),
+      origin(0.0, 0.0),
+      factor(1.0, 1.0),
+      angle(0.0),
+      angleVector(1.0, 0.0) {
+}
+
+
+
+void LC_TextLayout::clear() {
+    glyphs.clear();
+    offsets.clear();
+    lines.clear();
+    boxMin = boxMax = RS_Vector(0.0, 0.0);
+    setTransform(RS_Vector(0.0, 0.0), RS_Vector(1.0, 1.0), 0.0);
+}
+
+
+
+/**
+ * Appends a glyph at the given offset.
+ *
+ * @param line Line of multi line texts, used to align lines separately.
+ */
+void LC_TextLayout::addGlyph(const LC_Glyph* glyph, const RS_Vector& offset,
+                             int line) {
+    if (glyph==NULL) {
+        return;
+    }
+    glyphs.push_back(glyph);
+    offsets.push_back(offset);
+    lines.push_back(line);
+}
+
+
+
+/**
+ * Gets the box around all glyphs or around the glyphs of one line,
+ * in layout units.
+ *
+ * @return false if there are no glyphs.
+ */
+bool LC_TextLayout::getBox(RS_Vector& vMin, RS_Vector& vMax, int line) const {
+    bool found = false;
+    for (size_t i=0; i<glyphs.size(); ++i) {
+        if (line>=0 && lines[i]!=line) {
+            continue;
+        }
+        RS_Vector gMin = offsets[i] + glyphs[i]->minV;
+        RS_Vector gMax = offsets[i] + glyphs[i]->maxV;
+        if (found) {
+            vMin = RS_Vector::minimum(vMin, gMin);
+            vMax = RS_Vector::maximum(vMax, gMax);
+        } else {
+            vMin = gMin;
+            vMax = gMax;
+            found = true;
+        }
+    }
+    return found;
+}
+
+
+
+/**
+ * Moves all glyphs or the glyphs of one line, in layout units.
+ */
+void LC_TextLayout::moveGlyphs(const RS_Vector& offset, int line) {
+    for (size_t i=0; i<offsets.size(); ++i) {
+        if (line<0 || lines[i]==line) {
+            offsets[i] += offset;
+        }
+    }
+}
+
+
+
+/**
+ * Keeps the box around all glyphs, used to skip texts outside the
+ * viewport when drawing. Called by the text entities once the glyphs
+ * are in place.
+ */
+void LC_TextLayout::updateBox() {
+    if (!getBox(boxMin, boxMax)) {
+        boxMin = boxMax = RS_Vector(0.0, 0.0);
+    }
+}
+
+
+
+/**
+ * Sets the mapping from layout units to drawing units: scaling by
+ * factor, then rotating by angle and moving to origin.
+ */
+void LC_TextLayout::setTransform(const RS_Vector& origin,
+                                 const RS_Vector& factor, double angle) {
+    this->origin = origin;
+    this->factor = factor;
+    this->angle = angle;
+    angleVector = RS_Vector(angle);
+}
+
+
+
+RS_Vector LC_TextLayout::toDrawing(const RS_Vector& p) const {
+    RS_Vector ret(p.x*factor.x, p.y*factor.y);
+    ret.rotate(angleVector);
+    return ret + origin;
+}
+
+
+
+void LC_TextLayout::move(const RS_Vector& offset) {
+    origin += offset;
+}
+
+
+
+void LC_TextLayout::rotate(const RS_Vector& center,
+                           const RS_Vector& angleVector) {
+    origin.rotate(center, angleVector);
+    angle = RS_Math::correctAngle(angle + angleVector.angle());
+    this->angleVector = RS_Vector(angle);
+}
+
+
+
+/**
+ * Extends vMin / vMax by the glyphs in drawing units. For rotated
+ * text the outlines are used, the rotated glyph boxes are too large.
+ */
+void LC_TextLayout::extendBorders(RS_Vector& vMin, RS_Vector& vMax) const {
+    const bool rotated = fabs(angleVector.y)>RS_TOLERANCE || angleVector.x<0.0;
+    for (size_t i=0; i<glyphs.size(); ++i) {
+        const LC_Glyph* g = glyphs[i];
+        if (!rotated) {
+            RS_Vector p1 = toDrawing(offsets[i] + g->minV);
+            RS_Vector p2 = toDrawing(offsets[i] + g->maxV);
+            vMin = RS_Vector::minimum(vMin, RS_Vector::minimum(p1, p2));
+            vMax = RS_Vector::maximum(vMax, RS_Vector::maximum(p1, p2));
+            continue;
+        }
+        for (const std::vector<RS_Vector>& s: g->strokes) {
+            for (const RS_Vector& p: s) {
+                RS_Vector v = toDrawing(offsets[i] + p);
+                vMin = RS_Vector::minimum(vMin, v);
+                vMax = RS_Vector::maximum(vMax, v);
+            }
+        }
+    }
+}
+
+
+
+/**
+ * @return Distance to the closest glyph outline in drawing units.
+ */
+double LC_TextLayout::getDistanceToPoint(const RS_Vector& coord) const {
+    double minDist = RS_MAXDOUBLE;
+    for (size_t i=0; i<glyphs.size(); ++i) {
+        const LC_Glyph* g = glyphs[i];
+
+        // glyphs whose box is further away than the closest outline:
+        RS_Vector c1 = toDrawing(offsets[i] + g->minV);
+        RS_Vector c2 = toDrawing(offsets[i] + RS_Vector(g->maxV.x, g->minV.y));
+        RS_Vector c3 = toDrawing(offsets[i] + g->maxV);
+        RS_Vector c4 = toDrawing(offsets[i] + RS_Vector(g->minV.x, g->maxV.y));
+        RS_Vector bMin = RS_Vector::minimum(RS_Vector::minimum(c1, c2),
+                                            RS_Vector::minimum(c3, c4));
+        RS_Vector bMax = RS_Vector::maximum(RS_Vector::maximum(c1, c2),
+                                            RS_Vector::maximum(c3, c4));
+        double dx = std::max(0.0, std::max(bMin.x-coord.x, coord.x-bMax.x));
+        double dy = std::max(0.0, std::max(bMin.y-coord.y, coord.y-bMax.y));
+        if (dx*dx + dy*dy>=minDist*minDist) {
+            continue;
+        }
+
+        for (const std::vector<RS_Vector>& s: g->strokes) {
+            RS_Vector prev = toDrawing(offsets[i] + s.front());
+            for (size_t k=1; k<s.size(); ++k) {
+                RS_Vector p = toDrawing(offsets[i] + s[k]);
+                minDist = std::min(minDist, distanceToSegment(prev, p, coord));
+                prev = p;
+            }
+        }
+    }
+    return minDist;
+}
+
+
+
+/**
+ * @return Number of atomic entities the letter inserts would have.
+ */
+unsigned LC_TextLayout::countDeep() const {
+    unsigned ret = 0;
+    for (const LC_Glyph* g: glyphs) {
+        ret += g->entities;
+    }
+    return ret;
+}
+
+
+
+/**
+ * Draws the glyph outlines with the pen already set on the painter.
+ * Solid outlines are drawn from the paths cached by the font, each
+ * glyph through the transformation of its offset, so texts share the
+ * outlines of their glyphs. Patterns and selection are drawn line by
+ * line like the letter entities were.
+ */
+void LC_TextLayout::draw(RS_Painter* painter, RS_GraphicView* view,
+                         const RS_Pen& pen, bool selected) const {
+    if (glyphs.empty()) {
+        return;
+    }
+
+    const LC_RenderContext& rc = view->getRenderContext(painter);
+
+    // layout units to screen, the mapping is affine:
+    const RS_Vector g0 = view->toGui(toDrawing(RS_Vector(0.0, 0.0)));
+    const RS_Vector gx = view->toGui(toDrawing(RS_Vector(1.0, 0.0))) - g0;
+    const RS_Vector gy = view->toGui(toDrawing(RS_Vector(0.0, 1.0))) - g0;
+
+    if (!selected && (pen.getLineType()==RS2::SolidLine ||
+                      view->getDrawingMode()==RS2::ModePreview)) {
+        if (!isBoxVisible(boxMin, boxMax, rc.viewportMin, rc.viewportMax)) {
+            return;
+        }
+        // the strokes are mapped here: glyphs are shared by all threads
+        // drawing, Qt paths of the font would be shared with them
+        QPolygonF points;
+        for (size_t i=0; i<glyphs.size(); ++i) {
+            const RS_Vector& o = offsets[i];
+            for (const std::vector<RS_Vector>& s: glyphs[i]->strokes) {
+                points.resize(s.size());
+                for (size_t k=0; k<s.size(); ++k) {
+                    const double x = o.x + s[k].x;
+                    const double y = o.y + s[k].y;
+                    points[k] = QPointF(g0.x + gx.x*x + gy.x*y,
+                                        g0.y + gx.y*x + gy.y*y);
+                }
+                painter->drawPolyline(points);
+            }
+        }
+        return;
+    }
+
+    RS_Line line(NULL, RS_LineData(RS_Vector(0.0, 0.0), RS_Vector(0.0, 0.0)));
+    line.setPen(pen);
+    if (selected) {
+        line.setFlag(RS2::FlagSelected);
+    }
+
+    for (size_t i=0; i<glyphs.size(); ++i) {
+        const LC_Glyph* g = glyphs[i];
+        const RS_Vector& o = offsets[i];
+        if (!isBoxVisible(o + g->minV, o + g->maxV,
+                          rc.viewportMin, rc.viewportMax)) {
+            continue;
+        }
+
+        for (const std::vector<RS_Vector>& s: g->strokes) {
+            double patternOffset(0.0);
+            RS_Vector prev = toDrawing(o + s.front());
+            for (size_t k=1; k<s.size(); ++k) {
+                RS_Vector p = toDrawing(o + s[k]);
+                line.setStartpoint(prev);
+                line.setEndpoint(p);
+                line.draw(painter, view, patternOffset);
+                prev = p;
+            }
+        }
+    }
+}
+
+
+
+/**
+ * @return true if the box given in layout units overlaps the
+ * viewport given in drawing units.
+ */
+bool LC_TextLayout::isBoxVisible(const RS_Vector& vMin, const RS_Vector& vMax,
+                                 const RS_Vector& viewportMin,
+                                 const RS_Vector& viewportMax) const {
+    RS_Vector c1 = toDrawing(vMin);
+    RS_Vector c2 = toDrawing(RS_Vector(vMax.x, vMin.y));
+    RS_Vector c3 = toDrawing(vMax);
+    RS_Vector c4 = toDrawing(RS_Vector(vMin.x, vMax.y));
+    return std::max(std::max(c1.x, c2.x), std::max(c3.x, c4.x))>=viewportMin.x &&
+            std::min(std::min(c1.x, c2.x), std::min(c3.x, c4.x))<=viewportMax.x &&
+            std::max(std::max(c1.y, c2.y), std::max(c3.y, c4.y))>=viewportMin.y &&
+            std::min(std::min(c1.y, c2.y), std::min(c3.y, c4.y))<=viewportMax.y;
+}
@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+
+#ifndef LC_TEXTLAYOUT_H
+#define LC_TEXTLAYOUT_H
+
+#include <vector>
+#include "rs_vector.h"
+
+class RS_Block;
+class RS_Font;
+class RS_GraphicView;
+class RS_Painter;
+class RS_Pen;
+
+/**
+ * Metrics and outline of one letter of a font, in font units (the
+ * letter height is 9). Glyphs are created by RS_Font::findGlyph() and
+ * live as long as their font.
+ */
+struct LC_Glyph {
+    /** Font this glyph belongs to. */
+    RS_Font* font;
+    /** Letter block, used to create letter inserts on demand. */
+    RS_Block* block;
+    /** Borders of the letter. */
+    RS_Vector minV;
+    RS_Vector maxV;
+    /** Number of atomic entities of the letter block. */
+    unsigned entities;
+    /** Outline as polylines, arcs are approximated by line segments. */
+    std::vector<std::vector<RS_Vector> > strokes;
+};
+
+
+
+/**
+ * Laid out text: one glyph and offset for every letter of a text.
+ *
+ * Offsets are in layout units, which are font units positioned and
+ * aligned by the text entity. One transformation (scale, rotation,
+ * insertion point) maps the whole layout to drawing units.
+ *
+ * Texts are drawn and measured from the layout. Letter inserts are
+ * only created from it when the entities of a text are needed.
+ */
+class LC_TextLayout {
+public:
+    LC_TextLayout();
+
+    void clear();
+    bool isEmpty() const {
+        return glyphs.empty();
+    }
+    size_t count() const {
+        return glyphs.size();
+    }
+
+    void addGlyph(const LC_Glyph* glyph, const RS_Vector& offset, int line=0);
+
+    const LC_Glyph* glyphAt(size_t i) const {
+        return glyphs[i];
+    }
+    const RS_Vector& offsetAt(size_t i) const {
+        return offsets[i];
+    }
+    int lineAt(size_t i) const {
+        return lines[i];
+    }
+
+    bool getBox(RS_Vector& vMin, RS_Vector& vMax, int line=-1) const;
+    void moveGlyphs(const RS_Vector& offset, int line=-1);
+    void updateBox();
+
+    void setTransform(const RS_Vector& origin, const RS_Vector& factor,
+                      double angle);
+    RS_Vector getFactor() const {
+        return factor;
+    }
+    double getAngle() const {
+        return angle;
+    }
+    RS_Vector toDrawing(const RS_Vector& p) const;
+
+    void move(const RS_Vector& offset);
+    void rotate(const RS_Vector& center, const RS_Vector& angleVector);
+
+    void extendBorders(RS_Vector& vMin, RS_Vector& vMax) const;
+    double getDistanceToPoint(const RS_Vector& coord) const;
+    unsigned countDeep() const;
+
+    void draw(RS_Painter* painter, RS_GraphicView* view,
+              const RS_Pen& pen, bool selected) const;
+
+private:
+    bool isBoxVisible(const RS_Vector& vMin, const RS_Vector& vMax,
+                      const RS_Vector& viewportMin,
+                      const RS_Vector& viewportMax) const;
+
+    std::vector<const LC_Glyph*> glyphs;
+    std::vector<RS_Vector> offsets;
+    std::vector<int> lines;
+    /** Box around all glyphs in layout units, see updateBox(). */
+    RS_Vector boxMin;
+    RS_Vector boxMax;
+
+    RS_Vector origin;
+    RS_Vector factor;
+    double angle;
+    /** cos / sin of angle */
+    RS_Vector angleVector;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_VECTOROPS_H
+#define LC_VECTOROPS_H
+
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LC_VECTOROPS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "rs_vector.h"
+
+/**
+ * Bulk operations on ranges of points.
+ *
+ * The operations work on any iterator range whose value type has
+ * adjacent double members x and y and a bool member valid, such as
+ * RS_Vector in both the 2D and the 3D build. x and y are processed
+ * together in one SSE2 register where available. Invalid points are
+ * skipped, like RS_VectorSolutions always did.
+ *
+ * The z coordinate is left alone except by move() and extendBox(),
+ * which call moveZ() and extendZ() for it (found by argument dependent
+ * lookup for other vector types).
+ */
+class LC_VectorOps {
+public:
+    /**
+     * Extends the box vMin / vMax by all valid points in the range.
+     * Only x and y of vMin / vMax are changed.
+     */
+    template <class It, class V>
+    static void extend(It first, It last, V& vMin, V& vMax) {
+#ifdef LC_VECTOROPS_SSE2
+        __m128d lo = load(vMin);
+        __m128d hi = load(vMax);
+        for (; first!=last; ++first) {
+            if (first->valid) {
+                const __m128d p = load(*first);
+                lo = _mm_min_pd(lo, p);
+                hi = _mm_max_pd(hi, p);
+            }
+        }
+        store(vMin, lo);
+        store(vMax, hi);
+#else
+        for (; first!=last; ++first) {
+            if (first->valid) {
+                if (first->x<vMin.x) vMin.x = first->x;
+                if (first->y<vMin.y) vMin.y = first->y;
+                if (first->x>vMax.x) vMax.x = first->x;
+                if (first->y>vMax.y) vMax.y = first->y;
+            }
+        }
+#endif
+    }
+
+    /**
+     * Extends the box vMin / vMax by the box bMin / bMax, with the
+     * results of RS_Vector::minimum() / maximum() (z included).
+     * Used for the borders of containers.
+     */
+    template <class V>
+    static void extendBox(const V& bMin, const V& bMax, V& vMin, V& vMax) {
+#ifdef LC_VECTOROPS_SSE2
+        // operand order as std::min(b, v) / std::max(b, v), also for NaN:
+        store(vMin, _mm_min_pd(load(vMin), load(bMin)));
+        store(vMax, _mm_max_pd(load(vMax), load(bMax)));
+#else
+        vMin.x = std::min(bMin.x, vMin.x);
+        vMin.y = std::min(bMin.y, vMin.y);
+        vMax.x = std::max(bMax.x, vMax.x);
+        vMax.y = std::max(bMax.y, vMax.y);
+#endif
+        extendZ(bMin, bMax, vMin, vMax);
+    }
+
+    /** Moves all valid points in the range by offset. */
+    template <class It, class V>
+    static void move(It first, It last, const V& offset) {
+#ifdef LC_VECTOROPS_SSE2
+        const __m128d o = load(offset);
+#endif
+        for (; first!=last; ++first) {
+            if (first->valid) {
+#ifdef LC_VECTOROPS_SSE2
+                store(*first, _mm_add_pd(load(*first), o));
+#else
+                first->x += offset.x;
+                first->y += offset.y;
+#endif
+                moveZ(*first, offset);
+            }
+        }
+    }
+
+    /**
+     * Rotates all valid points in the range around center. angleVector
+     * is the unit vector of the rotation angle (see RS_Vector::rotate).
+     */
+    template <class It, class V>
+    static void rotate(It first, It last, const V& center, const V& angleVector) {
+#ifdef LC_VECTOROPS_SSE2
+        const __m128d c = load(center);
+        // (cos, sin) and (-sin, cos): rotated = dx*a + dy*b
+        const __m128d a = _mm_set_pd(angleVector.y, angleVector.x);
+        const __m128d b = _mm_set_pd(angleVector.x, -angleVector.y);
+        for (; first!=last; ++first) {
+            if (first->valid) {
+                const __m128d d = _mm_sub_pd(load(*first), c);
+                const __m128d r = _mm_add_pd(_mm_mul_pd(_mm_unpacklo_pd(d, d), a),
+                                             _mm_mul_pd(_mm_unpackhi_pd(d, d), b));
+                store(*first, _mm_add_pd(r, c));
+            }
+        }
+#else
+        for (; first!=last; ++first) {
+            if (first->valid) {
+                const double dx = first->x - center.x;
+                const double dy = first->y - center.y;
+                first->x = center.x + dx*angleVector.x - dy*angleVector.y;
+                first->y = center.y + dx*angleVector.y + dy*angleVector.x;
+            }
+        }
+#endif
+    }
+
+    /** Scales all valid points in the range by factor with center as origin. */
+    template <class It, class V>
+    static void scale(It first, It last, const V& center, const V& factor) {
+#ifdef LC_VECTOROPS_SSE2
+        const __m128d c = load(center);
+        const __m128d f = load(factor);
+        for (; first!=last; ++first) {
+            if (first->valid) {
+                store(*first, _mm_add_pd(c, _mm_mul_pd(_mm_sub_pd(load(*first), c), f)));
+            }
+        }
+#else
+        for (; first!=last; ++first) {
+            if (first->valid) {
+                first->x = center.x + (first->x - center.x)*factor.x;
+                first->y = center.y + (first->y - center.y)*factor.y;
+            }
+        }
+#endif
+    }
+
+    /**
+     * @return The valid point in the range closest to coord or last
+     *  if there is none. squaredDist (if not NULL) receives the squared
+     *  distance of that point.
+     */
+    template <class It, class V>
+    static It closest(It first, It last, const V& coord, double* squaredDist = NULL) {
+        It ret = last;
+        double minDist = RS_MAXDOUBLE;
+#ifdef LC_VECTOROPS_SSE2
+        const __m128d c = load(coord);
+#endif
+        for (; first!=last; ++first) {
+            if (!first->valid) {
+                continue;
+            }
+#ifdef LC_VECTOROPS_SSE2
+            __m128d d = _mm_sub_pd(load(*first), c);
+            d = _mm_mul_pd(d, d);
+            const double dist = _mm_cvtsd_f64(_mm_add_sd(d, _mm_unpackhi_pd(d, d)));
+#else
+            const double dx = first->x - coord.x;
+            const double dy = first->y - coord.y;
+            const double dist = dx*dx + dy*dy;
+#endif
+            if (dist<minDist) {
+                minDist = dist;
+                ret = first;
+            }
+        }
+        if (squaredDist!=NULL) {
+            *squaredDist = minDist;
+        }
+        return ret;
+    }
+
+private:
+#ifdef LC_VECTOROPS_SSE2
+    template <class V>
+    static __m128d load(const V& v) {
+        return _mm_loadu_pd(&v.x);
+    }
+    template <class V>
+    static void store(V& v, __m128d r) {
+        _mm_storeu_pd(&v.x, r);
+    }
+#endif
+};
+
+
+static_assert(offsetof(RS_Vector, y) == offsetof(RS_Vector, x) + sizeof(double),
+              "LC_VectorOps loads x and y of RS_Vector as one pair");
+
+/** z of the 3D RS_Vector is moved along with x and y, as in RS_Vector::move(). */
+inline void moveZ(RS_Vector& v, const RS_Vector& offset) {
+#ifndef RS_VECTOR2D
+    v.z += offset.z;
+#else
+    Q_UNUSED(v);
+    Q_UNUSED(offset);
+#endif
+}
+
+/** z of the 3D RS_Vector is part of the box, as in RS_Vector::minimum(). */
+inline void extendZ(const RS_Vector& bMin, const RS_Vector& bMax,
+                    RS_Vector& vMin, RS_Vector& vMax) {
+#ifndef RS_VECTOR2D
+    vMin.z = std::min(bMin.z, vMin.z);
+    vMax.z = std::max(bMax.z, vMax.z);
+#else
+    Q_UNUSED(bMin);
+    Q_UNUSED(bMax);
+    Q_UNUSED(vMin);
+    Q_UNUSED(vMax);
+#endif
+}
+
+#endif
@@ -89,7 +89,15 @@ public:
         /** Endpoint selected */
         FlagSelected2   = 1<<13,
                 /** Entity is highlighted temporarily (as a user action feedback) */
-                FlagHighlighted = 1<<14
+                FlagHighlighted = 1<<14,
+        /** Entity is a top level entity of a document and tracked in its selection set */
+        FlagIndexed     = 1<<15,
+        /** Entity has user defined variables in the side table */
+        FlagUserVars    = 1<<16,
+        /** Borders of a container are outdated, see RS_EntityContainer::updateBorders() */
+        FlagBordersDirty = 1<<17,
+        /** Automatic update() of the entity is disabled */
+        FlagUpdateDisabled = 1<<18
     };
 
     /**
@@ -41,6 +41,9 @@
 #include "emu_c99.h"
 #endif
 
+LC_DEFINE_POOL_ALLOCATED(RS_Arc)
+
+
 /**
  * Default constructor.
  */
@@ -838,8 +841,9 @@ void RS_Arc::draw(RS_Painter* painter, RS_GraphicView* view,
                   double& patternOffset) {
 
     //only draw the visible portion of line
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_RenderContext& rc = view->getRenderContext(painter);
+    const RS_Vector& vpMin = rc.viewportMin;
+    const RS_Vector& vpMax = rc.viewportMax;
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
 
     RS_Vector vpStart(isReversed()?getEndpoint():getStartpoint());
@@ -959,7 +963,7 @@ void RS_Arc::drawVisible(RS_Painter* painter, RS_GraphicView* view,
     double ira=1./ra;
     int i(0);          // index counter
     if(pat->num>0) {
-        double dpmm=static_cast<RS_PainterQt*>(painter)->getDpmm();
+        double dpmm=view->getRenderContext(painter).dpmm;
         da.resize(pat->num);
         while(i<pat->num){
             //        da[j] = pat->pattern[i++] * styleFactor;
@@ -28,6 +28,7 @@
 #define RS_ARC_H
 
 #include "rs_atomicentity.h"
+#include "lc_entitypool.h"
 class LC_Quadratic;
 
 
@@ -88,6 +89,8 @@ public:
  * @author Andrew Mustun
  */
 class RS_Arc : public RS_AtomicEntity {
+    LC_POOL_ALLOCATED
+
 public:
     RS_Arc(RS_EntityContainer* parent,
            const RS_ArcData& d);
@@ -54,6 +54,7 @@ RS_BlockList::RS_BlockList(bool owner) {
  */
 void RS_BlockList::clear() {
     blocks.clear();
+    blockNames.clear();
     activeBlock = NULL;
 	setModified(true);
 }
@@ -108,6 +109,7 @@ bool RS_BlockList::add(RS_Block* block, bool notify) {
     RS_Block* b = find(block->getName());
     if (b==NULL) {
         blocks.append(block);
+        hashName(block);
 
         if (notify) {
             addNotification();
@@ -155,6 +157,7 @@ void RS_BlockList::remove(RS_Block* block) {
 #else
     blocks.removeOne(block);
 #endif
+    unhashName(block);
 
     for (int i=0; i<blockListListeners.size(); ++i) {
         RS_BlockListListener* l = blockListListeners.at(i);
@@ -189,7 +192,9 @@ void RS_BlockList::remove(RS_Block* block) {
 bool RS_BlockList::rename(RS_Block* block, const QString& name) {
 	if (block!=NULL) {
 		if (find(name)==NULL) {
+			unhashName(block);
 			block->setName(name);
+			hashName(block);
 			setModified(true);
 			return true;
 		}
@@ -224,17 +229,17 @@ void RS_BlockList::editBlock(RS_Block* block, const RS_Block& source) {
  */
 RS_Block* RS_BlockList::find(const QString& name) {
     //RS_DEBUG->print("RS_BlockList::find");
-	RS_Block* ret = NULL;
-// Todo : reduce this from O(N) to O(log(N)) complexity based on sorted list or hash
-    for (int i=0; i<count(); ++i) {
-        RS_Block* b = at(i);
-        if (b->getName()==name) {
-            ret=b;
-			break;
+
+    // the index is case insensitive, the name itself has to match exactly:
+    const QString key = name.toLower();
+    QMultiHash<QString, RS_Block*>::const_iterator it = blockNames.constFind(key);
+    for (; it!=blockNames.constEnd() && it.key()==key; ++it) {
+        if (it.value()->getName()==name) {
+            return it.value();
         }
     }
 
-    return ret;
+    return NULL;
 }
 
 
@@ -354,6 +359,24 @@ void RS_BlockList::removeListener(RS_BlockListListener* listener) {
 
 
 
+/**
+ * Adds the given block to the name index.
+ */
+void RS_BlockList::hashName(RS_Block* block) {
+    blockNames.insert(block->getName().toLower(), block);
+}
+
+
+
+/**
+ * Removes the given block from the name index.
+ */
+void RS_BlockList::unhashName(RS_Block* block) {
+    blockNames.remove(block->getName().toLower(), block);
+}
+
+
+
 /**
  * Dumps the blocks to stdout.
  */
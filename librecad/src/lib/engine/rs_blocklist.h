@@ -30,6 +30,7 @@
 
 
 #include <QList>
+#include <QMultiHash>
 #include <QString>
 
 class RS_Block;
@@ -116,10 +117,15 @@ public:
     friend std::ostream& operator << (std::ostream& os, RS_BlockList& b);
 
 private:
+    void hashName(RS_Block* block);
+    void unhashName(RS_Block* block);
+
     //! Is the list owning the blocks?
     bool owner;
     //! Blocks in the graphic
     QList<RS_Block*> blocks;
+    //! blocks indexed by their lower case name for fast lookup by find()
+    QMultiHash<QString, RS_Block*> blockNames;
     //! List of registered BlockListListeners
     QList<RS_BlockListListener*> blockListListeners;
     //! Currently active block
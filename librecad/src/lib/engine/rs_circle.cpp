@@ -41,6 +41,9 @@
 
 
 
+LC_DEFINE_POOL_ALLOCATED(RS_Circle)
+
+
 /**
  * Default constructor.
  */
@@ -727,8 +730,9 @@ void RS_Circle::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
 bool RS_Circle::isVisibleInWindow(RS_GraphicView* view) const
 {
 
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_RenderContext& rc = view->getRenderContext(NULL);
+    const RS_Vector& vpMin = rc.viewportMin;
+    const RS_Vector& vpMax = rc.viewportMax;
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
     QVector<RS_Vector> vps;
     for(unsigned short i=0;i<4;i++){
@@ -32,6 +32,7 @@
 #include <QList>
 #include <QVector>
 #include "rs_atomicentity.h"
+#include "lc_entitypool.h"
 
 class LC_Quadratic;
 
@@ -81,6 +82,8 @@ public:
  * @author Andrew Mustun
  */
 class RS_Circle : public RS_AtomicEntity {
+    LC_POOL_ALLOCATED
+
 public:
     RS_Circle (RS_EntityContainer* parent,
                const RS_CircleData& d);
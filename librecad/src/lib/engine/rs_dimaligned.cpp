@@ -218,7 +218,7 @@ void RS_DimAligned::stretch(const RS_Vector& firstCorner,
                             const RS_Vector& secondCorner,
                             const RS_Vector& offset) {
 
-    //e->calculateBorders();
+    updateBorders();
     if (getMin().isInWindow(firstCorner, secondCorner) &&
             getMax().isInWindow(firstCorner, secondCorner)) {
 
@@ -255,7 +255,7 @@ void RS_DimAligned::stretch(const RS_Vector& firstCorner,
                 v.setPolar(len, ang2);
                 data.definitionPoint = edata.extensionPoint2 + v;
         }
-        updateDim(true);
+        invalidateDim(true);
 }
 
 
@@ -278,11 +278,11 @@ void RS_DimAligned::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
                 RS_Vector v;
                 v.setPolar(d, a);
         data.definitionPoint = edata.extensionPoint2 + v;
-                updateDim(true);
+                invalidateDim(true);
     }
         else if (ref.distanceTo(data.middleOfText)<1.0e-4) {
         data.middleOfText.move(offset);
-                updateDim(false);
+                invalidateDim(false);
     }
         else if (ref.distanceTo(edata.extensionPoint1)<1.0e-4) {
                 double a1 = edata.extensionPoint2.angleTo(edata.extensionPoint1);
@@ -293,7 +293,7 @@ void RS_DimAligned::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
                 if (fabs(d1)>1.0e-4) {
                         scale(edata.extensionPoint2, RS_Vector(d2/d1, d2/d1));
                 }
-                updateDim(true);
+                invalidateDim(true);
     }
         else if (ref.distanceTo(edata.extensionPoint2)<1.0e-4) {
                 double a1 = edata.extensionPoint1.angleTo(edata.extensionPoint2);
@@ -304,7 +304,7 @@ void RS_DimAligned::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
                 if (fabs(d1)>1.0e-4) {
                         scale(edata.extensionPoint1, RS_Vector(d2/d1, d2/d1));
                 }
-                updateDim(true);
+                invalidateDim(true);
     }
 }
 
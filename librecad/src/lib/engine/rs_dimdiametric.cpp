@@ -157,7 +157,7 @@ void RS_DimDiametric::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
                 v.setPolar(d, a);
         edata.definitionPoint = c + v;
                 data.definitionPoint = c - v;
-                updateDim(true);
+                invalidateDim(true);
     }
     else if (ref.distanceTo(data.definitionPoint)<1.0e-4) {
                 RS_Vector c = (edata.definitionPoint + data.definitionPoint)/2.0;
@@ -168,11 +168,11 @@ void RS_DimDiametric::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
                 v.setPolar(d, a);
         data.definitionPoint = c + v;
                 edata.definitionPoint = c - v;
-                updateDim(true);
+                invalidateDim(true);
     }
         else if (ref.distanceTo(data.middleOfText)<1.0e-4) {
         data.middleOfText.move(offset);
-                updateDim(false);
+                invalidateDim(false);
     }
 }
 
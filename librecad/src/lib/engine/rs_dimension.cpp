@@ -29,13 +29,161 @@
 #include "rs_dimension.h"
 #include "rs_solid.h"
 #include "rs_units.h"
+#include "rs_graphic.h"
+#include "lc_parallel.h"
+#include "lc_profiler.h"
+
+namespace {
+/** Variables added by the getters below, with default in mm and DXF code. */
+struct DimVariable {
+    const char* key;
+    double defMM;
+    int code;
+};
+
+const DimVariable dimVariables[] = {
+    {"$DIMLFAC", 1.0, 40},
+    {"$DIMSCALE", 1.0, 40},
+    {"$DIMASZ", 2.5, 40},
+    {"$DIMTSZ", 0., 40},
+    {"$DIMEXE", 1.25, 40},
+    {"$DIMEXO", 0.625, 40},
+    {"$DIMGAP", 0.625, 40},
+    {"$DIMTXT", 2.5, 40}
+};
+}
 
 /**
  * Constructor.
  */
 RS_Dimension::RS_Dimension(RS_EntityContainer* parent,
                            const RS_DimensionData& d)
-        : RS_EntityContainer(parent), data(d) {
+        : RS_EntityContainer(parent), data(d),
+          dimPending(false), dimPendingAutoText(false) {
+}
+
+
+
+/**
+ * Marks the sub entities as outdated. Creating them for every
+ * dimension of a drawing on import or when the dimension variables
+ * change is expensive, so they are only created when the dimension is
+ * drawn, its borders are queried or its sub entities are traversed.
+ *
+ * @param autoText Automatically reposition the text label.
+ */
+void RS_Dimension::invalidateDim(bool autoText) {
+    dimPendingAutoText = autoText || dimPendingAutoText;
+    dimPending = true;
+    invalidateBorders();
+}
+
+
+
+/**
+ * Creates the sub entities if they were marked as outdated.
+ */
+void RS_Dimension::updateDimIfNeeded() const {
+    if (!dimPending) {
+        return;
+    }
+    LC_PROFILE_SCOPE("dimension/update");
+    bool autoText = dimPendingAutoText;
+    dimPending = false;
+    dimPendingAutoText = false;
+    const_cast<RS_Dimension*>(this)->updateDim(autoText);
+}
+
+
+
+/**
+ * Creates the sub entities of the given dimensions on all available
+ * cores, e.g. to regenerate all dimensions of a drawing.
+ *
+ * @param autoText Automatically reposition the text labels.
+ */
+void RS_Dimension::updateDims(const std::vector<RS_Dimension*>& dims,
+                              bool autoText) {
+    if (dims.empty()) {
+        return;
+    }
+    LC_PROFILE_SCOPE("dimension/updateAll");
+
+    addMissingVariables(dims.front()->getGraphic());
+    // marks the shared parents, the workers only touch the dimensions:
+    for (RS_Dimension* d: dims) {
+        d->invalidateDim(autoText);
+    }
+    LC_Parallel::forEach(dims.size(), [&dims](int i) {
+        dims[i]->updateDimIfNeeded();
+    });
+}
+
+
+
+/**
+ * Adds the dimension variables which are missing in graphic with
+ * their defaults. The getters add them on first use otherwise, which
+ * must not happen while dimensions are created in parallel.
+ */
+void RS_Dimension::addMissingVariables(RS_Graphic* graphic) {
+    if (graphic==NULL) {
+        return;
+    }
+    for (const DimVariable& v: dimVariables) {
+        if (graphic->getVariableDouble(v.key, RS_MINDOUBLE)<=RS_MINDOUBLE) {
+            graphic->addVariable(v.key,
+                                 RS_Units::convert(v.defMM, RS2::Millimeter,
+                                                   graphic->getUnit()),
+                                 v.code);
+        }
+    }
+    // see getAlignText():
+    if (graphic->getVariableInt("$DIMTIH", 2)>1) {
+        graphic->addVariable("$DIMTIH", 0, 70);
+    }
+}
+
+
+
+RS_Entity* RS_Dimension::firstEntity(RS2::ResolveLevel level) {
+    updateDimIfNeeded();
+    return RS_EntityContainer::firstEntity(level);
+}
+
+
+
+RS_Entity* RS_Dimension::lastEntity(RS2::ResolveLevel level) {
+    updateDimIfNeeded();
+    return RS_EntityContainer::lastEntity(level);
+}
+
+
+
+RS_Entity* RS_Dimension::entityAt(int index) {
+    updateDimIfNeeded();
+    return RS_EntityContainer::entityAt(index);
+}
+
+
+
+bool RS_Dimension::isEmpty() {
+    updateDimIfNeeded();
+    return RS_EntityContainer::isEmpty();
+}
+
+
+
+void RS_Dimension::calculateBorders() {
+    updateDimIfNeeded();
+    RS_EntityContainer::calculateBorders();
+}
+
+
+
+void RS_Dimension::forcedCalculateBorders() {
+    updateDimIfNeeded();
+    RS_EntityContainer::forcedCalculateBorders();
 }
 
 
@@ -28,6 +28,8 @@
 #ifndef RS_DIMENSION_H
 #define RS_DIMENSION_H
 
+#include <vector>
+
 #include "rs_entitycontainer.h"
 #include "rs_mtext.h"
 
@@ -140,6 +142,10 @@ public:
 
     /** @return Copy of data that defines the dimension. */
     RS_DimensionData getData() const {
+        // the text position is set when the sub entities are created:
+        if (!data.middleOfText.valid || dimPendingAutoText) {
+            updateDimIfNeeded();
+        }
         return data;
     }
 
@@ -156,14 +162,31 @@ public:
     virtual QString getMeasuredLabel() = 0;
 
     /**
-     * Must be overwritten by implementing dimension entity class
-     * to update the subentities which make up the dimension entity.
+     * Marks the subentities which make up the dimension entity as
+     * outdated. They are created again when the dimension is drawn
+     * or queried next.
      */
     virtual void update() {
-            updateDim();
+            invalidateDim();
         }
 
+    /**
+     * Must be overwritten by implementing dimension entity class
+     * to update the subentities which make up the dimension entity.
+     */
     virtual void updateDim(bool autoText=false) = 0;
+    void invalidateDim(bool autoText=false);
+    void updateDimIfNeeded() const;
+    static void updateDims(const std::vector<RS_Dimension*>& dims,
+                           bool autoText=false);
+    static void addMissingVariables(RS_Graphic* graphic);
+
+    virtual RS_Entity* firstEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* lastEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* entityAt(int index);
+    virtual bool isEmpty();
+    virtual void calculateBorders();
+    virtual void forcedCalculateBorders();
 
     void updateCreateDimensionLine(const RS_Vector& p1, const RS_Vector& p2,
                   bool arrow1=true, bool arrow2=true, bool autoText=false);
@@ -173,6 +196,9 @@ public:
     }
 
     RS_Vector getMiddleOfText() {
+        if (!data.middleOfText.valid || dimPendingAutoText) {
+            updateDimIfNeeded();
+        }
         return data.middleOfText;
     }
 
@@ -229,6 +255,10 @@ public:
 protected:
     /** Data common to all dimension entities. */
     RS_DimensionData data;
+    /** Sub entities need to be created, see invalidateDim(). */
+    mutable bool dimPending;
+    /** Reposition the text label when creating the sub entities. */
+    mutable bool dimPendingAutoText;
 };
 
 #endif
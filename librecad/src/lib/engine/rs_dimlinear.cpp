@@ -254,7 +254,7 @@ void RS_DimLinear::stretch(const RS_Vector& firstCorner,
                            const RS_Vector& secondCorner,
                            const RS_Vector& offset) {
 
-    //e->calculateBorders();
+    updateBorders();
     if (getMin().isInWindow(firstCorner, secondCorner) &&
             getMax().isInWindow(firstCorner, secondCorner)) {
 
@@ -292,7 +292,7 @@ void RS_DimLinear::stretch(const RS_Vector& firstCorner,
         data.definitionPoint = edata.extensionPoint2 + v;
                 */
     }
-    updateDim(true);
+    invalidateDim(true);
 }
 
 
@@ -301,19 +301,19 @@ void RS_DimLinear::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
 
     if (ref.distanceTo(data.definitionPoint)<1.0e-4) {
         data.definitionPoint += offset;
-                updateDim(true);
+                invalidateDim(true);
     }
         else if (ref.distanceTo(data.middleOfText)<1.0e-4) {
         data.middleOfText += offset;
-                updateDim(false);
+                invalidateDim(false);
     }
         else if (ref.distanceTo(edata.extensionPoint1)<1.0e-4) {
         edata.extensionPoint1 += offset;
-                updateDim(true);
+                invalidateDim(true);
     }
         else if (ref.distanceTo(edata.extensionPoint2)<1.0e-4) {
         edata.extensionPoint2 += offset;
-                updateDim(true);
+                invalidateDim(true);
     }
 }
 
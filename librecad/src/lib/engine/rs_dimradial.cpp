@@ -258,11 +258,11 @@ void RS_DimRadial::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
                 RS_Vector v;
                 v.setPolar(d, a);
         edata.definitionPoint = data.definitionPoint + v;
-                updateDim(true);
+                invalidateDim(true);
     }
         else if (ref.distanceTo(data.middleOfText)<1.0e-4) {
         data.middleOfText.move(offset);
-                updateDim(false);
+                invalidateDim(false);
     }
 }
 
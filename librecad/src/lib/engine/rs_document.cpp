@@ -48,3 +48,178 @@ RS_Document::RS_Document(RS_EntityContainer* parent)
 
     gv = NULL;//used to read/save current view
 }
+
+
+
+RS_Document::~RS_Document() {
+    // entities deleted by the base class no longer see a document parent:
+    selection.clear();
+    foreignEntities.clear();
+}
+
+
+
+/**
+ * Marks a top level entity as part of this document and adds it to the
+ * selection set if it is selected. Entities with a different parent
+ * cannot report selection changes, they are kept in foreignEntities.
+ */
+void RS_Document::indexEntity(RS_Entity* entity) {
+    if (entity==NULL) {
+        return;
+    }
+    if (entity->getParent()!=this) {
+        foreignEntities.insert(entity);
+        return;
+    }
+    entity->setFlag(RS2::FlagIndexed);
+    if (entity->isSelected()) {
+        selection.insert(entity);
+    }
+}
+
+
+
+void RS_Document::unindexEntity(RS_Entity* entity) {
+    if (entity==NULL) {
+        return;
+    }
+    entity->delFlag(RS2::FlagIndexed);
+    selection.remove(entity);
+    foreignEntities.remove(entity);
+}
+
+
+
+/**
+ * Called by RS_Entity::setSelected for indexed entities.
+ */
+void RS_Document::updateSelection(RS_Entity* entity) {
+    if (entity->isSelected()) {
+        selection.insert(entity);
+    } else {
+        selection.remove(entity);
+    }
+}
+
+
+
+void RS_Document::addEntity(RS_Entity* entity) {
+    RS_EntityContainer::addEntity(entity);
+    indexEntity(entity);
+}
+
+
+
+void RS_Document::appendEntity(RS_Entity* entity) {
+    RS_EntityContainer::appendEntity(entity);
+    indexEntity(entity);
+}
+
+
+
+void RS_Document::prependEntity(RS_Entity* entity) {
+    RS_EntityContainer::prependEntity(entity);
+    indexEntity(entity);
+}
+
+
+
+void RS_Document::insertEntity(int index, RS_Entity* entity) {
+    RS_EntityContainer::insertEntity(index, entity);
+    indexEntity(entity);
+}
+
+
+
+void RS_Document::setEntityAt(int index, RS_Entity* en) {
+    // the replaced entity might be deleted by the container:
+    unindexEntity(entityAt(index));
+    RS_EntityContainer::setEntityAt(index, en);
+    indexEntity(en);
+}
+
+
+
+bool RS_Document::removeEntity(RS_Entity* entity) {
+    // the entity might be deleted by the container:
+    unindexEntity(entity);
+    return RS_EntityContainer::removeEntity(entity);
+}
+
+
+
+void RS_Document::clear() {
+    for (RS_Entity* e=firstEntity(RS2::ResolveNone);
+         e!=NULL;
+         e=nextEntity(RS2::ResolveNone)) {
+        e->delFlag(RS2::FlagIndexed);
+    }
+    selection.clear();
+    foreignEntities.clear();
+    RS_EntityContainer::clear();
+}
+
+
+
+/**
+ * Rebuilds the selection set for the deep copies of all entities.
+ */
+void RS_Document::detach() {
+    selection.clear();
+    foreignEntities.clear();
+    RS_EntityContainer::detach();
+    for (RS_Entity* e=firstEntity(RS2::ResolveNone);
+         e!=NULL;
+         e=nextEntity(RS2::ResolveNone)) {
+        indexEntity(e);
+    }
+}
+
+
+
+/**
+ * Counts the selected entities in this document.
+ */
+unsigned int RS_Document::countSelected() {
+    unsigned int c = selection.size();
+    foreach (RS_Entity* e, foreignEntities) {
+        if (e->isSelected() && !selection.contains(e)) {
+            c++;
+        }
+    }
+    return c;
+}
+
+
+
+/**
+ * @return The selected top level entities in no particular order.
+ */
+QList<RS_Entity*> RS_Document::getSelection() {
+    QList<RS_Entity*> ret = selection.values();
+    foreach (RS_Entity* e, foreignEntities) {
+        if (e->isSelected() && !selection.contains(e)) {
+            ret.append(e);
+        }
+    }
+    return ret;
+}
+
+
+
+/**
+ * @return Total length of all visible selected entities.
+ */
+double RS_Document::totalSelectedLength() {
+    double ret(0.0);
+    foreach (RS_Entity* e, getSelection()) {
+        if (e->isVisible()) {
+            double l = e->getLength();
+            if (l>=0.) {
+                ret += l;
+            }
+        }
+    }
+    return ret;
+}
@@ -28,6 +28,7 @@
 #ifndef RS_DOCUMENT_H
 #define RS_DOCUMENT_H
 
+#include <QSet>
 #include "rs_layerlist.h"
 #include "rs_entitycontainer.h"
 #include "rs_undo.h"
@@ -46,7 +47,7 @@ class RS_Document : public RS_EntityContainer,
     public RS_Undo {
 public:
     RS_Document(RS_EntityContainer* parent=NULL);
-    virtual ~RS_Document(){}
+    virtual ~RS_Document();
 
     virtual RS_LayerList* getLayerList() = 0;
     virtual RS_BlockList* getBlockList() = 0;
@@ -65,6 +66,20 @@ public:
         return true;
     }
 
+    virtual void addEntity(RS_Entity* entity);
+    virtual void appendEntity(RS_Entity* entity);
+    virtual void prependEntity(RS_Entity* entity);
+    virtual void insertEntity(int index, RS_Entity* entity);
+    virtual void setEntityAt(int index, RS_Entity* en);
+    virtual bool removeEntity(RS_Entity* entity);
+    virtual void clear();
+    virtual void detach();
+
+    virtual unsigned int countSelected();
+    virtual QList<RS_Entity*> getSelection();
+    virtual double totalSelectedLength();
+    void updateSelection(RS_Entity* entity);
+
     /**
      * Removes an entity from the entiy container. Implementation
      * from RS_Undo.
@@ -151,6 +166,23 @@ protected:
 	RS2::FormatType formatType;
     RS_GraphicView * gv;//used to read/save current view
 
+private:
+    void indexEntity(RS_Entity* entity);
+    void unindexEntity(RS_Entity* entity);
+
+    /**
+     * Selected top level entities of this document. Maintained by
+     * RS_Entity::setSelected and the entity list modifiers so that
+     * selection queries cost time proportional to the selection.
+     */
+    QSet<RS_Entity*> selection;
+    /**
+     * Entities in the list of this document whose parent is another
+     * container, e.g. the children of containers added by
+     * RS_Graphic::addEntity. They cannot report selection changes and
+     * are checked on every selection query.
+     */
+    QSet<RS_Entity*> foreignEntities;
 };
 
 
@@ -1414,8 +1414,9 @@ void RS_Ellipse::moveRef(const RS_Vector& ref, const RS_Vector& offset) {
 */
 bool RS_Ellipse::isVisibleInWindow(RS_GraphicView* view) const
 {
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_RenderContext& rc = view->getRenderContext(NULL);
+    const RS_Vector& vpMin = rc.viewportMin;
+    const RS_Vector& vpMax = rc.viewportMax;
     //viewport
     QRectF visualRect(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y);
     QPolygonF visualBox(visualRect);
@@ -1508,8 +1509,9 @@ void RS_Ellipse::draw(RS_Painter* painter, RS_GraphicView* view, double& pattern
         return;
     }
     //only draw the visible portion of line
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_RenderContext& rc = view->getRenderContext(painter);
+    const RS_Vector& vpMin = rc.viewportMin;
+    const RS_Vector& vpMax = rc.viewportMax;
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
 
     RS_Vector vpStart(isReversed()?getEndpoint():getStartpoint());
@@ -1622,7 +1624,7 @@ void RS_Ellipse::drawVisible(RS_Painter* painter, RS_GraphicView* view, double&
     int i(0),j(0);
     double* ds = new double[pat->num>0?pat->num:0];
     if(pat->num>0){
-        double dpmm=static_cast<RS_PainterQt*>(painter)->getDpmm();
+        double dpmm=view->getRenderContext(painter).dpmm;
         while( i<pat->num){
             ds[i]= dpmm * pat->pattern[i] ;//pattern length
             if(fabs(ds[i])<1.)
@@ -28,6 +28,7 @@
 
 #include "rs_entity.h"
 
+#include <atomic>
 #include <iostream>
 
 #include "rs_arc.h"
@@ -44,6 +45,7 @@
 #include "rs_text.h"
 #include "rs_information.h"
 #include "lc_quadratic.h"
+#include <QMutex>
 #include <QPolygon>
 
 /**
@@ -59,26 +61,82 @@ RS_Entity::RS_Entity(RS_EntityContainer* parent) {
 }
 
 
+namespace {
 /**
- * Copy constructor.
+ * User defined variables are rarely used, so they live in a side table
+ * keyed by entity instead of costing every entity an (empty) hash.
+ * Entities with an entry carry RS2::FlagUserVars.
  */
-/*RS_Entity::RS_Entity(const RS_Entity& e) : RS_Flags(e.getFlags()) {
-        cout << "copy constructor called\n";
-        init();
-        parent = e.parent;
-        layer = e.layer;
-        //setFlag(e.getFlags());
-    minV = e.minV;
-    maxV = e.maxV;
-    pen = e.pen;
-}*/
+typedef QMultiHash<QString, QString> VarList;
+
+// never destroyed, entities may outlive static destruction
+QHash<const RS_Entity*, VarList>& userVars() {
+    static QHash<const RS_Entity*, VarList>* table =
+            new QHash<const RS_Entity*, VarList>;
+    return *table;
+}
+
+QMutex& userVarsMutex() {
+    static QMutex* mutex = new QMutex;
+    return *mutex;
+}
+}
+
+/**
+ * Copy constructor. Copies the user defined variables along with the entity.
+ */
+RS_Entity::RS_Entity(const RS_Entity& e)
+    : RS_Undoable(e),
+      parent(e.parent),
+      minV(e.minV),
+      maxV(e.maxV),
+      layer(e.layer),
+      id(e.id),
+      pen(e.pen) {
+
+    if (getFlag(RS2::FlagUserVars)) {
+        QMutexLocker lock(&userVarsMutex());
+        userVars().insert(this, userVars().value(&e));
+    }
+}
 
 
 
 /**
  * Destructor.
  */
-RS_Entity::~RS_Entity() {}
+RS_Entity::~RS_Entity() {
+    if (getFlag(RS2::FlagUserVars)) {
+        QMutexLocker lock(&userVarsMutex());
+        userVars().remove(this);
+    }
+}
+
+
+
+RS_Entity& RS_Entity::operator = (const RS_Entity& e) {
+    if (this==&e) {
+        return *this;
+    }
+    bool hadVars = getFlag(RS2::FlagUserVars);
+    RS_Undoable::operator = (e);
+    parent = e.parent;
+    minV = e.minV;
+    maxV = e.maxV;
+    layer = e.layer;
+    id = e.id;
+    pen = e.pen;
+
+    if (hadVars || e.getFlag(RS2::FlagUserVars)) {
+        QMutexLocker lock(&userVarsMutex());
+        if (e.getFlag(RS2::FlagUserVars)) {
+            userVars().insert(this, userVars().value(&e));
+        } else {
+            userVars().remove(this);
+        }
+    }
+    return *this;
+}
 
 
 
@@ -91,7 +149,7 @@ void RS_Entity::init() {
     setFlag(RS2::FlagVisible);
     //layer = NULL;
     //pen = RS_Pen();
-        updateEnabled = true;
+    setUpdateEnabled(true);
     setLayerToActive();
     setPenToActive();
     initId();
@@ -101,8 +159,11 @@ void RS_Entity::init() {
  * Gives this entity a new unique id.
  */
 void RS_Entity::initId() {
-    static unsigned long int idCounter=0;
+    // entities are cloned concurrently by parallel insert updates:
+    static std::atomic<unsigned long int> idCounter(0);
     id = idCounter++;
+    // a new entity (or clone) is not yet part of any document:
+    delFlag(RS2::FlagIndexed);
 }
 
 /**
@@ -136,6 +197,11 @@ bool RS_Entity::setSelected(bool select) {
         delFlag(RS2::FlagSelected);
     }
 
+    // keep the selection set of the document up to date:
+    if (getFlag(RS2::FlagIndexed) && parent!=NULL && parent->isDocument()) {
+        static_cast<RS_Document*>(parent)->updateSelection(this);
+    }
+
     return true;
 }
 
@@ -249,8 +315,9 @@ bool RS_Entity::isInWindow(RS_Vector v1, RS_Vector v2) {
 /** whether the entity's bounding box intersects with visible portion of graphic view */
 bool RS_Entity::isVisibleInWindow(RS_GraphicView* view) const
 {
-    RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-    RS_Vector vpMax(view->toGraph(view->getWidth(),0));
+    const LC_RenderContext& rc = view->getRenderContext(NULL);
+    const RS_Vector& vpMin = rc.viewportMin;
+    const RS_Vector& vpMax = rc.viewportMax;
     if( getStartpoint().isInWindowOrdered(vpMin, vpMax) ) return true;
     if( getEndpoint().isInWindowOrdered(vpMin, vpMax) ) return true;
     QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
@@ -263,7 +330,7 @@ bool RS_Entity::isVisibleInWindow(RS_GraphicView* view) const
         RS_Line line(NULL,RS_LineData(vps.at(i),vps.at((i+1)%4)));
         if( RS_Information::getIntersection(const_cast<RS_Entity*>(this), &line, true).size()>0) return true;
     }
-    if( minV.isInWindowOrdered(vpMin,vpMax)||maxV.isInWindowOrdered(vpMin,vpMax)) return true;
+    if( getMin().isInWindowOrdered(vpMin,vpMax)||getMax().isInWindowOrdered(vpMin,vpMax)) return true;
     return false;
 }
 
@@ -814,42 +881,33 @@ double RS_Entity::getStyleFactor(RS_GraphicView* view) {
     double styleFactor = 1.0;
 
     if (view!=NULL) {
-        if (view->isPrinting()==false && view->isDraftMode()) {
-            styleFactor = 1.0/view->getFactor().x;
+        // unit factor, paper scale and view modes are resolved once per frame:
+        const LC_RenderContext& rc = view->getRenderContext(NULL);
+        if (rc.printing==false && rc.draftMode) {
+            styleFactor = 1.0/rc.factor.x;
         } else {
-            //styleFactor = getStyleFactor();
             // the factor caused by the unit:
-            RS2::Unit unit = RS2::None;
-            RS_Graphic* g = getGraphic();
-            if (g!=NULL) {
-                unit = g->getUnit();
-                //double scale = g->getPaperScale();
-                styleFactor = RS_Units::convert(1.0, RS2::Millimeter, unit);
-                // / scale;
-            }
+            styleFactor = rc.unitFactor;
 
             // the factor caused by the line width:
-            if (((int)getPen(true).getWidth())>0) {
-                styleFactor *= ((double)getPen(true).getWidth()/100.0);
-            } else if (((int)getPen(true).getWidth())==0) {
+            int w = (int)getPen(true).getWidth();
+            if (w>0) {
+                styleFactor *= ((double)w/100.0);
+            } else if (w==0) {
                 styleFactor *= 0.01;
             }
         }
 
-        if (view->isPrinting() || view->isPrintPreview() || view->isDraftMode()==false) {
-            RS_Graphic* graphic = getGraphic();
-            if (graphic!=NULL && graphic->getPaperScale()>1.0e-6) {
-                styleFactor /= graphic->getPaperScale();
+        if (rc.printing || rc.printPreview || rc.draftMode==false) {
+            if (rc.paperScale>1.0e-6) {
+                styleFactor /= rc.paperScale;
             }
         }
-    }
 
-        //RS_DEBUG->print("stylefactor: %f", styleFactor);
-        //RS_DEBUG->print("viewfactor: %f", view->getFactor().x);
-
-        if (styleFactor*view->getFactor().x<0.2) {
-                styleFactor = -1.0;
+        if (styleFactor*rc.factor.x<0.2) {
+            styleFactor = -1.0;
         }
+    }
 
     return styleFactor;
 }
@@ -859,7 +917,11 @@ double RS_Entity::getStyleFactor(RS_GraphicView* view) {
  * @return User defined variable connected to this entity or NULL if not found.
  */
 QString RS_Entity::getUserDefVar(const QString& key) const {
-    return varList.value(key, NULL);
+    if (!getFlag(RS2::FlagUserVars)) {
+        return QString();
+    }
+    QMutexLocker lock(&userVarsMutex());
+    return userVars().value(this).value(key, NULL);
 }
 /*
  * @coord
@@ -878,7 +940,9 @@ RS_Vector RS_Entity::getNearestOrthTan(const RS_Vector& /*coord*/,
  * Add a user defined variable to this entity.
  */
 void RS_Entity::setUserDefVar(QString key, QString val) {
-    varList.insert(key, val);
+    QMutexLocker lock(&userVarsMutex());
+    userVars()[this].insert(key, val);
+    setFlag(RS2::FlagUserVars);
 }
 
 
@@ -887,7 +951,19 @@ void RS_Entity::setUserDefVar(QString key, QString val) {
  * Deletes the given user defined variable.
  */
 void RS_Entity::delUserDefVar(QString key) {
-    varList.remove(key);
+    if (!getFlag(RS2::FlagUserVars)) {
+        return;
+    }
+    QMutexLocker lock(&userVarsMutex());
+    QHash<const RS_Entity*, VarList>::iterator it = userVars().find(this);
+    if (it!=userVars().end()) {
+        it->remove(key);
+        if (!it->isEmpty()) {
+            return;
+        }
+        userVars().erase(it);
+    }
+    delFlag(RS2::FlagUserVars);
 }
 
 
@@ -896,7 +972,21 @@ void RS_Entity::delUserDefVar(QString key) {
  * @return A list of all keys connected to this entity.
  */
 QList<QString> RS_Entity::getAllKeys() {
-    return varList.keys();
+    if (!getFlag(RS2::FlagUserVars)) {
+        return QList<QString>();
+    }
+    QMutexLocker lock(&userVarsMutex());
+    return userVars().value(this).keys();
+}
+
+
+
+/**
+ * @return Number of entities which currently have user defined variables.
+ */
+int RS_Entity::countUserDefVarEntities() {
+    QMutexLocker lock(&userVarsMutex());
+    return userVars().size();
 }
 
 //! constructionLayer contains entities of infinite length, constructionLayer doesn't show up in print
@@ -961,10 +1051,9 @@ std::ostream& operator << (std::ostream& os, RS_Entity& e) {
     os << e.pen << "\n";
 
         os << "variable list:\n";
-    QHash<QString, QString>::const_iterator it = e.varList.constBegin();
-    while (it != e.varList.constEnd() ) {
-        os << it.key().toLatin1().data() << ": " << it.value().toLatin1().data() << ", ";
-        ++it;
+    const QList<QString> keys = e.getAllKeys();
+    for (const QString& key: keys) {
+        os << key.toLatin1().data() << ": " << e.getUserDefVar(key).toLatin1().data() << ", ";
     }
 
     // There should be a better way then this...
@@ -65,8 +65,11 @@ public:
 
 
     RS_Entity(RS_EntityContainer* parent=NULL);
+    RS_Entity(const RS_Entity& e);
     virtual ~RS_Entity();
 
+    RS_Entity& operator = (const RS_Entity& e);
+
     void init();
     virtual void initId();
 
@@ -236,11 +239,20 @@ public:
     virtual void update() {}
 
     virtual void setUpdateEnabled(bool on) {
-        updateEnabled = on;
+        if (on) {
+            delFlag(RS2::FlagUpdateDisabled);
+        } else {
+            setFlag(RS2::FlagUpdateDisabled);
+        }
+    }
+    bool isUpdateEnabled() const {
+        return !getFlag(RS2::FlagUpdateDisabled);
     }
 
     /**
-     * This method doesn't do any calculations.
+     * This method doesn't do any calculations. Borders of containers
+     * marked with RS_EntityContainer::invalidateBorders() are
+     * recalculated by RS_EntityContainer::updateBorders().
      * @return minimum coordinate of the entity.
      * @see calculateBorders()
      */
@@ -250,8 +262,9 @@ public:
 
     /**
      * This method doesn't do any calculations.
-     * @return minimum coordinate of the entity.
+     * @return maximum coordinate of the entity.
      * @see calculateBorders()
+     * @see getMin()
      */
     RS_Vector getMax() const {
         return maxV;
@@ -558,6 +571,7 @@ public:
     QList<QString> getAllKeys();
     void setUserDefVar(QString key, QString val);
     void delUserDefVar(QString key);
+    static int countUserDefVarEntities();
 
     friend std::ostream& operator << (std::ostream& os, RS_Entity& e);
 
@@ -611,12 +625,6 @@ protected:
 
     //! pen (attributes) for this entity
     RS_Pen pen;
-
-    //! auto updating enabled?
-    bool updateEnabled;
-
-private:
-    QMultiHash<QString, QString> varList;
 };
 
 #endif
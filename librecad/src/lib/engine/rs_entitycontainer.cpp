@@ -40,6 +40,9 @@
 #include "rs_solid.h"
 #include "rs_information.h"
 #include "rs_graphicview.h"
+#include "lc_parallel.h"
+#include "lc_profiler.h"
+#include "lc_vectorops.h"
 
 #if QT_VERSION < 0x040400
 #include "emu_qt44.h"
@@ -62,6 +65,8 @@ RS_EntityContainer::RS_EntityContainer(RS_EntityContainer* parent,
     subContainer = NULL;
     //autoUpdateBorders = true;
     entIdx = -1;
+    constructionLines = false;
+    constructionStamp = 0;
 }
 
 
@@ -265,6 +270,8 @@ void RS_EntityContainer::selectWindow(RS_Vector v1, RS_Vector v2,
 
     bool included;
 
+    updateBorders();
+
     for (RS_Entity* e=firstEntity(RS2::ResolveNone);
          e!=NULL;
          e=nextEntity(RS2::ResolveNone)) {
@@ -353,8 +360,12 @@ void RS_EntityContainer::addEntity(RS_Entity* entity) {
     } else {
         entities.append(entity);
     }
+    constructionStamp = 0;
     if (autoUpdateBorders) {
         adjustBorders(entity);
+        invalidateParentBorders();
+    } else {
+        invalidateBorders();
     }
 }
 
@@ -367,8 +378,13 @@ void RS_EntityContainer::appendEntity(RS_Entity* entity){
     if (entity==NULL)
         return;
     entities.append(entity);
-    if (autoUpdateBorders)
+    constructionStamp = 0;
+    if (autoUpdateBorders) {
         adjustBorders(entity);
+        invalidateParentBorders();
+    } else {
+        invalidateBorders();
+    }
 }
 
 /**
@@ -379,8 +395,13 @@ void RS_EntityContainer::prependEntity(RS_Entity* entity){
     if (entity==NULL)
         return;
     entities.prepend(entity);
-    if (autoUpdateBorders)
+    constructionStamp = 0;
+    if (autoUpdateBorders) {
         adjustBorders(entity);
+        invalidateParentBorders();
+    } else {
+        invalidateBorders();
+    }
 }
 
 /**
@@ -430,8 +451,12 @@ void RS_EntityContainer::insertEntity(int index, RS_Entity* entity) {
 
     entities.insert(index, entity);
 
+    constructionStamp = 0;
     if (autoUpdateBorders) {
         adjustBorders(entity);
+        invalidateParentBorders();
+    } else {
+        invalidateBorders();
     }
 }
 
@@ -459,8 +484,8 @@ void RS_EntityContainer::replaceEntity(int index, RS_Entity* entity) {
 
 
 /**
- * Removes an entity from this container and updates the borders of
- * this entity-container if autoUpdateBorders is true.
+ * Removes an entity from this container. The borders of this
+ * entity-container are recalculated when they are used next.
  */
 bool RS_EntityContainer::removeEntity(RS_Entity* entity) {
     //RLZ TODO: in Q3PtrList if 'entity' is NULL remove the current item-> at.(entIdx)
@@ -476,8 +501,9 @@ bool RS_EntityContainer::removeEntity(RS_Entity* entity) {
     if (autoDelete && ret) {
         delete entity;
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
+    if (ret) {
+        constructionStamp = 0;
+        invalidateBorders();
     }
     return ret;
 }
@@ -494,6 +520,8 @@ void RS_EntityContainer::clear() {
     } else
         entities.clear();
     resetBorders();
+    delFlag(RS2::FlagBordersDirty);
+    constructionStamp = 0;
 }
 
 
@@ -543,6 +571,25 @@ unsigned int RS_EntityContainer::countSelected() {
     return c;
 }
 
+/**
+ * @return The selected entities in this container (not resolved).
+ * Callers must not rely on the order of the returned list.
+ */
+QList<RS_Entity*> RS_EntityContainer::getSelection() {
+    QList<RS_Entity*> ret;
+
+    for (RS_Entity* t=firstEntity(RS2::ResolveNone);
+         t!=NULL;
+         t=nextEntity(RS2::ResolveNone)) {
+
+        if (t->isSelected()) {
+            ret.append(t);
+        }
+    }
+
+    return ret;
+}
+
 /**
  * Counts the selected entities in this container.
  */
@@ -572,11 +619,20 @@ void RS_EntityContainer::adjustBorders(RS_Entity* entity) {
 
     if (entity!=NULL) {
         // make sure a container is not empty (otherwise the border
-        //   would get extended to 0/0):
-        if (!entity->isContainer() || entity->count()>0) {
-            minV = RS_Vector::minimum(entity->getMin(),minV);
-            maxV = RS_Vector::maximum(entity->getMax(),maxV);
+        //   would get extended to 0/0). Containers which create their
+        //   entities on demand know if they are empty. Outdated borders
+        //   are recalculated together with the borders of this container:
+        if (entity->isContainer()) {
+            RS_EntityContainer* c = static_cast<RS_EntityContainer*>(entity);
+            if (c->getFlag(RS2::FlagBordersDirty)) {
+                invalidateBorders();
+                return;
+            }
+            if (c->isEmpty()) {
+                return;
+            }
         }
+        LC_VectorOps::extendBox(entity->getMin(), entity->getMax(), minV, maxV);
 
         // Notify parents. The border for the parent might
         // also change TODO: Check for efficiency
@@ -589,6 +645,12 @@ void RS_EntityContainer::adjustBorders(RS_Entity* entity) {
 
 /**
  * Recalculates the borders of this entity container.
+ *
+ * Nested containers keep their borders up to date themselves or
+ * are marked with invalidateBorders(), so only those marked are
+ * recalculated here, the others are used as they are. Marked ones
+ * are recalculated even if they are hidden, so no marked container
+ * is left behind in a container which is not marked.
  */
 void RS_EntityContainer::calculateBorders() {
     RS_DEBUG->print("RS_EntityContainer::calculateBorders");
@@ -603,11 +665,19 @@ void RS_EntityContainer::calculateBorders() {
         //        RS_DEBUG->print("RS_EntityContainer::calculateBorders: "
         //                        "isVisible: %d", (int)e->isVisible());
 
+        if (e->isContainer()) {
+            static_cast<RS_EntityContainer*>(e)->updateBorders();
+        }
         if (e->isVisible() && (layer==NULL || !layer->isFrozen())) {
-            e->calculateBorders();
+            if (!e->isContainer()) {
+                e->calculateBorders();
+            }
             adjustBorders(e);
         }
     }
+    // not before, nested containers creating their entities on demand
+    // mark this one again:
+    delFlag(RS2::FlagBordersDirty);
 
     RS_DEBUG->print("RS_EntityContainer::calculateBorders: size 1: %f,%f",
                     getSize().x, getSize().y);
@@ -658,6 +728,7 @@ void RS_EntityContainer::forcedCalculateBorders() {
         }
         adjustBorders(e);
     }
+    delFlag(RS2::FlagBordersDirty);
 
     // needed for correcting corrupt data (PLANS.dxf)
     if (minV.x>maxV.x || minV.x>RS_MAXDOUBLE || maxV.x>RS_MAXDOUBLE
@@ -681,6 +752,111 @@ void RS_EntityContainer::forcedCalculateBorders() {
 
 
 
+/**
+ * Recalculates the borders of this container if they were marked as
+ * outdated with invalidateBorders(). getMin() and getMax() don't do
+ * any calculations, so this is called before the borders are used,
+ * e.g. once before a drawing is drawn.
+ */
+void RS_EntityContainer::updateBorders() {
+    if (getFlag(RS2::FlagBordersDirty)) {
+        LC_PROFILE_SCOPE("borders/update");
+        calculateBorders();
+    }
+}
+
+
+
+/**
+ * Marks the borders of this container as outdated, instead of
+ * recalculating them after every change. They are recalculated by
+ * updateBorders(). The containers this container is part of are
+ * marked too.
+ *
+ * Every container of a marked container is marked, so marking stops
+ * at a container which is marked already.
+ */
+void RS_EntityContainer::invalidateBorders() {
+    if (getFlag(RS2::FlagBordersDirty)) {
+        return;
+    }
+    setFlag(RS2::FlagBordersDirty);
+    invalidateParentBorders();
+}
+
+
+
+/**
+ * Marks the borders of the containers this container is part of as
+ * outdated, e.g. after the borders of this container were adjusted
+ * to an added entity.
+ *
+ * Previews are not part of their parent, so marking stops there. So
+ * does it in a parallel loop, the parents are shared with other
+ * threads and marked by the caller of the loop.
+ */
+void RS_EntityContainer::invalidateParentBorders() {
+    if (rtti()==RS2::EntityPreview || LC_Parallel::inLoop()) {
+        return;
+    }
+    for (RS_EntityContainer* c=getParent();
+         c!=NULL && !c->getFlag(RS2::FlagBordersDirty);
+         c=c->getParent()) {
+        c->setFlag(RS2::FlagBordersDirty);
+        if (c->rtti()==RS2::EntityPreview) {
+            break;
+        }
+    }
+}
+
+
+
+/**
+ * Marks the borders of this container and of all nested containers
+ * as outdated, so they are all recalculated from scratch, e.g. after
+ * layers were frozen or thawed.
+ */
+void RS_EntityContainer::invalidateBordersDeep() {
+    setFlag(RS2::FlagBordersDirty);
+    for (RS_Entity* e: entities) {
+        if (e->isContainer()) {
+            static_cast<RS_EntityContainer*>(e)->invalidateBordersDeep();
+        }
+    }
+}
+
+
+
+/**
+ * @return true if this container has lines on construction layers,
+ * nested ones included. Those are drawn across the whole view, beyond
+ * the borders of the container (see RS_Line::draw()).
+ *
+ * The result is kept along with the borders: it is valid while they
+ * are, no entity was added or removed since and no construction
+ * attribute of a layer changed. Hidden entities count too, undoing and
+ * redoing doesn't touch the container.
+ */
+bool RS_EntityContainer::hasConstructionLines() {
+    const unsigned changes = RS_Layer::getConstructionChanges();
+    if (constructionStamp==changes && !getFlag(RS2::FlagBordersDirty)) {
+        return constructionLines;
+    }
+    constructionLines = false;
+    for (RS_Entity* e: entities) {
+        if (e->isContainer() ?
+                static_cast<RS_EntityContainer*>(e)->hasConstructionLines() :
+                e->rtti()==RS2::EntityLine && e->isConstruction(true)) {
+            constructionLines = true;
+            break;
+        }
+    }
+    constructionStamp = changes;
+    return constructionLines;
+}
+
+
+
 /**
  * Updates all Dimension entities in this container and / or
  * reposition their labels.
@@ -699,8 +875,8 @@ void RS_EntityContainer::updateDimensions(bool autoText) {
     for (int i = 0; i < entities.size(); ++i) {
         e = entities.at(i);
         if (RS_Information::isDimension(e->rtti())) {
-            // update and reposition label:
-            ((RS_Dimension*)e)->updateDim(autoText);
+            // update and reposition label when used next:
+            ((RS_Dimension*)e)->invalidateDim(autoText);
         } else if(e->rtti()==RS2::EntityDimLeader)
             e->update();
         else if (e->isContainer()) {
@@ -714,27 +890,34 @@ void RS_EntityContainer::updateDimensions(bool autoText) {
 
 
 /**
- * Updates all Insert entities in this container.
+ * Updates all Insert entities in this container, in parallel.
  */
 void RS_EntityContainer::updateInserts() {
 
     RS_DEBUG->print("RS_EntityContainer::updateInserts()");
 
-    //for (RS_Entity* e=firstEntity(RS2::ResolveNone);
-    //        e!=NULL;
-    //        e=nextEntity(RS2::ResolveNone)) {
-    RS_Entity* e;
+    std::vector<RS_Insert*> inserts;
+    collectInserts(inserts);
+    RS_Insert::updateInserts(inserts);
+
+    RS_DEBUG->print("RS_EntityContainer::updateInserts() OK");
+}
+
+
+
+/**
+ * Appends the inserts in this container and in nested containers to
+ * inserts, but not the inserts inside of inserts.
+ */
+void RS_EntityContainer::collectInserts(std::vector<RS_Insert*>& inserts) {
     for (int i = 0; i < entities.size(); ++i) {
-        e = entities.at(i);
-        //// Only update our own inserts and not inserts of inserts
-        if (e->rtti()==RS2::EntityInsert  /*&& e->getParent()==this*/) {
-            ((RS_Insert*)e)->update();
+        RS_Entity* e = entities.at(i);
+        if (e->rtti()==RS2::EntityInsert) {
+            inserts.push_back(static_cast<RS_Insert*>(e));
         } else if (e->isContainer() && e->rtti()!=RS2::EntityHatch) {
-            ((RS_EntityContainer*)e)->updateInserts();
+            static_cast<RS_EntityContainer*>(e)->collectInserts(inserts);
         }
     }
-
-    RS_DEBUG->print("RS_EntityContainer::updateInserts() OK");
 }
 
 
@@ -771,27 +954,40 @@ void RS_EntityContainer::renameInserts(const QString& oldName,
 
 
 /**
- * Updates all Spline entities in this container.
+ * Updates all Spline entities in this container and tessellates them
+ * in parallel.
  */
 void RS_EntityContainer::updateSplines() {
 
     RS_DEBUG->print("RS_EntityContainer::updateSplines()");
 
-    //for (RS_Entity* e=firstEntity(RS2::ResolveNone);
-    //        e!=NULL;
-    //        e=nextEntity(RS2::ResolveNone)) {
-    RS_Entity* e;
+    std::vector<RS_Spline*> splines;
+    collectSplines(splines);
+    for (RS_Spline* s: splines) {
+        s->update();
+    }
+    LC_Parallel::forEach(splines.size(), [&splines](int i) {
+        splines[i]->getStrokePoints();
+    });
+
+    RS_DEBUG->print("RS_EntityContainer::updateSplines() OK");
+}
+
+
+
+/**
+ * Appends the splines in this container and in nested containers
+ * to splines.
+ */
+void RS_EntityContainer::collectSplines(std::vector<RS_Spline*>& splines) {
     for (int i = 0; i < entities.size(); ++i) {
-        e = entities.at(i);
-        //// Only update our own inserts and not inserts of inserts
-        if (e->rtti()==RS2::EntitySpline  /*&& e->getParent()==this*/) {
-            ((RS_Spline*)e)->update();
+        RS_Entity* e = entities.at(i);
+        if (e->rtti()==RS2::EntitySpline) {
+            splines.push_back(static_cast<RS_Spline*>(e));
         } else if (e->isContainer() && e->rtti()!=RS2::EntityHatch) {
-            ((RS_EntityContainer*)e)->updateSplines();
+            static_cast<RS_EntityContainer*>(e)->collectSplines(splines);
         }
     }
-
-    RS_DEBUG->print("RS_EntityContainer::updateSplines() OK");
 }
 
 
@@ -1765,6 +1961,9 @@ void RS_EntityContainer::move(const RS_Vector& offset) {
     }
     if (autoUpdateBorders) {
         moveBorders(offset);
+        invalidateParentBorders();
+    } else {
+        invalidateBorders();
     }
 }
 
@@ -1777,9 +1976,7 @@ void RS_EntityContainer::rotate(const RS_Vector& center, const double& angle) {
          e=nextEntity(RS2::ResolveNone)) {
         e->rotate(center, angleVector);
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
-    }
+    invalidateBorders();
 }
 
 
@@ -1789,9 +1986,7 @@ void RS_EntityContainer::rotate(const RS_Vector& center, const RS_Vector& angleV
          e=nextEntity(RS2::ResolveNone)) {
         e->rotate(center, angleVector);
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
-    }
+    invalidateBorders();
 }
 
 
@@ -1803,9 +1998,7 @@ void RS_EntityContainer::scale(const RS_Vector& center, const RS_Vector& factor)
             e->scale(center, factor);
         }
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
-    }
+    invalidateBorders();
 }
 
 
@@ -1818,6 +2011,7 @@ void RS_EntityContainer::mirror(const RS_Vector& axisPoint1, const RS_Vector& ax
             e->mirror(axisPoint1, axisPoint2);
         }
     }
+    invalidateBorders();
 }
 
 
@@ -1825,6 +2019,7 @@ void RS_EntityContainer::stretch(const RS_Vector& firstCorner,
                                  const RS_Vector& secondCorner,
                                  const RS_Vector& offset) {
 
+    updateBorders();
     if (getMin().isInWindow(firstCorner, secondCorner) &&
             getMax().isInWindow(firstCorner, secondCorner)) {
 
@@ -1835,6 +2030,7 @@ void RS_EntityContainer::stretch(const RS_Vector& firstCorner,
              e=nextEntity(RS2::ResolveNone)) {
             e->stretch(firstCorner, secondCorner, offset);
         }
+        invalidateBorders();
     }
 
     // some entitiycontainers might need an update (e.g. RS_Leader):
@@ -1851,9 +2047,7 @@ void RS_EntityContainer::moveRef(const RS_Vector& ref,
          e=nextEntity(RS2::ResolveNone)) {
         e->moveRef(ref, offset);
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
-    }
+    invalidateBorders();
 }
 
 
@@ -1865,9 +2059,7 @@ void RS_EntityContainer::moveSelectedRef(const RS_Vector& ref,
          e=nextEntity(RS2::ResolveNone)) {
         e->moveSelectedRef(ref, offset);
     }
-    if (autoUpdateBorders) {
-        calculateBorders();
-    }
+    invalidateBorders();
 }
 
 void RS_EntityContainer::revertDirection() {
@@ -28,6 +28,8 @@
 #ifndef RS_ENTITYCONTAINER_H
 #define RS_ENTITYCONTAINER_H
 
+#include <vector>
+
 #include "rs_arc.h"
 #include "rs_circle.h"
 #include "rs_ellipse.h"
@@ -35,6 +37,8 @@
 #include "rs_line.h"
 #include "rs_point.h"
 
+class RS_Spline;
+
 /**
  * Class representing a tree of entities.
  * Typical entity containers are graphics, polylines, groups, texts, ...)
@@ -121,6 +125,7 @@ public:
     virtual unsigned int countDeep();
     //virtual unsigned long int countLayerEntities(RS_Layer* layer);
     virtual unsigned int countSelected();
+    virtual QList<RS_Entity*> getSelection();
     virtual double totalSelectedLength();
 
     /**
@@ -133,6 +138,11 @@ public:
     virtual void adjustBorders(RS_Entity* entity);
     virtual void calculateBorders();
     virtual void forcedCalculateBorders();
+    void updateBorders();
+    void invalidateBorders();
+    void invalidateParentBorders();
+    void invalidateBordersDeep();
+    bool hasConstructionLines();
     virtual void updateDimensions( bool autoText=true);
     virtual void updateInserts();
     virtual void updateSplines();
@@ -215,6 +225,8 @@ public:
     bool ignoredOnModification() const;
 
 protected:
+    void collectInserts(std::vector<RS_Insert*>& inserts);
+    void collectSplines(std::vector<RS_Spline*>& splines);
 
     /** entities in the container */
     QList<RS_Entity *> entities;
@@ -231,6 +243,10 @@ protected:
 private:
     int entIdx;
     bool autoDelete;
+    //! Cached result of hasConstructionLines().
+    bool constructionLines;
+    //! RS_Layer::getConstructionChanges() when it was cached, 0 if never.
+    unsigned constructionStamp;
 };
 
 #endif
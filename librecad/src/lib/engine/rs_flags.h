@@ -48,7 +48,12 @@ public:
         flags = f;
     }
 
-    virtual ~RS_Flags() {}
+    /**
+     * Not virtual on purpose: flags are embedded in every pen and color
+     * and a vtable pointer would double their size. Never delete a
+     * derived object through an RS_Flags pointer.
+     */
+    ~RS_Flags() {}
 
     unsigned int getFlags() const {
         return flags;
@@ -27,10 +27,14 @@
 
 #include "rs_font.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <QTextStream>
 #include <QTextCodec>
 
+#include "rs_arc.h"
+#include "rs_line.h"
 #include "rs_polyline.h"
 #include "rs_fontchar.h"
 #include "rs_system.h"
@@ -46,7 +50,8 @@
  *              the letters will be deleted when the font is deleted.
  */
 RS_Font::RS_Font(const QString& fileName, bool owner)
-    :	letterList(owner) {
+    :	letterList(owner),
+      mutex(QMutex::Recursive) {
     this->fileName = fileName;
     encoding = "";
     loaded = false;
@@ -366,6 +371,7 @@ void RS_Font::readLFF(QString path) {
 }
 
 void RS_Font::generateAllFonts(){
+    QMutexLocker lock(&mutex);
     QMap<QString, QStringList>::const_iterator i = rawLffFontList.constBegin();
     while (i != rawLffFontList.constEnd()) {
         generateLffFont(i.key());
@@ -455,11 +461,96 @@ RS_Block* RS_Font::generateLffFont(const QString& ch){
 }
 
 RS_Block* RS_Font::findLetter(const QString& name) {
+    QMutexLocker lock(&mutex);
     RS_Block* ret= letterList.find(name);
     if (ret != NULL) return ret;
     return generateLffFont(name);
 
 }
+
+
+
+/**
+ * @return Metrics and outline of the given letter or of the
+ * replacement character if the font doesn't have the letter.
+ * NULL if neither is available.
+ */
+const LC_Glyph* RS_Font::findGlyph(const QString& name) {
+    QMutexLocker lock(&mutex);
+    QHash<QString, const LC_Glyph*>::const_iterator it = glyphMap.constFind(name);
+    if (it != glyphMap.constEnd()) {
+        return it.value();
+    }
+
+    const LC_Glyph* ret = NULL;
+    RS_Block* letter = findLetter(name);
+    if (letter != NULL) {
+        glyphs.push_back(LC_Glyph());
+        LC_Glyph& glyph = glyphs.back();
+        glyph.font = this;
+        glyph.block = letter;
+        createGlyph(glyph);
+        ret = &glyph;
+    } else if (name != QString(QChar(0xfffd))) {
+        RS_DEBUG->print("RS_Font::findGlyph: missing font for letter( %s ), replaced it with QChar(0xfffd)",qPrintable(name));
+        ret = findGlyph(QChar(0xfffd));
+    }
+    glyphMap.insert(name, ret);
+    return ret;
+}
+
+
+
+/**
+ * Collects borders, size and outline of the letter block of a glyph.
+ * Arcs are approximated by line segments. The outline is kept as
+ * polylines for picking and as path for drawing.
+ */
+void RS_Font::createGlyph(LC_Glyph& glyph) {
+    RS_Block* letter = glyph.block;
+    letter->calculateBorders();
+    glyph.minV = letter->getMin();
+    glyph.maxV = letter->getMax();
+    glyph.entities = letter->countDeep();
+
+    std::vector<RS_Vector>* stroke = NULL;
+    for (RS_Entity* e=letter->firstEntity(RS2::ResolveAll);
+         e!=NULL;
+         e=letter->nextEntity(RS2::ResolveAll)) {
+
+        std::vector<RS_Vector> pts;
+        if (e->rtti()==RS2::EntityLine) {
+            RS_Line* l = (RS_Line*)e;
+            pts.push_back(l->getStartpoint());
+            pts.push_back(l->getEndpoint());
+        } else if (e->rtti()==RS2::EntityArc) {
+            RS_Arc* a = (RS_Arc*)e;
+            const double r = a->getRadius();
+            const double len = a->getAngleLength();
+            // chord tolerance of 0.005 font units:
+            int n = 1;
+            if (r>0.005) {
+                n = std::max(1, (int)ceil(len/(2.0*acos(1.0-0.005/r))));
+            }
+            const double step = (a->isReversed() ? -len : len)/n;
+            for (int i=0; i<=n; ++i) {
+                RS_Vector p;
+                p.setPolar(r, a->getAngle1() + step*i);
+                pts.push_back(a->getCenter() + p);
+            }
+        } else {
+            continue;
+        }
+
+        // continue the previous stroke if connected:
+        if (stroke!=NULL && stroke->back().distanceTo(pts.front())<1.0e-6) {
+            stroke->insert(stroke->end(), pts.begin()+1, pts.end());
+        } else {
+            glyph.strokes.push_back(pts);
+            stroke = &glyph.strokes.back();
+        }
+    }
+}
 /**
  * Dumps the fonts data to stdout.
  */
@@ -29,9 +29,13 @@
 #define RS_FONT_H
 
 #include <iostream>
+#include <deque>
 #include <QStringList>
 #include <QMap>
+#include <QHash>
+#include <QMutex>
 #include "rs_blocklist.h"
+#include "lc_textlayout.h"
 
 /**
  * Class for representing a font. This is implemented as a RS_Graphic
@@ -99,6 +103,7 @@ public:
 		return &letterList;
 	}
     RS_Block* findLetter(const QString& name);
+    const LC_Glyph* findGlyph(const QString& name);
 //    RS_Block* findLetter(const QString& name) {
 //		return letterList.find(name);
 //	}
@@ -117,6 +122,7 @@ private:
     void readCXF(QString path);
     void readLFF(QString path);
     RS_Block* generateLffFont(const QString& ch);
+    void createGlyph(LC_Glyph& glyph);
 
 private:
     //raw lff font file list, not processed into blocks yet
@@ -125,6 +131,12 @@ private:
         //! block list (letters)
         RS_BlockList letterList;
 
+    //! glyph metrics and outlines, created on first use of a letter
+    std::deque<LC_Glyph> glyphs;
+    QHash<QString, const LC_Glyph*> glyphMap;
+    //! letters are generated lazily, also by parallel updates
+    QMutex mutex;
+
     //! Font file name
     QString fileName;
 	
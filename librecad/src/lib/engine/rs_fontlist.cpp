@@ -129,14 +129,17 @@ RS_Font* RS_FontList::requestFont(const QString& name) {
     RS_DEBUG->print("name2: %s", name2.toLatin1().data());
 
     // Search our list of available fonts:
-    for (int i = 0; i < fonts.size(); ++i) {
-        RS_Font* f = fonts.at(i);
-
-        if (f->getFileName()==name2) {
-            // Make sure this font is loaded into memory:
-            f->loadFont();
-            foundFont = f;
-            break;
+    {
+        QMutexLocker lock(&requestMutex);
+        for (int i = 0; i < fonts.size(); ++i) {
+            RS_Font* f = fonts.at(i);
+
+            if (f->getFileName()==name2) {
+                // Make sure this font is loaded into memory:
+                f->loadFont();
+                foundFont = f;
+                break;
+            }
         }
     }
 
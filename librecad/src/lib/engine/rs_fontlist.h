@@ -30,6 +30,7 @@
 
 
 #include <QList>
+#include <QMutex>
 class RS_Font;
 
 #define RS_FONTLIST RS_FontList::instance()
@@ -79,6 +80,8 @@ protected:
 private:
     //! fonts in the graphic
     QList<RS_Font *> fonts;
+    //! fonts are requested and loaded by parallel insert updates
+    QMutex requestMutex;
 };
 
 #endif
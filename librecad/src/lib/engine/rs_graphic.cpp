@@ -869,6 +869,7 @@ void RS_Graphic::centerToPage() {
     RS_Vector size = getPaperSize();
 
     double scale = getPaperScale();
+    updateBorders();
     auto&& s=getSize();
     auto&& sMin=getMin();
     /** avoid zero size, bug#3573158 */
@@ -896,6 +897,7 @@ bool RS_Graphic::fitToPage() {
     double border = RS_Units::convert(25.0, RS2::Millimeter, getUnit());
     RS_Vector ps = getPaperSize();
     if(ps.x>border && ps.y>border) ps -= RS_Vector(border, border);
+    updateBorders();
     RS_Vector s = getSize();
     /** avoid zero size, bug#3573158 */
     if(fabs(s.x)<RS_TOLERANCE) s.x=10.;
@@ -932,7 +934,7 @@ bool RS_Graphic::fitToPage() {
 
 void RS_Graphic::addEntity(RS_Entity* entity)
 {
-    RS_EntityContainer::addEntity(entity);
+    RS_Document::addEntity(entity);
     if( entity->rtti() == RS2::EntityBlock ||
             entity->rtti() == RS2::EntityContainer){
         RS_EntityContainer* e=static_cast<RS_EntityContainer*>(entity);
@@ -30,6 +30,7 @@
 #include <QBrush>
 #include <QString>
 #include "rs_hatch.h"
+#include "lc_profiler.h"
 
 #include "rs_graphicview.h"
 #include "rs_dialogfactory.h"
@@ -138,12 +139,13 @@ void RS_Hatch::update() {
         return;
     }
 
-    if (updateEnabled==false) {
+    if (!isUpdateEnabled()) {
         return;
     }
+    LC_PROFILE_SCOPE("hatch/update");
 
     if (data.solid==true) {
-        calculateBorders();
+        invalidateBorders();
         return;
     }
 
@@ -25,9 +25,15 @@
 **********************************************************************/
 
 
+#include <algorithm>
+#include <QHash>
+
 #include "rs_insert.h"
+#include "lc_parallel.h"
+#include "lc_profiler.h"
 
 #include "rs_block.h"
+#include "rs_dimension.h"
 #include "rs_graphic.h"
 #include "rs_layer.h"
 
@@ -64,9 +70,10 @@ void RS_Insert::update() {
 //        RS_DEBUG->print("RS_Insert::update: insertionPoint: %f/%f",
 //                data.insertionPoint.x, data.insertionPoint.y);
 
-        if (updateEnabled==false) {
+        if (!isUpdateEnabled()) {
                 return;
         }
+        LC_PROFILE_SCOPE("insert/update");
 
     clear();
 
@@ -99,15 +106,20 @@ void RS_Insert::update() {
         RS_DEBUG->print("RS_Insert::update: block has %d entities",
                 blk->count());
 //int i_en_counts=0;
-    for (RS_Entity* e=blk->firstEntity(); e!=NULL; e=blk->nextEntity()) {
+    // by index, the iterator of the block is shared by all its inserts:
+    for (unsigned ei=0; ei<blk->count(); ++ei) {
+        RS_Entity* e = blk->entityAt(ei);
         for (int c=0; c<data.cols; ++c) {
 //            RS_DEBUG->print("RS_Insert::update: col %d", c);
             for (int r=0; r<data.rows; ++r) {
 //                i_en_counts++;
 //                RS_DEBUG->print("RS_Insert::update: row %d", r);
 
+                // in a parallel loop the inserts of the block were
+                // updated beforehand, see updateInserts():
                 if (e->rtti()==RS2::EntityInsert &&
-                    data.updateMode!=RS2::PreviewUpdate) {
+                    data.updateMode!=RS2::PreviewUpdate &&
+                    !LC_Parallel::inLoop()) {
 
 //                                        RS_DEBUG->print("RS_Insert::update: updating sub-insert");
                     ((RS_Insert*)e)->update();
@@ -206,13 +218,105 @@ void RS_Insert::update() {
             }
         }
     }
-    calculateBorders();
+    // recalculated by updateBorders(), the container of the insert
+    // changed too:
+    invalidateBorders();
 
         RS_DEBUG->print("RS_Insert::update: OK");
 }
 
 
 
+namespace {
+typedef std::vector<std::vector<RS_Insert*> > InsertLevels;
+
+/**
+ * @return Nesting depth of the inserts in block blk, 0 for a block
+ * without inserts. The inserts of blocks with depth d are appended
+ * to levels[d-1].
+ */
+int collectBlockInserts(RS_Block* blk, QHash<RS_Block*, int>& depths,
+                        InsertLevels& levels) {
+    if (blk==NULL) {
+        return 0;
+    }
+    QHash<RS_Block*, int>::const_iterator it = depths.constFind(blk);
+    if (it!=depths.constEnd()) {
+        return it.value();
+    }
+    // a block inserting itself must not recurse forever:
+    depths.insert(blk, 0);
+
+    int depth = 0;
+    std::vector<RS_Insert*> inserts;
+    for (unsigned i=0; i<blk->count(); ++i) {
+        RS_Entity* e = blk->entityAt(i);
+        if (e->rtti()==RS2::EntityInsert) {
+            RS_Insert* ins = static_cast<RS_Insert*>(e);
+            inserts.push_back(ins);
+            depth = std::max(depth,
+                             collectBlockInserts(ins->getBlockForInsert(),
+                                                 depths, levels) + 1);
+        }
+    }
+
+    depths.insert(blk, depth);
+    if (depth>0) {
+        if ((int)levels.size()<depth) {
+            levels.resize(depth);
+        }
+        levels[depth-1].insert(levels[depth-1].end(),
+                               inserts.begin(), inserts.end());
+    }
+    return depth;
+}
+
+void updateParallel(const std::vector<RS_Insert*>& inserts) {
+    LC_Parallel::forEach(inserts.size(), [&inserts](int i) {
+        inserts[i]->update();
+    });
+    // the containers of the inserts were left alone by the workers:
+    for (RS_Insert* i: inserts) {
+        i->invalidateParentBorders();
+    }
+}
+}
+
+
+
+/**
+ * Updates the given inserts on all available cores.
+ *
+ * Every insert copies the entities of its block, so the inserts
+ * inside the blocks are updated first: level by level, starting with
+ * the blocks which contain no inserts. Blocks, fonts and patterns are
+ * looked up before or under lock, so no block is changed while
+ * another thread reads it.
+ */
+void RS_Insert::updateInserts(const std::vector<RS_Insert*>& inserts) {
+    if (inserts.empty()) {
+        return;
+    }
+    LC_PROFILE_SCOPE("insert/updateAll");
+
+    // resolves the blocks of all inserts, nested ones included:
+    QHash<RS_Block*, int> depths;
+    InsertLevels levels;
+    for (RS_Insert* i: inserts) {
+        collectBlockInserts(i->getBlockForInsert(), depths, levels);
+    }
+
+    // dimensions in blocks are created while their insert is updated:
+    RS_Dimension::addMissingVariables(inserts.front()->getGraphic());
+
+    for (const std::vector<RS_Insert*>& level: levels) {
+        updateParallel(level);
+    }
+    updateParallel(inserts);
+}
+
+
+
 /**
  * @return Pointer to the block associated with this Insert or
  *   NULL if the block couldn't be found. Blocks are requested
@@ -28,6 +28,8 @@
 #ifndef RS_INSERT_H
 #define RS_INSERT_H
 
+#include <vector>
+
 #include "rs_entitycontainer.h"
 
 class RS_BlockList;
@@ -143,6 +145,7 @@ public:
     RS_Block* getBlockForInsert();
 
     virtual void update();
+    static void updateInserts(const std::vector<RS_Insert*>& inserts);
 
     QString getName() const {
         return data.name;
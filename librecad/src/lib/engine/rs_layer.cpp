@@ -28,6 +28,8 @@
 
 #include "rs_layer.h"
 
+unsigned RS_Layer::constructionChanges = 1;
+
 /**
  * Constructor.
  */
@@ -179,6 +179,7 @@ public:
      */
     void toggleConstruction() {
         data.construction = !data.construction;
+        ++constructionChanges;
     }
 
     /**
@@ -244,16 +245,30 @@ public:
      * @param construction true: infinite lines, false: normal layer
      */
     bool setConstruction( const bool construction){
-        data.construction = construction;
+        if (data.construction!=construction) {
+            data.construction = construction;
+            ++constructionChanges;
+        }
         return construction;
     }
 
+    /**
+     * @return A number which changes whenever the construction attribute
+     * of any layer changes, see RS_EntityContainer::hasConstructionLines().
+     */
+    static unsigned getConstructionChanges() {
+        return constructionChanges;
+    }
+
     friend std::ostream& operator << (std::ostream& os, const RS_Layer& l);
 
 private:
     //! Layer data
     RS_LayerData data;
 
+    //! Counts changes of the construction attribute of all layers.
+    static unsigned constructionChanges;
+
 };
 
 #endif
@@ -50,6 +50,7 @@ RS_LayerList::RS_LayerList() {
  */
 void RS_LayerList::clear() {
     layers.clear();
+    layerNames.clear();
 	setModified(true);
 }
 
@@ -137,6 +138,7 @@ void RS_LayerList::add(RS_Layer* layer) {
     RS_Layer* l = find(layer->getName());
     if (l==NULL) {
         layers.append(layer);
+        hashName(layer);
         this->sort();
         // notify listeners
         for (int i=0; i<layerListListeners.size(); ++i) {
@@ -187,6 +189,7 @@ void RS_LayerList::remove(RS_Layer* layer) {
 #else
     layers.removeOne(layer);
 #endif
+    unhashName(layer);
 
 
     for (int i=0; i<layerListListeners.size(); ++i) {
@@ -217,7 +220,10 @@ void RS_LayerList::edit(RS_Layer* layer, const RS_Layer& source) {
         return;
     }
 
+    // the name might change, keep the name index up to date:
+    unhashName(layer);
     *layer = source;
+    hashName(layer);
 
     for (int i=0; i<layerListListeners.size(); ++i) {
         RS_LayerListListener* l = layerListListeners.at(i);
@@ -237,19 +243,18 @@ void RS_LayerList::edit(RS_Layer* layer, const RS_Layer& source) {
 RS_Layer* RS_LayerList::find(const QString& name) {
     //RS_DEBUG->print("RS_LayerList::find begin");
 
-    RS_Layer* ret = NULL;
-
-    for (int i=0; i<layers.size(); ++i) {
-        RS_Layer* l = layers.at(i);
-        if (l->getName()==name) {
-            ret = l;
-            break;
+    // the index is case insensitive, the name itself has to match exactly:
+    const QString key = name.toLower();
+    QMultiHash<QString, RS_Layer*>::const_iterator it = layerNames.constFind(key);
+    for (; it!=layerNames.constEnd() && it.key()==key; ++it) {
+        if (it.value()->getName()==name) {
+            return it.value();
         }
     }
 
     //RS_DEBUG->print("RS_LayerList::find end");
 
-    return ret;
+    return NULL;
 }
 
 
@@ -259,22 +264,11 @@ RS_Layer* RS_LayerList::find(const QString& name) {
  * was not found.
  */
 int RS_LayerList::getIndex(const QString& name) {
-    //RS_DEBUG->print("RS_LayerList::find begin");
-
-    int ret = -1;
-
-    for (int i=0; i<layers.size(); i++) {
-        RS_Layer* l = layers.at(i);
-
-        if (l->getName()==name) {
-            ret = i;
-            break;
-        }
+    RS_Layer* l = find(name);
+    if (l==NULL) {
+        return -1;
     }
-
-    //RS_DEBUG->print("RS_LayerList::find end");
-
-    return ret;
+    return layers.indexOf(l);
 }
 
 
@@ -429,6 +423,24 @@ void RS_LayerList::removeListener(RS_LayerListListener* listener) {
 
 
 
+/**
+ * Adds the given layer to the name index.
+ */
+void RS_LayerList::hashName(RS_Layer* layer) {
+    layerNames.insert(layer->getName().toLower(), layer);
+}
+
+
+
+/**
+ * Removes the given layer from the name index.
+ */
+void RS_LayerList::unhashName(RS_Layer* layer) {
+    layerNames.remove(layer->getName().toLower(), layer);
+}
+
+
+
 /**
  * Dumps the layers to stdout.
  */
@@ -30,6 +30,8 @@
 #define RS_LAYERLIST_H
 
 #include <QList>
+#include <QMultiHash>
+#include <QString>
 
 class RS_Layer;
 class RS_LayerListListener;
@@ -124,8 +126,13 @@ public:
     friend std::ostream& operator << (std::ostream& os, RS_LayerList& l);
 
 private:
+    void hashName(RS_Layer* layer);
+    void unhashName(RS_Layer* layer);
+
     //! layers in the graphic
     QList<RS_Layer*> layers;
+    //! layers indexed by their lower case name for fast lookup by find()
+    QMultiHash<QString, RS_Layer*> layerNames;
     //! List of registered LayerListListeners
     QList<RS_LayerListListener*> layerListListeners;
     QG_LayerWidget* layerWidget;
@@ -43,6 +43,9 @@
 #include "emu_c99.h"
 #endif
 
+LC_DEFINE_POOL_ALLOCATED(RS_Line)
+
+
 /**
  * Constructor.
  */
@@ -538,22 +541,21 @@ void RS_Line::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOff
         return;
     }
 
+    const LC_RenderContext& rc = view->getRenderContext(painter);
+
     //only draw the visible portion of line
     QVector<RS_Vector> endPoints(0);
-        RS_Vector vpMin(view->toGraph(0,view->getHeight()));
-        RS_Vector vpMax(view->toGraph(view->getWidth(),0));
-         QPolygonF visualBox(QRectF(vpMin.x,vpMin.y,vpMax.x-vpMin.x, vpMax.y-vpMin.y));
+    const RS_Vector& vpMin = rc.viewportMin;
+    const RS_Vector& vpMax = rc.viewportMax;
     if( getStartpoint().isInWindowOrdered(vpMin, vpMax) ) endPoints<<getStartpoint();
     if( getEndpoint().isInWindowOrdered(vpMin, vpMax) ) endPoints<<getEndpoint();
     if(endPoints.size()<2){
 
-         QVector<RS_Vector> vertex;
-         for(unsigned short i=0;i<4;i++){
-             const QPointF& vp(visualBox.at(i));
-             vertex<<RS_Vector(vp.x(),vp.y());
-         }
+         const RS_Vector vertex[4] = {
+             vpMin, RS_Vector(vpMax.x, vpMin.y), vpMax, RS_Vector(vpMin.x, vpMax.y)
+         };
          for(unsigned short i=0;i<4;i++){
-             RS_Line line(NULL,RS_LineData(vertex.at(i),vertex.at((i+1)%4)));
+             RS_Line line(NULL,RS_LineData(vertex[i],vertex[(i+1)%4]));
              auto&& vpIts=RS_Information::getIntersection(static_cast<RS_Entity*>(this), &line, true);
              if( vpIts.size()==0) continue;
              endPoints<<vpIts.get(0);
@@ -648,7 +650,7 @@ void RS_Line::draw(RS_Painter* painter, RS_GraphicView* view, double& patternOff
     RS_Vector* dp=new RS_Vector[pat->num > 0?pat->num:0];
     double* ds=new double[pat->num > 0?pat->num:0];
     if (pat->num >0 ){
-        double dpmm=static_cast<RS_PainterQt*>(painter)->getDpmm();
+        double dpmm=rc.dpmm;
         for (i=0; i<pat->num; ++i) {
             //        ds[j]=pat->pattern[i] * styleFactor;
             //fixme, styleFactor support needed
@@ -29,6 +29,7 @@
 #define RS_LINE_H
 
 #include "rs_atomicentity.h"
+#include "lc_entitypool.h"
 
 class LC_Quadratic;
 
@@ -71,6 +72,8 @@ public:
  * @author Andrew Mustun
  */
 class RS_Line : public RS_AtomicEntity {
+    LC_POOL_ALLOCATED
+
 public:
     //RS_Line(RS_EntityContainer* parent);
     //RS_Line(const RS_Line& l);
@@ -25,11 +25,15 @@
 **********************************************************************/
 
 
+#include <algorithm>
+
 #include "rs_font.h"
 #include "rs_mtext.h"
 
 #include "rs_fontlist.h"
+#include "rs_graphicview.h"
 #include "rs_insert.h"
+#include "rs_painter.h"
 
 /**
  * Constructor.
@@ -38,6 +42,7 @@ RS_MText::RS_MText(RS_EntityContainer* parent,
                  const RS_MTextData& d)
         : RS_EntityContainer(parent), data(d) {
 
+    lettersCreated = false;
     usedTextHeight = 0.0;
     usedTextWidth = 0.0;
     setText(data.text);
@@ -164,7 +169,7 @@ int RS_MText::getNumberOfLines() {
 
 
 /**
- * Updates the Inserts (letters) of this text. Called when the
+ * Updates the layout (letters) of this text. Called when the
  * text or it's data, position, alignment, .. changes.
  * This method also updates the usedTextWidth / usedTextHeight property.
  */
@@ -173,6 +178,8 @@ void RS_MText::update() {
     RS_DEBUG->print("RS_Text::update");
 
     clear();
+    layout.clear();
+    lettersCreated = false;
 
     if (isUndone()) {
         return;
@@ -196,7 +203,7 @@ void RS_MText::update() {
     //  so we can move the whole line around easely:
     RS_EntityContainer* oneLine = new RS_EntityContainer(this);
 
-    // First every text line is created with
+    // First every text line is laid out with
     //   alignement: top left
     //   angle: 0
     //   height: 9.0
@@ -345,57 +352,46 @@ void RS_MText::update() {
 
         default: {
                 // One Letter:
-                QString letterText = QString(data.text.at(i));
-                if (font->findLetter(letterText) == NULL) {
-                    RS_DEBUG->print("RS_Text::update: missing font for letter( %s ), replaced it with QChar(0xfffd)",qPrintable(letterText));
-                    letterText = QChar(0xfffd);
+                const LC_Glyph* glyph = font->findGlyph(QString(data.text.at(i)));
+                if (glyph==NULL) {
+                    break;
                 }
-//                if (font->findLetter(QString(data.text.at(i))) != NULL) {
-
-                                        RS_DEBUG->print("RS_Text::update: insert a "
-                                          "letter at pos: %f/%f", letterPos.x, letterPos.y);
-
-                    RS_InsertData d(letterText,
-                                    letterPos,
-                                    RS_Vector(1.0, 1.0),
-                                    0.0,
-                                    1,1, RS_Vector(0.0,0.0),
-                                    font->getLetterList(), RS2::NoUpdate);
-
-                    RS_Insert* letter = new RS_Insert(this, d);
-                    RS_Vector letterWidth;
-                    letter->setPen(RS_Pen(RS2::FlagInvalid));
-                    letter->setLayer(NULL);
-                    letter->update();
-                    letter->forcedCalculateBorders();
-
-                                        // until 2.0.4.5:
-                    //letterWidth = RS_Vector(letter->getSize().x, 0.0);
-                                        // from 2.0.4.6:
-                    letterWidth = RS_Vector(letter->getMax().x-letterPos.x, 0.0);
-                    if (letterWidth.x < 0)
-                        letterWidth.x = -letterSpace.x;
-
-                    oneLine->addEntity(letter);
-
-                    // next letter position:
-                    letterPos += letterWidth;
-                    letterPos += letterSpace;
-//                }
+                RS_DEBUG->print("RS_Text::update: insert a "
+                                "letter at pos: %f/%f", letterPos.x, letterPos.y);
+                layout.addGlyph(glyph, letterPos, lineCounter);
+
+                // until 2.0.4.5:
+                //letterWidth = RS_Vector(letter->getSize().x, 0.0);
+                // from 2.0.4.6:
+                RS_Vector letterWidth = RS_Vector(glyph->maxV.x, 0.0);
+                if (letterWidth.x < 0)
+                    letterWidth.x = -letterSpace.x;
+
+                // next letter position:
+                letterPos += letterWidth;
+                letterPos += letterSpace;
             }
             break;
         }
     }
 
     double tt = updateAddLine(oneLine, lineCounter);
+    layout.setTransform(data.insertionPoint,
+                        RS_Vector(data.height/9.0, data.height/9.0),
+                        data.angle);
+    layout.updateBox();
     if (data.valign == RS_MTextData::VABottom) {
         RS_Vector ot = RS_Vector(0.0,-tt).rotate(data.angle);
         RS_EntityContainer::move(ot);
+        layout.move(ot);
     }
 
     usedTextHeight -= data.height*data.lineSpacingFactor*5.0/3.0
                       - data.height;
-    forcedCalculateBorders();
+    // the borders of the text right away (e.g. for the label of a
+    // dimension), the ones of its containers by updateBorders():
+    invalidateBorders();
+    updateBorders();
 
     RS_DEBUG->print("RS_Text::update: OK");
 }
@@ -414,32 +410,38 @@ void RS_MText::update() {
 double RS_MText::updateAddLine(RS_EntityContainer* textLine, int lineCounter) {
     double ls =5.0/3.0;
 
-    RS_DEBUG->print("RS_Text::updateAddLine: width: %f", textLine->getSize().x);
-
-        //textLine->forcedCalculateBorders();
-    //RS_DEBUG->print("RS_Text::updateAddLine: width 2: %f", textLine->getSize().x);
-
-    // Move to correct line position:
-    textLine->move(RS_Vector(0.0, -9.0 * lineCounter
-                             * data.lineSpacingFactor * ls));
-
-    if( ! RS_EntityContainer::autoUpdateBorders) {
-        //only update borders when needed
+    // Size of the line from its letters and stacked texts:
+    RS_Vector lineMin(0.0, 0.0);
+    RS_Vector lineMax(0.0, 0.0);
+    bool found = layout.getBox(lineMin, lineMax, lineCounter);
+    if (!textLine->isEmpty()) {
         textLine->forcedCalculateBorders();
+        if (found) {
+            lineMin = RS_Vector::minimum(lineMin, textLine->getMin());
+            lineMax = RS_Vector::maximum(lineMax, textLine->getMax());
+        } else {
+            lineMin = textLine->getMin();
+            lineMax = textLine->getMax();
+            found = true;
+        }
     }
-    RS_Vector textSize = textLine->getSize();
+    RS_Vector textSize = lineMax - lineMin;
+
+    RS_DEBUG->print("RS_Text::updateAddLine: width 2: %f", textSize.x);
 
-        RS_DEBUG->print("RS_Text::updateAddLine: width 2: %f", textSize.x);
+    // Move to correct line position:
+    RS_Vector offset(0.0, -9.0 * lineCounter
+                     * data.lineSpacingFactor * ls);
 
     // Horizontal Align:
     switch (data.halign) {
     case RS_MTextData::HACenter:
                 RS_DEBUG->print("RS_Text::updateAddLine: move by: %f", -textSize.x/2.0);
-        textLine->move(RS_Vector(-textSize.x/2.0, 0.0));
+        offset.move(RS_Vector(-textSize.x/2.0, 0.0));
         break;
 
     case RS_MTextData::HARight:
-        textLine->move(RS_Vector(-textSize.x, 0.0));
+        offset.move(RS_Vector(-textSize.x, 0.0));
         break;
 
     default:
@@ -452,32 +454,34 @@ double RS_MText::updateAddLine(RS_EntityContainer* textLine, int lineCounter) {
 
     switch (data.valign) {
     case RS_MTextData::VAMiddle:
-        textLine->move(RS_Vector(0.0, vSize/2.0));
+        offset.move(RS_Vector(0.0, vSize/2.0));
         break;
 
     case RS_MTextData::VABottom:
-        textLine->move(RS_Vector(0.0, vSize));
+        offset.move(RS_Vector(0.0, vSize));
         break;
 
     default:
         break;
     }
 
+    layout.moveGlyphs(offset, lineCounter);
+    textLine->move(offset);
+
     // Scale:
+    double factor = data.height/9.0;
     textLine->scale(RS_Vector(0.0,0.0),
-                    RS_Vector(data.height/9.0, data.height/9.0));
-
-    textLine->forcedCalculateBorders();
+                    RS_Vector(factor, factor));
 
     // Update actual text size (before rotating, after scaling!):
-    if (textLine->getSize().x>usedTextWidth) {
-        usedTextWidth = textLine->getSize().x;
+    if (textSize.x*factor>usedTextWidth) {
+        usedTextWidth = textSize.x*factor;
     }
 
     usedTextHeight += data.height*data.lineSpacingFactor*ls;
 
     // Gets the distance over text base-line (before rotating, after scaling!):
-    double textTail = textLine->getMin().y;
+    double textTail = found ? (lineMin.y + offset.y)*factor : 0.0;
 
     // Rotate:
     textLine->rotate(RS_Vector(0.0,0.0), data.angle);
@@ -493,6 +497,157 @@ double RS_MText::updateAddLine(RS_EntityContainer* textLine, int lineCounter) {
 }
 
 
+
+/**
+ * Creates the letter inserts of this text from the layout and adds
+ * them to their line containers. Only needed by code which resolves
+ * the text into its letters. The letters are removed again by update().
+ */
+void RS_MText::createLetters() {
+    if (lettersCreated) {
+        return;
+    }
+    lettersCreated = true;
+    for (size_t i=0; i<layout.count(); ++i) {
+        if (layout.lineAt(i)>=entities.size()) {
+            continue;
+        }
+        RS_EntityContainer* line = (RS_EntityContainer*)entities.at(layout.lineAt(i));
+        const LC_Glyph* glyph = layout.glyphAt(i);
+        RS_InsertData d(glyph->block->getName(),
+                        layout.toDrawing(layout.offsetAt(i)),
+                        layout.getFactor(),
+                        layout.getAngle(),
+                        1,1, RS_Vector(0.0,0.0),
+                        glyph->font->getLetterList(), RS2::NoUpdate);
+
+        RS_Insert* letter = new RS_Insert(line, d);
+        letter->setPen(RS_Pen(RS2::FlagInvalid));
+        letter->setLayer(NULL);
+        letter->update();
+        if (isSelected()) {
+            letter->setSelected(true);
+        }
+        line->addEntity(letter);
+    }
+}
+
+
+
+RS_Entity* RS_MText::firstEntity(RS2::ResolveLevel level) {
+    if (level!=RS2::ResolveNone) {
+        createLetters();
+    }
+    return RS_EntityContainer::firstEntity(level);
+}
+
+
+
+RS_Entity* RS_MText::lastEntity(RS2::ResolveLevel level) {
+    if (level!=RS2::ResolveNone) {
+        createLetters();
+    }
+    return RS_EntityContainer::lastEntity(level);
+}
+
+
+
+RS_Entity* RS_MText::entityAt(int index) {
+    createLetters();
+    return RS_EntityContainer::entityAt(index);
+}
+
+
+
+bool RS_MText::isEmpty() {
+    if (!layout.isEmpty()) {
+        return false;
+    }
+    foreach (RS_Entity* line, entities) {
+        if (!((RS_EntityContainer*)line)->isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+/**
+ * @return Number of atomic entities of the letters and stacked texts.
+ */
+unsigned int RS_MText::countDeep() {
+    unsigned int c = layout.countDeep();
+    foreach (RS_Entity* e, entities) {
+        RS_EntityContainer* line = (RS_EntityContainer*)e;
+        for (unsigned i=0; i<line->count(); ++i) {
+            if (line->entityAt(i)->rtti()==RS2::EntityMText) {
+                c += line->entityAt(i)->countDeep();
+            }
+        }
+    }
+    return c;
+}
+
+
+
+void RS_MText::calculateBorders() {
+    delFlag(RS2::FlagBordersDirty);
+    resetBorders();
+    layout.extendBorders(minV, maxV);
+    foreach (RS_Entity* line, entities) {
+        adjustBorders(line);
+    }
+    if (isEmpty()) {
+        minV = maxV = RS_Vector(0.0, 0.0);
+    }
+}
+
+
+
+void RS_MText::forcedCalculateBorders() {
+    foreach (RS_Entity* line, entities) {
+        ((RS_EntityContainer*)line)->forcedCalculateBorders();
+    }
+    calculateBorders();
+}
+
+
+
+/**
+ * The distance is taken from the glyph outlines and stacked texts.
+ * Resolving into the letters creates the letter inserts.
+ */
+double RS_MText::getDistanceToPoint(const RS_Vector& coord,
+                                    RS_Entity** entity,
+                                    RS2::ResolveLevel level,
+                                    double solidDist) const {
+    if (level!=RS2::ResolveNone) {
+        const_cast<RS_MText*>(this)->createLetters();
+        return RS_EntityContainer::getDistanceToPoint(coord, entity, level, solidDist);
+    }
+    double ret = RS_EntityContainer::getDistanceToPoint(coord, NULL, level, solidDist);
+    if (entity!=NULL) {
+        *entity = const_cast<RS_MText*>(this);
+    }
+    return std::min(ret, layout.getDistanceToPoint(coord));
+}
+
+
+
+RS_Vector RS_MText::getNearestDist(double distance,
+                                   const RS_Vector& coord,
+                                   double* dist) {
+    createLetters();
+    RS_Entity* line = NULL;
+    RS_EntityContainer::getDistanceToPoint(coord, &line, RS2::ResolveNone);
+    if (line==NULL) {
+        return RS_Vector(false);
+    }
+    return line->getNearestDist(distance, coord, dist);
+}
+
+
 RS_Vector RS_MText::getNearestEndpoint(const RS_Vector& coord, double* dist)const {
     if (dist!=NULL) {
         *dist = data.insertionPoint.distanceTo(coord);
@@ -517,6 +672,7 @@ RS_Vector RS_MText::getNearestRef(const RS_Vector& coord,
 
 void RS_MText::move(const RS_Vector& offset) {
     RS_EntityContainer::move(offset);
+    layout.move(offset);
     data.insertionPoint.move(offset);
 //    update();
 }
@@ -526,12 +682,14 @@ void RS_MText::move(const RS_Vector& offset) {
 void RS_MText::rotate(const RS_Vector& center, const double& angle) {
     RS_Vector angleVector(angle);
     RS_EntityContainer::rotate(center, angleVector);
+    layout.rotate(center, angleVector);
     data.insertionPoint.rotate(center, angleVector);
     data.angle = RS_Math::correctAngle(data.angle+angle);
 //    update();
 }
 void RS_MText::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
     RS_EntityContainer::rotate(center, angleVector);
+    layout.rotate(center, angleVector);
     data.insertionPoint.rotate(center, angleVector);
     data.angle = RS_Math::correctAngle(data.angle+angleVector.angle());
 //    update();
@@ -600,6 +758,33 @@ void RS_MText::stretch(const RS_Vector& firstCorner, const RS_Vector& secondCorn
 
 
 
+/**
+ * Draws the letters from the layout and the stacked texts of the lines.
+ */
+void RS_MText::draw(RS_Painter* painter, RS_GraphicView* view, double& /*patternOffset*/) {
+    if (painter==NULL || view==NULL) {
+        return;
+    }
+
+    // containers are not filtered by RS_GraphicView::drawEntityPlain():
+    if (isSelected()!=painter->shouldDrawSelected()) {
+        return;
+    }
+
+    layout.draw(painter, view, getPen(true), isSelected());
+
+    foreach (RS_Entity* e, entities) {
+        RS_EntityContainer* line = (RS_EntityContainer*)e;
+        for (unsigned i=0; i<line->count(); ++i) {
+            if (line->entityAt(i)->rtti()==RS2::EntityMText) {
+                view->drawEntity(painter, line->entityAt(i));
+            }
+        }
+    }
+}
+
+
+
 /**
  * Dumps the point's data to stdout.
  */
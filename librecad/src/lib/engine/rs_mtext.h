@@ -29,6 +29,7 @@
 #define RS_MTEXT_H
 
 #include "rs_entitycontainer.h"
+#include "lc_textlayout.h"
 
 /**
  * Holds the data that defines a text entity.
@@ -190,6 +191,7 @@ public:
     }
 
     void update();
+    void createLetters();
 
     int getNumberOfLines();
 
@@ -267,6 +269,21 @@ public:
     virtual RS_VectorSolutions getRefPoints();
     virtual RS_Vector getNearestRef(const RS_Vector& coord,
                                     double* dist = NULL);
+    virtual RS_Vector getNearestDist(double distance,
+                                     const RS_Vector& coord,
+                                     double* dist = NULL);
+    virtual double getDistanceToPoint(const RS_Vector& coord,
+                                      RS_Entity** entity,
+                                      RS2::ResolveLevel level=RS2::ResolveNone,
+                                      double solidDist = RS_MAXDOUBLE) const;
+
+    virtual RS_Entity* firstEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* lastEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* entityAt(int index);
+    virtual bool isEmpty();
+    virtual unsigned int countDeep();
+    virtual void calculateBorders();
+    virtual void forcedCalculateBorders();
 
     virtual void move(const RS_Vector& offset);
     virtual void rotate(const RS_Vector& center, const double& angle);
@@ -278,6 +295,8 @@ public:
                          const RS_Vector& secondCorner,
                          const RS_Vector& offset);
 
+    virtual void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset);
+
     friend std::ostream& operator << (std::ostream& os, const RS_Text& p);
 
 private:
@@ -286,6 +305,13 @@ private:
 protected:
     RS_MTextData data;
 
+    /**
+     * Letters of all lines. The line containers only hold stacked
+     * texts until the letter inserts are created by createLetters().
+     */
+    LC_TextLayout layout;
+    bool lettersCreated;
+
     /**
      * Text width used by the current contents of this text entity.
      * This property is updated by the update method.
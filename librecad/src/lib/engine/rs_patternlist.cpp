@@ -120,6 +120,7 @@ RS_Pattern* RS_PatternList::requestPattern(const QString& name) {
     RS_DEBUG->print("name2: %s", name2.toLatin1().data());
 
     // Search our list of available patterns:
+    QMutexLocker lock(&requestMutex);
     for (int i = 0; i < patterns.size(); ++i) {
         RS_Pattern* p = patterns.at(i);
 
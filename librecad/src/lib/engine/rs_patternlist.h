@@ -29,6 +29,7 @@
 #define RS_PATTERNLIST_H
 
 
+#include <QMutex>
 #include "rs_pattern.h"
 #include "rs_entity.h"
 
@@ -84,6 +85,8 @@ protected:
 private:
     //! patterns in the graphic
     QList<RS_Pattern*> patterns;
+    //! patterns are requested and loaded by parallel insert updates
+    QMutex requestMutex;
     //! List of registered PatternListListeners
     //QList<RS_PatternListListener> patternListListeners;
 }
@@ -81,7 +81,7 @@ public:
     //    width = pen.width;
     //    color = pen.color;
     //}
-    virtual ~RS_Pen() {}
+    ~RS_Pen() {}
 
     RS2::LineType getLineType() const {
         return lineType;
@@ -132,10 +132,11 @@ public:
 
 
 protected:
+    // ordered to avoid padding, a pen is stored in every entity:
     RS2::LineType lineType;
     RS2::LineWidth width;
-	double screenWidth;
     RS_Color color;
+	double screenWidth;
 };
 
 #endif
@@ -31,6 +31,9 @@
 #include "rs_painter.h"
 
 
+LC_DEFINE_POOL_ALLOCATED(RS_Point)
+
+
 /**
  * Default constructor.
  */
@@ -29,6 +29,7 @@
 #define RS_POINT_H
 
 #include "rs_atomicentity.h"
+#include "lc_entitypool.h"
 
 
 
@@ -57,6 +58,8 @@ public:
  * @author Andrew Mustun
  */
 class RS_Point : public RS_AtomicEntity {
+    LC_POOL_ALLOCATED
+
 public:
     RS_Point(RS_EntityContainer* parent,
              const RS_PointData& d);
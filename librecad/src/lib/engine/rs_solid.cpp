@@ -30,6 +30,7 @@
 #include "rs_graphicview.h"
 #include "rs_painter.h"
 #include "rs_information.h"
+#include "lc_vectorops.h"
 
 
 /**
@@ -89,13 +90,7 @@ void RS_Solid::shapeArrow(const RS_Vector& point,
 
 void RS_Solid::calculateBorders() {
     resetBorders();
-
-    for (int i=0; i<4; ++i) {
-        if (data.corner[i].valid) {
-            minV = RS_Vector::minimum(minV, data.corner[i]);
-            maxV = RS_Vector::maximum(maxV, data.corner[i]);
-        }
-    }
+    LC_VectorOps::extend(data.corner, data.corner + 4, minV, maxV);
 }
 
 
@@ -103,24 +98,20 @@ void RS_Solid::calculateBorders() {
 RS_Vector RS_Solid::getNearestEndpoint(const RS_Vector& coord, double* dist)const {
 
     double minDist = RS_MAXDOUBLE;
-    double curDist;
-    RS_Vector ret;
-
-    for (int i=0; i<4; ++i) {
-        if (data.corner[i].valid) {
-            curDist = data.corner[i].distanceTo(coord);
-            if (curDist<minDist) {
-                ret = data.corner[i];
-                minDist = curDist;
-            }
+    const RS_Vector* it = LC_VectorOps::closest(data.corner, data.corner + 4,
+                                                coord, &minDist);
+    if (it==data.corner + 4) {
+        if (dist!=NULL) {
+            *dist = RS_MAXDOUBLE;
         }
+        return RS_Vector();
     }
 
     if (dist!=NULL) {
-        *dist = minDist;
+        *dist = sqrt(minDist);
     }
 
-    return ret;
+    return *it;
 }
 
 bool RS_Solid::isInCrossWindow(const RS_Vector& v1,const RS_Vector& v2)const {
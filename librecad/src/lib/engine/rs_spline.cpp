@@ -27,17 +27,91 @@
 
 #include "rs_spline.h"
 
+#include <algorithm>
+#include <utility>
 #include "rs_debug.h"
 #include "rs_graphicview.h"
 #include "rs_painter.h"
 #include "rs_graphic.h"
+#include "rs_line.h"
+#include "lc_rendercontext.h"
+#include "lc_vectorops.h"
+#include "lc_profiler.h"
+
+namespace {
+
+/**
+ * @return The point on the segment a-b which is closest to p.
+ */
+RS_Vector nearestOnSegment(const RS_Vector& a, const RS_Vector& b,
+                           const RS_Vector& p) {
+    RS_Vector ab = b - a;
+    double l2 = ab.squared();
+    if (l2<RS_TOLERANCE2) {
+        return a;
+    }
+    double t = RS_Vector::dotP(p - a, ab)/l2;
+    if (t<=0.0) {
+        return a;
+    }
+    if (t>=1.0) {
+        return b;
+    }
+    return a + ab*t;
+}
+
+/**
+ * Copies the points of a polyline to out, leaving away the points
+ * which are closer than tolerance to the simplified polyline
+ * (Douglas-Peucker).
+ */
+void simplify(const std::vector<RS_Vector>& in, double tolerance,
+              std::vector<RS_Vector>& out) {
+    out.clear();
+    if (in.size()<3) {
+        out = in;
+        return;
+    }
+    std::vector<bool> keep(in.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+    std::vector<std::pair<size_t, size_t> > ranges;
+    ranges.push_back(std::make_pair(size_t(0), in.size()-1));
+    while (!ranges.empty()) {
+        const size_t first = ranges.back().first;
+        const size_t last = ranges.back().second;
+        ranges.pop_back();
+
+        double maxDist = tolerance;
+        size_t index = 0;
+        for (size_t i=first+1; i<last; ++i) {
+            double d = in[i].distanceTo(nearestOnSegment(in[first], in[last], in[i]));
+            if (d>maxDist) {
+                maxDist = d;
+                index = i;
+            }
+        }
+        if (index!=0) {
+            keep[index] = true;
+            ranges.push_back(std::make_pair(first, index));
+            ranges.push_back(std::make_pair(index, last));
+        }
+    }
+    for (size_t i=0; i<in.size(); ++i) {
+        if (keep[i]) {
+            out.push_back(in[i]);
+        }
+    }
+}
+
+}
 
 /**
  * Constructor.
  */
 RS_Spline::RS_Spline(RS_EntityContainer* parent,
                      const RS_SplineData& d)
-        :RS_EntityContainer(parent), data(d) {
+        :RS_EntityContainer(parent), data(d), strokePointsValid(false) {
     calculateBorders();
 }
 
@@ -62,17 +136,10 @@ RS_Entity* RS_Spline::clone() {
 
 
 void RS_Spline::calculateBorders() {
-    /*minV = RS_Vector::minimum(data.startpoint, data.endpoint);
-    maxV = RS_Vector::maximum(data.startpoint, data.endpoint);
-
-    QList<RS_Vector>::iterator it;
-    for (it = data.controlPoints.begin();
-    it!=data.controlPoints.end(); ++it) {
-
-    minV = RS_Vector::minimum(*it, minV);
-    maxV = RS_Vector::maximum(*it, maxV);
-}
-    */
+    delFlag(RS2::FlagBordersDirty);
+    resetBorders();
+    const std::vector<RS_Vector>& pts = getStrokePoints();
+    LC_VectorOps::extend(pts.begin(), pts.end(), minV, maxV);
 }
 
 
@@ -105,14 +172,46 @@ RS_Vector RS_Spline::getNearestSelectedRef(const RS_Vector& coord,
 
 /**
  * Updates the internal polygon of this spline. Called when the
- * spline or it's data, position, .. changes.
+ * spline or it's data, position, .. changes. The polygon is
+ * recomputed when it is used next.
  */
 void RS_Spline::update() {
 
     RS_DEBUG->print("RS_Spline::update");
 
     clear();
+    strokePointsValid = false;
+    strokePoints.clear();
+    invalidateBorders();
+}
 
+
+
+/**
+ * @return The polyline approximating this spline. It is computed
+ * when used first after update(). Points which do not change the
+ * shape by more than a small fraction of the spline size are left
+ * away, so straight or flat parts cost only a few points.
+ */
+const std::vector<RS_Vector>& RS_Spline::getStrokePoints() const {
+    if (!strokePointsValid) {
+        std::vector<RS_Vector> points;
+        tessellate(points);
+        // exact size, releases the memory of the removed points:
+        std::vector<RS_Vector>(points).swap(strokePoints);
+        // valid only once the points are there:
+        strokePointsValid = true;
+    }
+    return strokePoints;
+}
+
+
+
+/**
+ * Computes the polyline approximating this spline into points, which
+ * is left empty for invalid splines.
+ */
+void RS_Spline::tessellate(std::vector<RS_Vector>& points) const {
     if (isUndone()) {
         return;
     }
@@ -127,7 +226,7 @@ void RS_Spline::update() {
         return;
     }
 
-    resetBorders();
+    LC_PROFILE_SCOPE("spline/tessellate");
 
     QList<RS_Vector> tControlPoints = data.controlPoints;
 
@@ -142,11 +241,11 @@ void RS_Spline::update() {
     // order:
     int k = data.degree+1;
     // resolution:
-    int p1 = getGraphicVariableInt("$SPLINESEGS", 8) * npts;
+    int p1 = const_cast<RS_Spline*>(this)->getGraphicVariableInt("$SPLINESEGS", 8) * npts;
 
-    double* b = new double[npts*3+1];
-    double* h = new double[npts+1];
-    double* p = new double[p1*3+1];
+    std::vector<double> b(npts*3+1);
+    std::vector<double> h(npts+1);
+    std::vector<double> p(p1*3+1, 0.0);
 
     i = 1;
     for (int it = 0; it < tControlPoints.size(); ++it) {
@@ -163,43 +262,157 @@ void RS_Spline::update() {
         h[i] = 1.0;
     }
 
-    for (i = 1; i <= 3*p1; i++) {
-        p[i] = 0.0;
-    }
-
     if (data.closed) {
-        rbsplinu(npts,k,p1,b,h,p);
+        rbsplinu(npts,k,p1,&b[0],&h[0],&p[0]);
     } else {
-        rbspline(npts,k,p1,b,h,p);
+        rbspline(npts,k,p1,&b[0],&h[0],&p[0]);
     }
 
-    RS_Vector prev(false);
+    std::vector<RS_Vector> samples;
+    samples.reserve(p1);
     for (i = 1; i <= 3*p1; i=i+3) {
-        if (prev.valid) {
-            RS_Line* line = new RS_Line(this,
-                                        RS_LineData(prev, RS_Vector(p[i], p[i+1])));
-            line->setLayer(NULL);
-            line->setPen(RS_Pen(RS2::FlagInvalid));
-            addEntity(line);
+        samples.push_back(RS_Vector(p[i], p[i+1]));
+    }
+    if (samples.empty()) {
+        return;
+    }
+
+    // tolerance relative to the size of the spline:
+    RS_Vector vMin(samples.front());
+    RS_Vector vMax(samples.front());
+    LC_VectorOps::extend(samples.begin(), samples.end(), vMin, vMax);
+    double tolerance = std::max(RS_TOLERANCE, (vMax-vMin).magnitude()*1.0e-5);
+
+    simplify(samples, tolerance, points);
+}
+
+
+
+/**
+ * Creates line entities for the segments of the stroke points. Only
+ * needed by code which resolves the spline into its sub entities.
+ * The lines are removed again by update().
+ */
+void RS_Spline::createEdges() {
+    if (!entities.isEmpty()) {
+        return;
+    }
+    const std::vector<RS_Vector>& pts = getStrokePoints();
+    for (size_t i=1; i<pts.size(); ++i) {
+        RS_Line* line = new RS_Line(this, RS_LineData(pts[i-1], pts[i]));
+        line->setLayer(NULL);
+        line->setPen(RS_Pen(RS2::FlagInvalid));
+        if (isSelected()) {
+            line->setFlag(RS2::FlagSelected);
         }
-        prev = RS_Vector(p[i], p[i+1]);
+        // borders are the same as the borders of the stroke points:
+        entities.append(line);
+    }
+}
+
+
+
+RS_Entity* RS_Spline::firstEntity(RS2::ResolveLevel level) {
+    if (level!=RS2::ResolveNone) {
+        createEdges();
+    }
+    return RS_EntityContainer::firstEntity(level);
+}
+
 
-        minV = RS_Vector::minimum(prev, minV);
-        maxV = RS_Vector::maximum(prev, maxV);
+
+RS_Entity* RS_Spline::lastEntity(RS2::ResolveLevel level) {
+    if (level!=RS2::ResolveNone) {
+        createEdges();
     }
+    return RS_EntityContainer::lastEntity(level);
+}
+
+
+
+RS_Entity* RS_Spline::entityAt(int index) {
+    createEdges();
+    return RS_EntityContainer::entityAt(index);
+}
 
-    delete[] b;
-    delete[] h;
-    delete[] p;
+
+
+/**
+ * @return true if there are no stroke points, the edges may not
+ * have been created yet.
+ */
+bool RS_Spline::isEmpty() {
+    return getStrokePoints().empty();
 }
 
+
+
 RS_Vector RS_Spline::getStartpoint() const {
-   if (data.closed) return RS_Vector(false);
-   return static_cast<RS_Line*>(const_cast<RS_Spline*>(this)->firstEntity())->getStartpoint();
+   const std::vector<RS_Vector>& pts = getStrokePoints();
+   if (data.closed || pts.empty()) return RS_Vector(false);
+   return pts.front();
 }
 RS_Vector RS_Spline::getEndpoint() const {
-   if (data.closed) return RS_Vector(false);
-   return static_cast<RS_Line*>(const_cast<RS_Spline*>(this)->lastEntity())->getEndpoint();
+   const std::vector<RS_Vector>& pts = getStrokePoints();
+   if (data.closed || pts.empty()) return RS_Vector(false);
+   return pts.back();
+}
+
+
+
+/**
+ * @return The length of the stroke points.
+ */
+double RS_Spline::getLength() const {
+    const std::vector<RS_Vector>& pts = getStrokePoints();
+    double ret = 0.0;
+    for (size_t i=1; i<pts.size(); ++i) {
+        ret += pts[i-1].distanceTo(pts[i]);
+    }
+    return ret;
+}
+
+
+
+RS_Vector RS_Spline::getNearestPointOnEntity(const RS_Vector& coord,
+        bool /*onEntity*/, double* dist, RS_Entity** entity) const {
+    const std::vector<RS_Vector>& pts = getStrokePoints();
+    RS_Vector ret(false);
+    double minDist = RS_MAXDOUBLE;
+    for (size_t i=1; i<pts.size(); ++i) {
+        RS_Vector vp = nearestOnSegment(pts[i-1], pts[i], coord);
+        double d = (vp-coord).squared();
+        if (d<minDist) {
+            minDist = d;
+            ret = vp;
+        }
+    }
+    if (dist!=NULL) {
+        *dist = ret.valid ? sqrt(minDist) : RS_MAXDOUBLE;
+    }
+    if (entity!=NULL) {
+        *entity = const_cast<RS_Spline*>(this);
+    }
+    return ret;
+}
+
+
+
+/**
+ * The distance is taken from the stroke points. Resolving into the
+ * segments creates line entities for them.
+ */
+double RS_Spline::getDistanceToPoint(const RS_Vector& coord,
+                                     RS_Entity** entity,
+                                     RS2::ResolveLevel level,
+                                     double solidDist) const {
+    if (level!=RS2::ResolveNone) {
+        const_cast<RS_Spline*>(this)->createEdges();
+        return RS_EntityContainer::getDistanceToPoint(coord, entity, level, solidDist);
+    }
+    double dist = RS_MAXDOUBLE;
+    getNearestPointOnEntity(coord, true, &dist, entity);
+    return dist;
 }
 
 
@@ -284,9 +497,8 @@ RS_Vector RS_Spline::getNearestDist(double /*distance*/,
 
 void RS_Spline::move(const RS_Vector& offset) {
     RS_EntityContainer::move(offset);
-    for (int i = 0; i < data.controlPoints.size(); ++i) {
-        data.controlPoints[i].move(offset);
-    }
+    LC_VectorOps::move(data.controlPoints.begin(), data.controlPoints.end(), offset);
+    LC_VectorOps::move(strokePoints.begin(), strokePoints.end(), offset);
 //    update();
 }
 
@@ -300,16 +512,16 @@ void RS_Spline::rotate(const RS_Vector& center, const double& angle) {
 
 void RS_Spline::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
     RS_EntityContainer::rotate(center, angleVector);
-    for (int i = 0; i < data.controlPoints.size(); ++i) {
-        (data.controlPoints[i] ).rotate(center, angleVector);
-    }
+    LC_VectorOps::rotate(data.controlPoints.begin(), data.controlPoints.end(),
+                         center, angleVector);
+    LC_VectorOps::rotate(strokePoints.begin(), strokePoints.end(),
+                         center, angleVector);
 //    update();
 }
 
 void RS_Spline::scale(const RS_Vector& center, const RS_Vector& factor) {
-    for (int i = 0; i < data.controlPoints.size(); ++i) {
-        (data.controlPoints[i] ).scale(center, factor);
-    }
+    LC_VectorOps::scale(data.controlPoints.begin(), data.controlPoints.end(),
+                        center, factor);
 
     update();
 }
@@ -321,6 +533,9 @@ void RS_Spline::mirror(const RS_Vector& axisPoint1, const RS_Vector& axisPoint2)
     for (int i = 0; i < data.controlPoints.size(); ++i) {
         (data.controlPoints[i] ).mirror(axisPoint1, axisPoint2);
     }
+    for (size_t i = 0; i < strokePoints.size(); ++i) {
+        strokePoints[i].mirror(axisPoint1, axisPoint2);
+    }
 
 //    update();
 }
@@ -342,6 +557,7 @@ void RS_Spline::revertDirection() {
 	for(int k = 0; k < data.controlPoints.size() / 2; k++) {
 		data.controlPoints.swap(k, data.controlPoints.size() - 1 - k);
 	}
+	update();
 }
 
 
@@ -354,20 +570,55 @@ void RS_Spline::draw(RS_Painter* painter, RS_GraphicView* view, double& /*patter
     }
 
 
-    RS_Entity* e=firstEntity(RS2::ResolveNone);
-    if (e!=NULL) {
-        RS_Pen p=this->getPen(true);
-        e->setPen(p);
-        double patternOffset(0.0);
-        view->drawEntity(painter, e, patternOffset);
-        //RS_DEBUG->print("offset: %f\nlength was: %f", offset, e->getLength());
+    // containers are not filtered by RS_GraphicView::drawEntityPlain():
+    if (isSelected()!=painter->shouldDrawSelected()) {
+        return;
+    }
+
+    const std::vector<RS_Vector>& pts = getStrokePoints();
+    if (pts.size()<2) {
+        return;
+    }
 
-        e = nextEntity(RS2::ResolveNone);
-        while(e!=NULL) {
-            view->drawEntityPlain(painter, e, patternOffset);
-            e = nextEntity(RS2::ResolveNone);
-            //RS_DEBUG->print("offset: %f\nlength was: %f", offset, e->getLength());
+    RS_Pen p=this->getPen(true);
+    if (!isSelected() && (p.getLineType()==RS2::SolidLine ||
+                          view->getDrawingMode()==RS2::ModePreview)) {
+        // solid: one polyline for every visible run of segments
+        const LC_RenderContext& rc = view->getRenderContext(painter);
+        QPolygonF run;
+        for (size_t i=1; i<pts.size(); ++i) {
+            const RS_Vector& p0 = pts[i-1];
+            const RS_Vector& p1 = pts[i];
+            if (std::max(p0.x, p1.x)<rc.viewportMin.x || std::min(p0.x, p1.x)>rc.viewportMax.x ||
+                    std::max(p0.y, p1.y)<rc.viewportMin.y || std::min(p0.y, p1.y)>rc.viewportMax.y) {
+                if (run.size()>1) {
+                    painter->drawPolyline(run);
+                }
+                run.clear();
+                continue;
+            }
+            if (run.isEmpty()) {
+                run << QPointF(view->toGuiX(p0.x), view->toGuiY(p0.y));
+            }
+            run << QPointF(view->toGuiX(p1.x), view->toGuiY(p1.y));
         }
+        if (run.size()>1) {
+            painter->drawPolyline(run);
+        }
+        return;
+    }
+
+    // patterns and selection: segment by segment, continuing the pattern
+    RS_Line line(NULL, RS_LineData(pts[0], pts[1]));
+    line.setPen(p);
+    if (isSelected()) {
+        line.setFlag(RS2::FlagSelected);
+    }
+    double patternOffset(0.0);
+    for (size_t i=1; i<pts.size(); ++i) {
+        line.setStartpoint(pts[i-1]);
+        line.setEndpoint(pts[i]);
+        line.draw(painter, view, patternOffset);
     }
 }
 
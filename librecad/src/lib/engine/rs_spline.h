@@ -28,6 +28,7 @@
 #ifndef RS_SPLINE_H
 #define RS_SPLINE_H
 
+#include <vector>
 #include <QList>
 #include "rs_entitycontainer.h"
 
@@ -66,6 +67,12 @@ public:
 /**
  * Class for a spline entity.
  *
+ * The curve is approximated by a polyline (the stroke points) which is
+ * computed on demand and used for drawing, picking, borders and length.
+ * Line entities for the segments are only created when the spline is
+ * resolved into its sub entities (e.g. for intersections or hatch
+ * boundaries).
+ *
  * @author Andrew Mustun
  */
 class RS_Spline : public RS_EntityContainer {
@@ -155,6 +162,7 @@ public:
     //}
 
         void update();
+        const std::vector<RS_Vector>& getStrokePoints() const;
 
         //virtual void moveStartpoint(const RS_Vector& pos);
         //virtual void moveEndpoint(const RS_Vector& pos);
@@ -188,10 +196,12 @@ public:
     //    return data.endpoint.angleTo(data.startpoint);
     //}
 
+    virtual double getLength() const;
+
     virtual RS_Vector getNearestEndpoint(const RS_Vector& coord,
                                          double* dist = NULL)const;
-    //virtual RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
-    //        bool onEntity=true, double* dist = NULL, RS_Entity** entity=NULL);
+    virtual RS_Vector getNearestPointOnEntity(const RS_Vector& coord,
+            bool onEntity=true, double* dist = NULL, RS_Entity** entity=NULL)const;
     virtual RS_Vector getNearestCenter(const RS_Vector& coord,
                                        double* dist = NULL);
     virtual RS_Vector getNearestMiddle(const RS_Vector& coord,
@@ -202,10 +212,15 @@ public:
                                      double* dist = NULL);
         //virtual RS_Vector getNearestRef(const RS_Vector& coord,
         //                                 double* dist = NULL);
-        /*virtual double getDistanceToPoint(const RS_Vector& coord,
-                                      RS_Entity** entity=NULL,
+    virtual double getDistanceToPoint(const RS_Vector& coord,
+                                      RS_Entity** entity,
                                       RS2::ResolveLevel level=RS2::ResolveNone,
-                                                                          double solidDist = RS_MAXDOUBLE);*/
+                                      double solidDist = RS_MAXDOUBLE) const;
+
+    virtual RS_Entity* firstEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* lastEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* entityAt(int index);
+    virtual bool isEmpty();
 
         virtual void addControlPoint(const RS_Vector& v);
         virtual void removeLastControlPoint();
@@ -225,6 +240,9 @@ public:
         friend std::ostream& operator << (std::ostream& os, const RS_Spline& l);
 
         virtual void calculateBorders();
+        virtual void forcedCalculateBorders() {
+            calculateBorders();
+        }
 
         static void rbasis(int c, double t, int npts, int x[], double h[], double r[]);
 
@@ -237,7 +255,13 @@ public:
                              double b[], double h[], double p[]);
 
 protected:
+        void createEdges();
+        void tessellate(std::vector<RS_Vector>& points) const;
+
         RS_SplineData data;
+        /** Polyline approximating the curve, see getStrokePoints(). */
+        mutable std::vector<RS_Vector> strokePoints;
+        mutable bool strokePointsValid;
 }
 ;
 
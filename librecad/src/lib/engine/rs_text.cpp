@@ -30,6 +30,7 @@
 
 #include "rs_fontlist.h"
 #include "rs_insert.h"
+#include "rs_painter.h"
 
 /**
  * Constructor.
@@ -194,7 +195,7 @@ int RS_Text::getNumberOfLines() {
 
 
 /**
- * Updates the Inserts (letters) of this text. Called when the
+ * Updates the layout (letters) of this text. Called when the
  * text or it's data, position, alignment, .. changes.
  * This method also updates the usedTextWidth / usedTextHeight property.
  */
@@ -203,6 +204,7 @@ void RS_Text::update() {
     RS_DEBUG->print("RS_Text::update");
 
     clear();
+    layout.clear();
 
     if (isUndone()) {
         return;
@@ -221,11 +223,11 @@ void RS_Text::update() {
     RS_Vector letterSpace = RS_Vector(font->getLetterSpacing(), 0.0);
     RS_Vector space = RS_Vector(font->getWordSpacing(), 0.0);
 
-    // First every text line is created with
+    // First every text line is laid out with
     //   alignement: top left
     //   angle: 0
     //   height: 9.0
-    // Rotation, scaling and centering is done later
+    // Rotation, scaling and centering is done by the layout transformation
 
     // For every letter:
     for (int i=0; i<(int)data.text.length(); ++i) {
@@ -234,46 +236,28 @@ void RS_Text::update() {
             letterPos+=space;
         } else {
             // One Letter:
-            QString letterText = QString(data.text.at(i));
-            if (font->findLetter(letterText) == NULL) {
-                RS_DEBUG->print("RS_Text::update: missing font for letter( %s ), replaced it with QChar(0xfffd)",qPrintable(letterText));
-                letterText = QChar(0xfffd);
+            const LC_Glyph* glyph = font->findGlyph(QString(data.text.at(i)));
+            if (glyph==NULL) {
+                continue;
             }
             RS_DEBUG->print("RS_Text::update: insert a "
                             "letter at pos: %f/%f", letterPos.x, letterPos.y);
+            layout.addGlyph(glyph, letterPos);
 
-            RS_InsertData d(letterText,
-                            letterPos,
-                            RS_Vector(1.0, 1.0),
-                            0.0,
-                            1,1, RS_Vector(0.0,0.0),
-                            font->getLetterList(), RS2::NoUpdate);
-
-            RS_Insert* letter = new RS_Insert(this, d);
-            RS_Vector letterWidth;
-            letter->setPen(RS_Pen(RS2::FlagInvalid));
-            letter->setLayer(NULL);
-            letter->update();
-            letter->forcedCalculateBorders();
-
-            letterWidth = RS_Vector(letter->getMax().x-letterPos.x, 0.0);
+            RS_Vector letterWidth = RS_Vector(glyph->maxV.x, 0.0);
             if (letterWidth.x < 0)
                 letterWidth.x = -letterSpace.x;
 
-//            oneLine->addEntity(letter);
-            addEntity(letter);
-
             // next letter position:
             letterPos += letterWidth;
             letterPos += letterSpace;
         }
     }
 
-    if( ! RS_EntityContainer::autoUpdateBorders) {
-        //only update borders when needed
-        forcedCalculateBorders();
-    }
-    RS_Vector textSize = getSize();
+    RS_Vector textMin(0.0, 0.0);
+    RS_Vector textMax(0.0, 0.0);
+    layout.getBox(textMin, textMax);
+    RS_Vector textSize = textMax - textMin;
 
     RS_DEBUG->print("RS_Text::updateAddLine: width 2: %f", textSize.x);
 
@@ -306,7 +290,7 @@ void RS_Text::update() {
     // Horizontal Align:
     switch (data.halign) {
     case RS_TextData::HAMiddle:{
-        offset.move(RS_Vector(-textSize.x/2.0, -(vSize + textSize.y/2.0 + getMin().y) ));
+        offset.move(RS_Vector(-textSize.x/2.0, -(vSize + textSize.y/2.0 + textMin.y) ));
         break;}
     case RS_TextData::HACenter:
         RS_DEBUG->print("RS_Text::updateAddLine: move by: %f", -textSize.x/2.0);
@@ -323,30 +307,25 @@ void RS_Text::update() {
     if (data.halign!=RS_TextData::HAAligned && data.halign!=RS_TextData::HAFit){
         data.secondPoint = RS_Vector(offset.x, offset.y - vSize);
     }
-    RS_EntityContainer::move(offset);
+    layout.moveGlyphs(offset);
 
 
     // Scale:
+    RS_Vector factor;
     if (data.halign==RS_TextData::HAAligned){
         double dist = data.insertionPoint.distanceTo(data.secondPoint)/textSize.x;
         data.height = vSize*dist;
-        RS_EntityContainer::scale(RS_Vector(0.0,0.0),
-                        RS_Vector(dist, dist));
+        factor = RS_Vector(dist, dist);
     } else if (data.halign==RS_TextData::HAFit){
         double dist = data.insertionPoint.distanceTo(data.secondPoint)/textSize.x;
-        RS_EntityContainer::scale(RS_Vector(0.0,0.0),
-                        RS_Vector(dist, data.height/9.0));
+        factor = RS_Vector(dist, data.height/9.0);
     } else {
-        RS_EntityContainer::scale(RS_Vector(0.0,0.0),
-                        RS_Vector(data.height*data.widthRel/9.0, data.height/9.0));
-        data.secondPoint.scale(RS_Vector(0.0,0.0),
-                               RS_Vector(data.height*data.widthRel/9.0, data.height/9.0));
+        factor = RS_Vector(data.height*data.widthRel/9.0, data.height/9.0);
+        data.secondPoint.scale(RS_Vector(0.0,0.0), factor);
     }
 
-    forcedCalculateBorders();
-
     // Update actual text size (before rotating, after scaling!):
-    usedTextWidth = getSize().x;
+    usedTextWidth = fabs(textSize.x*factor.x);
     usedTextHeight = data.height;
 
     // Rotate:
@@ -357,17 +336,135 @@ void RS_Text::update() {
         data.secondPoint.rotate(RS_Vector(0.0,0.0), data.angle);
         data.secondPoint.move(data.insertionPoint);
     }
-    RS_EntityContainer::rotate(RS_Vector(0.0,0.0), data.angle);
 
     // Move to insertion point:
-    RS_EntityContainer::move(data.insertionPoint);
+    layout.setTransform(data.insertionPoint, factor, data.angle);
+    layout.updateBox();
 
-    forcedCalculateBorders();
+    // the borders of the text right away (e.g. for the label of a
+    // dimension), the ones of its containers by updateBorders():
+    invalidateBorders();
+    updateBorders();
 
     RS_DEBUG->print("RS_Text::update: OK");
 }
 
 
+
+/**
+ * Creates the letter inserts of this text from the layout. Only
+ * needed by code which resolves the text into its letters. The
+ * letters are removed again by update().
+ */
+void RS_Text::createLetters() {
+    if (!entities.isEmpty()) {
+        return;
+    }
+    for (size_t i=0; i<layout.count(); ++i) {
+        const LC_Glyph* glyph = layout.glyphAt(i);
+        RS_InsertData d(glyph->block->getName(),
+                        layout.toDrawing(layout.offsetAt(i)),
+                        layout.getFactor(),
+                        layout.getAngle(),
+                        1,1, RS_Vector(0.0,0.0),
+                        glyph->font->getLetterList(), RS2::NoUpdate);
+
+        RS_Insert* letter = new RS_Insert(this, d);
+        letter->setPen(RS_Pen(RS2::FlagInvalid));
+        letter->setLayer(NULL);
+        letter->update();
+        if (isSelected()) {
+            letter->setSelected(true);
+        }
+        // borders are the same as the borders of the layout:
+        entities.append(letter);
+    }
+}
+
+
+
+RS_Entity* RS_Text::firstEntity(RS2::ResolveLevel level) {
+    if (level!=RS2::ResolveNone) {
+        createLetters();
+    }
+    return RS_EntityContainer::firstEntity(level);
+}
+
+
+
+RS_Entity* RS_Text::lastEntity(RS2::ResolveLevel level) {
+    if (level!=RS2::ResolveNone) {
+        createLetters();
+    }
+    return RS_EntityContainer::lastEntity(level);
+}
+
+
+
+RS_Entity* RS_Text::entityAt(int index) {
+    createLetters();
+    return RS_EntityContainer::entityAt(index);
+}
+
+
+
+bool RS_Text::isEmpty() {
+    return layout.isEmpty();
+}
+
+
+
+unsigned int RS_Text::countDeep() {
+    return layout.countDeep();
+}
+
+
+
+void RS_Text::calculateBorders() {
+    delFlag(RS2::FlagBordersDirty);
+    resetBorders();
+    layout.extendBorders(minV, maxV);
+    if (layout.isEmpty()) {
+        minV = maxV = RS_Vector(0.0, 0.0);
+    }
+}
+
+
+
+/**
+ * The distance is taken from the glyph outlines. Resolving into the
+ * letters creates the letter inserts.
+ */
+double RS_Text::getDistanceToPoint(const RS_Vector& coord,
+                                   RS_Entity** entity,
+                                   RS2::ResolveLevel level,
+                                   double solidDist) const {
+    if (level!=RS2::ResolveNone) {
+        const_cast<RS_Text*>(this)->createLetters();
+        return RS_EntityContainer::getDistanceToPoint(coord, entity, level, solidDist);
+    }
+    if (entity!=NULL) {
+        *entity = const_cast<RS_Text*>(this);
+    }
+    return layout.getDistanceToPoint(coord);
+}
+
+
+
+RS_Vector RS_Text::getNearestDist(double distance,
+                                  const RS_Vector& coord,
+                                  double* dist) {
+    createLetters();
+    RS_Entity* letter = NULL;
+    RS_EntityContainer::getDistanceToPoint(coord, &letter, RS2::ResolveNone);
+    if (letter==NULL) {
+        return RS_Vector(false);
+    }
+    return letter->getNearestDist(distance, coord, dist);
+}
+
+
+
 RS_Vector RS_Text::getNearestEndpoint(const RS_Vector& coord, double* dist)const {
     if (dist!=NULL) {
         *dist = data.insertionPoint.distanceTo(coord);
@@ -392,6 +489,7 @@ RS_Vector RS_Text::getNearestRef(const RS_Vector& coord,
 
 void RS_Text::move(const RS_Vector& offset) {
     RS_EntityContainer::move(offset);
+    layout.move(offset);
     data.insertionPoint.move(offset);
     data.secondPoint.move(offset);
 //    update();
@@ -402,6 +500,7 @@ void RS_Text::move(const RS_Vector& offset) {
 void RS_Text::rotate(const RS_Vector& center, const double& angle) {
     RS_Vector angleVector(angle);
     RS_EntityContainer::rotate(center, angleVector);
+    layout.rotate(center, angleVector);
     data.insertionPoint.rotate(center, angleVector);
     data.secondPoint.rotate(center, angleVector);
     data.angle = RS_Math::correctAngle(data.angle+angle);
@@ -409,6 +508,7 @@ void RS_Text::rotate(const RS_Vector& center, const double& angle) {
 }
 void RS_Text::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
     RS_EntityContainer::rotate(center, angleVector);
+    layout.rotate(center, angleVector);
     data.insertionPoint.rotate(center, angleVector);
     data.secondPoint.rotate(center, angleVector);
     data.angle = RS_Math::correctAngle(data.angle+angleVector.angle());
@@ -484,6 +584,21 @@ void RS_Text::stretch(const RS_Vector& firstCorner, const RS_Vector& secondCorne
 
 
 
+void RS_Text::draw(RS_Painter* painter, RS_GraphicView* view, double& /*patternOffset*/) {
+    if (painter==NULL || view==NULL) {
+        return;
+    }
+
+    // containers are not filtered by RS_GraphicView::drawEntityPlain():
+    if (isSelected()!=painter->shouldDrawSelected()) {
+        return;
+    }
+
+    layout.draw(painter, view, getPen(true), isSelected());
+}
+
+
+
 /**
  * Dumps the point's data to stdout.
  */
@@ -29,6 +29,7 @@
 #define RS_TEXT_H
 
 #include "rs_entitycontainer.h"
+#include "lc_textlayout.h"
 
 /**
  * Holds the data that defines a text entity.
@@ -181,6 +182,7 @@ public:
     }
 
     void update();
+    void createLetters();
 
     int getNumberOfLines();
 
@@ -257,6 +259,23 @@ public:
     virtual RS_VectorSolutions getRefPoints();
     virtual RS_Vector getNearestRef(const RS_Vector& coord,
                                     double* dist = NULL);
+    virtual RS_Vector getNearestDist(double distance,
+                                     const RS_Vector& coord,
+                                     double* dist = NULL);
+    virtual double getDistanceToPoint(const RS_Vector& coord,
+                                      RS_Entity** entity,
+                                      RS2::ResolveLevel level=RS2::ResolveNone,
+                                      double solidDist = RS_MAXDOUBLE) const;
+
+    virtual RS_Entity* firstEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* lastEntity(RS2::ResolveLevel level=RS2::ResolveNone);
+    virtual RS_Entity* entityAt(int index);
+    virtual bool isEmpty();
+    virtual unsigned int countDeep();
+    virtual void calculateBorders();
+    virtual void forcedCalculateBorders() {
+        calculateBorders();
+    }
 
     virtual void move(const RS_Vector& offset);
     virtual void rotate(const RS_Vector& center, const double& angle);
@@ -268,11 +287,19 @@ public:
                          const RS_Vector& secondCorner,
                          const RS_Vector& offset);
 
+    virtual void draw(RS_Painter* painter, RS_GraphicView* view, double& patternOffset);
+
     friend std::ostream& operator << (std::ostream& os, const RS_Text& p);
 
 protected:
     RS_TextData data;
 
+    /**
+     * Letters of the text. Drawing and borders use the layout, the
+     * letter inserts are only created by createLetters().
+     */
+    LC_TextLayout layout;
+
     /**
      * Text width used by the current contents of this text entity.
      * This property is updated by the update method.
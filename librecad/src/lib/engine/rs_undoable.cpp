@@ -39,6 +39,16 @@ RS_Undoable::RS_Undoable() {
 
 
 
+/**
+ * Copy constructor. A copy is not part of the undo cycle of the original.
+ */
+RS_Undoable::RS_Undoable(const RS_Undoable& u)
+    : RS_Flags(u) {
+    cycle = NULL;
+}
+
+
+
 /**
  * Destructor. Makes sure that this undoable is removed from 
  * its undo cycle before it is deleted.
@@ -51,6 +61,16 @@ RS_Undoable::~RS_Undoable() {
 
 
 
+/**
+ * Assigns the flags of u, this undoable stays in its own undo cycle.
+ */
+RS_Undoable& RS_Undoable::operator = (const RS_Undoable& u) {
+    RS_Flags::operator = (u);
+    return *this;
+}
+
+
+
 /**
  * Sets the undo cycle this entity is in. This is necessary to
  * make sure the entity can remove itself from the cycle before
@@ -44,7 +44,9 @@ class RS_UndoCycle;
 class RS_Undoable : public RS_Flags {
 public:
     RS_Undoable();
+    RS_Undoable(const RS_Undoable& u);
     virtual ~RS_Undoable();
+    RS_Undoable& operator = (const RS_Undoable& u);
 
     /**
      * Runtime type identification for undoables.
@@ -32,6 +32,7 @@
 #include "rs_debug.h"
 #include "rs_math.h"
 #include "rs_constructionline.h"
+#include "lc_vectorops.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h" /* remainder() */
@@ -886,52 +887,32 @@ bool RS_VectorSolutions::isTangent() const {
  * Rotates all vectors around (0,0) by the given angle.
  */
 void RS_VectorSolutions::rotate(const double& ang) {
-    RS_Vector angleVector(ang);
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-            vector[i].rotate(angleVector);
-        }
-    }
+    rotate(RS_Vector(ang));
 }
 
 /**
  * Rotates all vectors around (0,0) by the given angleVector.
  */
 void RS_VectorSolutions::rotate(const RS_Vector& angleVector) {
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-                //To be a real rotation, the determinant of angleVector has to be 1 for a pure rotation
-            vector[i].rotate(angleVector);
-        }
-    }
+    //To be a real rotation, the determinant of angleVector has to be 1 for a pure rotation
+    LC_VectorOps::rotate(vector.begin(), vector.end(), RS_Vector(0., 0.), angleVector);
 }
 
 /**
  * Rotates all vectors around the given center by the given angle.
  */
 void RS_VectorSolutions::rotate(const RS_Vector& center, const double& ang) {
-    RS_Vector angleVector(ang);
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-            vector[i].rotate(center,angleVector);
-        }
-    }
+    rotate(center, RS_Vector(ang));
 }
 void RS_VectorSolutions::rotate(const RS_Vector& center, const RS_Vector& angleVector) {
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-            vector[i].rotate(center,angleVector);
-        }
-    }
+    LC_VectorOps::rotate(vector.begin(), vector.end(), center, angleVector);
 }
 
 /**
  * Move all vectors around the given center by the given vector.
  */
 void RS_VectorSolutions::move(const RS_Vector& vp) {
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) vector[i].move(vp);
-    }
+    LC_VectorOps::move(vector.begin(), vector.end(), vp);
 }
 
 
@@ -939,18 +920,10 @@ void RS_VectorSolutions::move(const RS_Vector& vp) {
  * Scales all vectors by the given factors with the given center.
  */
 void RS_VectorSolutions::scale(const RS_Vector& center, const RS_Vector& factor) {
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-            vector[i].scale(center, factor);
-        }
-    }
+    LC_VectorOps::scale(vector.begin(), vector.end(), center, factor);
 }
 void RS_VectorSolutions::scale( const RS_Vector& factor) {
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-            vector[i].scale(factor);
-        }
-    }
+    LC_VectorOps::scale(vector.begin(), vector.end(), RS_Vector(0., 0.), factor);
 }
 
 
@@ -961,30 +934,19 @@ void RS_VectorSolutions::scale( const RS_Vector& factor) {
 RS_Vector RS_VectorSolutions::getClosest(const RS_Vector& coord,
                                          double* dist, int* index) const {
 
-    double curDist(0.);
-    double minDist = RS_MAXDOUBLE;
-    RS_Vector closestPoint(false);
-    int pos(0);
+    double minDist(0.);
+    QVector<RS_Vector>::const_iterator it =
+            LC_VectorOps::closest(vector.constBegin(), vector.constEnd(), coord, &minDist);
 
-    for (int i=0; i<vector.size(); i++) {
-        if (vector[i].valid) {
-            curDist = (coord - vector[i]).squared();
-
-            if (curDist<minDist) {
-                closestPoint = vector[i];
-                minDist = curDist;
-                pos=i;
-            }
-        }
-    }
     if (dist!=NULL) {
         *dist = sqrt(minDist);
     }
     if (index!=NULL) {
-        *index = pos;
+        *index = it==vector.constEnd() ? 0 : it - vector.constBegin();
     }
-    return closestPoint;
+    return it==vector.constEnd() ? RS_Vector(false) : *it;
 }
+
 /**
   *@ return the closest distance from the first counts rs_vectors
   *@coord, distance to this point
@@ -993,14 +955,12 @@ RS_Vector RS_VectorSolutions::getClosest(const RS_Vector& coord,
 double RS_VectorSolutions::getClosestDistance(const RS_Vector& coord,
         int counts)
 {
-    double ret=RS_MAXDOUBLE*RS_MAXDOUBLE;
     int i=vector.size();
     if (counts<i && counts>=0) i=counts;
-    for(int j=0; j<i; j++) {
-        if(vector[j].valid) {
-            double d=(coord - vector[j]).squared();
-            if(d<ret) ret=d;
-        }
+    double ret(0.);
+    if (LC_VectorOps::closest(vector.constBegin(), vector.constBegin() + i,
+                              coord, &ret) == vector.constBegin() + i) {
+        return RS_MAXDOUBLE;
     }
     return sqrt(ret);
 }
@@ -29,6 +29,7 @@
 #include <memory>
 #include <cstddef>
 #include "rs_fileio.h"
+#include "lc_profiler.h"
 
 
   RS_FileIO::RS_FileIO()
@@ -62,7 +63,10 @@ bool RS_FileIO::fileImport(RS_Graphic& graphic, const QString& file,
     if (RS2::FormatUnknown != t) {
         std::unique_ptr<RS_FilterInterface> filter(getImportFilter(file, t));
         if (filter.get() != NULL ){
-            return filter->fileImport(graphic, file, t);
+            LC_PROFILE_SCOPE("file/import");
+            bool ret = filter->fileImport(graphic, file, t);
+            LC_PROFILE_COUNT("file/imported entities", graphic.count());
+            return ret;
         }
         RS_DEBUG->print(RS_Debug::D_WARNING,
                         "RS_FileIO::fileImport: failed to import file: %s",
@@ -108,6 +112,7 @@ bool RS_FileIO::fileExport(RS_Graphic& graphic, const QString& file,
 
     std::unique_ptr<RS_FilterInterface> filter(getExportFilter(file, type));
     if (filter.get() != NULL ){
+        LC_PROFILE_SCOPE("file/export");
         return filter->fileExport(graphic, file, type);
     }
     RS_DEBUG->print("RS_FileIO::fileExport: no filter found");
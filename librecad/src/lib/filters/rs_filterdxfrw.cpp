@@ -62,6 +62,7 @@ RS_FilterDXFRW::RS_FilterDXFRW()
 
     currentContainer = NULL;
     graphic = NULL;
+    exportBinary = false;
 // Init hash to change the QCAD "normal" style to the more correct ISO-3059
 // or draftsight symbol (AR*.shx) to sy*.lff
     fontList["normal"] = "iso";
@@ -105,6 +106,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
     graphic = &g;
     currentContainer = graphic;
     dummyContainer = new RS_EntityContainer(NULL, true);
+    clearInternedNames();
 
     this->file = file;
     // add some variables that need to be there for DXF drawings:
@@ -150,6 +152,7 @@ bool RS_FilterDXFRW::fileImport(RS_Graphic& g, const QString& file, RS2::FormatT
 #endif
 
     delete dummyContainer;
+    clearInternedNames();
     /*set current layer */
     RS_Layer* cl = graphic->findLayer(graphic->getVariableString("$CLAYER", "0"));
     if (cl != NULL){
@@ -502,9 +505,9 @@ void RS_FilterDXFRW::addLWPolyline(const DRW_LWPolyline& data) {
 
     QList< QPair<RS_Vector*, double> > verList;
     for (unsigned int i=0; i<data.vertlist.size(); i++) {
-        DRW_Vertex2D *vert = data.vertlist.at(i);
-        RS_Vector *v = new RS_Vector(vert->x, vert->y);
-        verList.append(qMakePair(v, vert->bulge));
+        const DRW_Vertex2D &vert = data.vertlist.at(i);
+        RS_Vector *v = new RS_Vector(vert.x, vert.y);
+        verList.append(qMakePair(v, vert.bulge));
     }
     polyline->appendVertexs(verList);
     while (!verList.isEmpty())
@@ -561,8 +564,8 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
 
 		for(unsigned int i = 0; i < data->controllist.size(); i++)
 		{
-			DRW_Coord *vert = data->controllist.at(i);
-			RS_Vector v(vert->x, vert->y);
+			const DRW_Coord &vert = data->controllist.at(i);
+			RS_Vector v(vert.x, vert.y);
 			splinePoints->addControlPoint(v);
 		}
 		splinePoints->update();
@@ -583,8 +586,8 @@ void RS_FilterDXFRW::addSpline(const DRW_Spline* data) {
         return;
     }
     for (unsigned int i=0; i<data->controllist.size(); i++) {
-        DRW_Coord *vert = data->controllist.at(i);
-        RS_Vector v(vert->x, vert->y);
+        const DRW_Coord &vert = data->controllist.at(i);
+        RS_Vector v(vert.x, vert.y);
         spline->addControlPoint(v);
     }
     spline->update();
@@ -604,7 +607,7 @@ void RS_FilterDXFRW::addInsert(const DRW_Insert& data) {
 
     //cout << "Insert: " << name << " " << ip << " " << cols << "/" << rows << endl;
 
-    RS_InsertData d( QString::fromUtf8(data.name.c_str()),
+    RS_InsertData d( internBlockName(data.name),
                     ip, sc, data.angle/ARAD,
                     data.colcount, data.rowcount,
                     sp, NULL, RS2::NoUpdate);
@@ -1003,8 +1006,8 @@ void RS_FilterDXFRW::addLeader(const DRW_Leader *data) {
     setEntityAttributes(leader, data);
 
     for (unsigned int i=0; i<data->vertexlist.size(); i++) {
-        DRW_Coord *vert = data->vertexlist.at(i);
-        RS_Vector v(vert->x, vert->y);
+        const DRW_Coord &vert = data->vertexlist.at(i);
+        RS_Vector v(vert.x, vert.y);
         leader->addVertex(v);
     }
 
@@ -1030,7 +1033,7 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
     currentContainer->appendEntity(hatch);
 
     for (unsigned int i=0; i < data->looplist.size(); i++) {
-        DRW_HatchLoop *loop = data->looplist.at(i);
+        DRW_HatchLoop *loop = data->looplist.at(i).get();
         if ((loop->type & 32) == 32) continue;
         hatchLoop = new RS_EntityContainer(hatch);
         hatchLoop->setLayer(NULL);
@@ -1038,12 +1041,12 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
 
         RS_Entity* e = NULL;
         if ((loop->type & 2) == 2){   //polyline, convert to lines & arcs
-            DRW_LWPolyline *pline = (DRW_LWPolyline *)loop->objlist.at(0);
+            DRW_LWPolyline *pline = (DRW_LWPolyline *)loop->objlist.at(0).get();
             RS_Polyline *polyline = new RS_Polyline(NULL,
                     RS_PolylineData(RS_Vector(false), RS_Vector(false), pline->flags) );
             for (unsigned int j=0; j < pline->vertlist.size(); j++) {
-                    DRW_Vertex2D *vert = pline->vertlist.at(j);
-                    polyline->addVertex(RS_Vector(vert->x, vert->y), vert->bulge);
+                    const DRW_Vertex2D &vert = pline->vertlist.at(j);
+                    polyline->addVertex(RS_Vector(vert.x, vert.y), vert.bulge);
             }
             for (RS_Entity* e=polyline->firstEntity(); e!=NULL;
                     e=polyline->nextEntity()) {
@@ -1057,7 +1060,7 @@ void RS_FilterDXFRW::addHatch(const DRW_Hatch *data) {
         } else {
             for (unsigned int j=0; j<loop->objlist.size(); j++) {
                 e = NULL;
-                DRW_Entity *ent = loop->objlist.at(j);
+                DRW_Entity *ent = loop->objlist.at(j).get();
                 switch (ent->eType) {
                 case DRW::LINE: {
                     DRW_Line *e2 = (DRW_Line *)ent;
@@ -1351,9 +1354,10 @@ bool RS_FilterDXFRW::fileExport(RS_Graphic& g, const QString& file, RS2::FormatT
     }
 
     dxfW = new dxfRW(QFile::encodeName(file));
-    bool success = dxfW->write(this, exportVersion, false); //ascii
-//    bool success = dxf->write(this, exportVersion, true); //binary
+    bool success = dxfW->write(this, exportVersion, exportBinary);
     delete dxfW;
+    exportLayerNames.clear();
+    exportLineTypeNames.clear();
 
     if (!success) {
         RS_DEBUG->print("RS_FilterDXFDW::fileExport: can't write file");
@@ -1544,6 +1548,8 @@ void RS_FilterDXFRW::writeHeader(DRW_Header& data){
             }
             ++it;
     }
+    // borders of edited entities are only recalculated on demand:
+    graphic->updateBorders();
     v = graphic->getMin();
     data.addCoord("$EXTMIN", DRW_Coord(v.x, v.y, 0.0), 0);
     v = graphic->getMax();
@@ -1969,11 +1975,8 @@ void RS_FilterDXFRW::writeEntity(RS_Entity* e){
  * Writes the given Point entity to the file.
  */
 void RS_FilterDXFRW::writePoint(RS_Point* p) {
-    DRW_Point point;
-    getEntityAttributes(&point, p);
-    point.basePoint.x = p->getStartpoint().x;
-    point.basePoint.y = p->getStartpoint().y;
-    dxfW->writePoint(&point);
+    dxfW->streamPoint(getEntityStyle(p),
+                      p->getStartpoint().x, p->getStartpoint().y);
 }
 
 
@@ -1981,13 +1984,9 @@ void RS_FilterDXFRW::writePoint(RS_Point* p) {
  * Writes the given Line( entity to the file.
  */
 void RS_FilterDXFRW::writeLine(RS_Line* l) {
-    DRW_Line line;
-    getEntityAttributes(&line, l);
-    line.basePoint.x = l->getStartpoint().x;
-    line.basePoint.y = l->getStartpoint().y;
-    line.secPoint.x = l->getEndpoint().x;
-    line.secPoint.y = l->getEndpoint().y;
-    dxfW->writeLine(&line);
+    const RS_Vector& start = l->getStartpoint();
+    const RS_Vector& end = l->getEndpoint();
+    dxfW->streamLine(getEntityStyle(l), start.x, start.y, end.x, end.y);
 }
 
 
@@ -1995,12 +1994,8 @@ void RS_FilterDXFRW::writeLine(RS_Line* l) {
  * Writes the given circle entity to the file.
  */
 void RS_FilterDXFRW::writeCircle(RS_Circle* c) {
-    DRW_Circle circle;
-    getEntityAttributes(&circle, c);
-    circle.basePoint.x = c->getCenter().x;
-    circle.basePoint.y = c->getCenter().y;
-    circle.radious = c->getRadius();
-    dxfW->writeCircle(&circle);
+    dxfW->streamCircle(getEntityStyle(c),
+                       c->getCenter().x, c->getCenter().y, c->getRadius());
 }
 
 
@@ -2008,19 +2003,13 @@ void RS_FilterDXFRW::writeCircle(RS_Circle* c) {
  * Writes the given arc entity to the file.
  */
 void RS_FilterDXFRW::writeArc(RS_Arc* a) {
-    DRW_Arc arc;
-    getEntityAttributes(&arc, a);
-    arc.basePoint.x = a->getCenter().x;
-    arc.basePoint.y = a->getCenter().y;
-    arc.radious = a->getRadius();
+    double staangle = a->getAngle1();
+    double endangle = a->getAngle2();
     if (a->isReversed()) {
-        arc.staangle = a->getAngle2();
-        arc.endangle = a->getAngle1();
-    } else {
-        arc.staangle = a->getAngle1();
-        arc.endangle = a->getAngle2();
+        std::swap(staangle, endangle);
     }
-    dxfW->writeArc(&arc);
+    dxfW->streamArc(getEntityStyle(a), a->getCenter().x, a->getCenter().y,
+                    a->getRadius(), staangle, endangle);
 }
 
 
@@ -2033,44 +2022,40 @@ void RS_FilterDXFRW::writeLWPolyline(RS_Polyline* l) {
         writePolyline(l);
         return;
     }
-    DRW_LWPolyline pol;
-    RS_Entity* currEntity = 0;
-    RS_Entity* nextEntity = 0;
-    RS_AtomicEntity* ae = NULL;
-    double bulge=0.0;
-
+    // the vertices are streamed, count them first for group code 90
+    int vertexnum = 0;
+    RS_AtomicEntity* last = NULL;
     for (RS_Entity* e=l->firstEntity(RS2::ResolveNone);
-         e!=NULL; e=nextEntity) {
-
-        currEntity = e;
-        nextEntity = l->nextEntity(RS2::ResolveNone);
+         e!=NULL; e=l->nextEntity(RS2::ResolveNone)) {
+        if (e->isAtomic()) {
+            last = (RS_AtomicEntity*)e;
+            ++vertexnum;
+        }
+    }
+    if (last==NULL) {
+        return;
+    }
+    if (!l->isClosed()) {
+        ++vertexnum;
+    }
 
+    dxfW->streamLWPolyline(getEntityStyle(l), vertexnum, l->isClosed() ? 1 : 0);
+    double bulge=0.0;
+    for (RS_Entity* e=l->firstEntity(RS2::ResolveNone);
+         e!=NULL; e=l->nextEntity(RS2::ResolveNone)) {
         if (!e->isAtomic()) {
             continue;
         }
-        ae = (RS_AtomicEntity*)e;
-
-        // Write vertex:
-            if (e->rtti()==RS2::EntityArc) {
-                bulge = ((RS_Arc*)e)->getBulge();
-            } else
-                bulge = 0.0;
-            pol.addVertex( DRW_Vertex2D(ae->getStartpoint().x,
-                                      ae->getStartpoint().y, bulge));
+        RS_AtomicEntity* ae = (RS_AtomicEntity*)e;
+        if (e->rtti()==RS2::EntityArc) {
+            bulge = ((RS_Arc*)e)->getBulge();
+        } else
+            bulge = 0.0;
+        dxfW->streamVertex2D(ae->getStartpoint().x, ae->getStartpoint().y, bulge);
     }
-    if (l->isClosed()) {
-        pol.flags = 1;
-    } else {
-        ae = (RS_AtomicEntity*)currEntity;
-        if (ae->rtti()==RS2::EntityArc) {
-            bulge = ((RS_Arc*)ae)->getBulge();
-        }
-        pol.addVertex( DRW_Vertex2D(ae->getEndpoint().x,
-                                  ae->getEndpoint().y, bulge));
+    if (!l->isClosed()) {
+        dxfW->streamVertex2D(last->getEndpoint().x, last->getEndpoint().y, bulge);
     }
-    pol.vertexnum = pol.vertlist.size();
-    getEntityAttributes(&pol, l);
-    dxfW->writeLWPolyline(&pol);
 }
 
 /**
@@ -2173,11 +2158,9 @@ void RS_FilterDXFRW::writeSpline(RS_Spline *s) {
 
     // write spline control points:
     QList<RS_Vector> cp = s->getControlPoints();
+    sp.controllist.reserve(cp.size());
     for (int i = 0; i < cp.size(); ++i) {
-        DRW_Coord *controlpoint = new DRW_Coord();
-        sp.controllist.push_back(controlpoint);
-        controlpoint->x = cp.at(i).x;
-        controlpoint->y = cp.at(i).y;
+        sp.controllist.push_back(DRW_Coord(cp.at(i).x, cp.at(i).y, 0.0));
      }
     getEntityAttributes(&sp, s);
     dxfW->writeSpline(&sp);
@@ -2253,12 +2236,10 @@ void RS_FilterDXFRW::writeSplinePoints(LC_SplinePoints *s)
 	}
 
 	// write spline control points:
+	sp.controllist.reserve(cp.size());
 	for(int i = 0; i < cp.size(); ++i)
 	{
-		DRW_Coord *controlpoint = new DRW_Coord();
-		sp.controllist.push_back(controlpoint);
-		controlpoint->x = cp.at(i).x;
-		controlpoint->y = cp.at(i).y;
+		sp.controllist.push_back(DRW_Coord(cp.at(i).x, cp.at(i).y, 0.0));
 	}
 	getEntityAttributes(&sp, s);
 	dxfW->writeSpline(&sp);
@@ -2587,11 +2568,11 @@ void RS_FilterDXFRW::writeLeader(RS_Leader* l) {
             v!=NULL;   v=l->nextEntity(RS2::ResolveNone)) {
         if (v->rtti()==RS2::EntityLine) {
             li = (RS_Line*)v;
-            leader.vertexlist.push_back(new DRW_Coord(li->getStartpoint().x, li->getStartpoint().y, 0.0));
+            leader.vertexlist.push_back(DRW_Coord(li->getStartpoint().x, li->getStartpoint().y, 0.0));
         }
     }
     if (li != NULL) {
-        leader.vertexlist.push_back(new DRW_Coord(li->getEndpoint().x, li->getEndpoint().y, 0.0));
+        leader.vertexlist.push_back(DRW_Coord(li->getEndpoint().x, li->getEndpoint().y, 0.0));
     }
     dxfW->writeLeader(&leader);
 }
@@ -2678,7 +2659,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
                     line->basePoint.y = ln->getStartpoint().y;
                     line->secPoint.x = ln->getEndpoint().x;
                     line->secPoint.y = ln->getEndpoint().y;
-                    lData->objlist.push_back(line);
+                    lData->objlist.push_back(std::shared_ptr<DRW_Entity>(line));
                 } else if (ed->rtti()==RS2::EntityArc) {
                     RS_Arc* ar = (RS_Arc*)ed;
                     DRW_Arc *arc = new DRW_Arc();
@@ -2694,7 +2675,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
                         arc->endangle = 2*M_PI-ar->getAngle2();
                         arc->isccw = false;
                     }
-                    lData->objlist.push_back(arc);
+                    lData->objlist.push_back(std::shared_ptr<DRW_Entity>(arc));
                 } else if (ed->rtti()==RS2::EntityCircle) {
                     RS_Circle* ci = (RS_Circle*)ed;
                     DRW_Arc *arc= new DRW_Arc();
@@ -2704,7 +2685,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
                     arc->staangle = 0.0;
                     arc->endangle = 2*M_PI; //2*M_PI;
                     arc->isccw = true;
-                    lData->objlist.push_back(arc);
+                    lData->objlist.push_back(std::shared_ptr<DRW_Entity>(arc));
                 } else if (ed->rtti()==RS2::EntityEllipse) {
                     RS_Ellipse* el = (RS_Ellipse*)ed;
                     DRW_Ellipse *ell= new DRW_Ellipse();
@@ -2721,7 +2702,7 @@ void RS_FilterDXFRW::writeHatch(RS_Hatch * h) {
                     ell->staparam = startAng;
                     ell->endparam = endAng;
                     ell->isccw = !el->isReversed();
-                    lData->objlist.push_back(ell);
+                    lData->objlist.push_back(std::shared_ptr<DRW_Entity>(ell));
                 }
             }
             lData->update(); //change to DRW_HatchLoop
@@ -2863,15 +2844,7 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
     RS_Pen pen;
     pen.setColor(Qt::black);
     pen.setLineType(RS2::SolidLine);
-    QString layName = toNativeString(QString::fromUtf8(attrib->layer.c_str()));
-
-    // Layer: add layer in case it doesn't exist:
-    if (graphic->findLayer(layName)==NULL) {
-        DRW_Layer lay;
-        lay.name = attrib->layer;
-        addLayer(lay);
-    }
-    entity->setLayer(layName);
+    entity->setLayer(internLayer(attrib->layer));
 
     // Color:
     if (attrib->color24 >= 0)
@@ -2882,7 +2855,7 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
     pen.setColor(numberToColor(attrib->color));
 
     // Linetype:
-    pen.setLineType(nameToLineType( QString::fromUtf8(attrib->lineType.c_str()) ));
+    pen.setLineType(internLineType(attrib->lineType));
 
     // Width:
     pen.setWidth(numberToWidth(attrib->lWeight));
@@ -2893,21 +2866,89 @@ void RS_FilterDXFRW::setEntityAttributes(RS_Entity* entity,
 
 
 
+/**
+ * @return The layer for the given layer name from the file. The layer
+ * is created if it doesn't exist yet. The name is converted and looked
+ * up only the first time it is seen during an import.
+ */
+RS_Layer* RS_FilterDXFRW::internLayer(const std::string& name) {
+    std::unordered_map<std::string, RS_Layer*>::const_iterator it =
+            layerNames.find(name);
+    if (it != layerNames.end()) {
+        return it->second;
+    }
+
+    QString layName = toNativeString(QString::fromUtf8(name.c_str()));
+
+    // Layer: add layer in case it doesn't exist:
+    if (graphic->findLayer(layName)==NULL) {
+        DRW_Layer lay;
+        lay.name = name;
+        addLayer(lay);
+    }
+    RS_Layer* layer = graphic->findLayer(layName);
+    layerNames[name] = layer;
+    return layer;
+}
+
+
+
+/**
+ * @return The line type for the given line type name from the file.
+ */
+RS2::LineType RS_FilterDXFRW::internLineType(const std::string& name) {
+    std::unordered_map<std::string, RS2::LineType>::const_iterator it =
+            lineTypeNames.find(name);
+    if (it != lineTypeNames.end()) {
+        return it->second;
+    }
+
+    RS2::LineType lt = nameToLineType(QString::fromUtf8(name.c_str()));
+    lineTypeNames[name] = lt;
+    return lt;
+}
+
+
+
+/**
+ * @return The block name for the given block name from the file.
+ * All inserts of the same block share the returned string data.
+ *
+ * Only the name is kept, not the block itself since anonymous
+ * blocks might be removed again in endBlock(). Inserts resolve their
+ * block through the (hashed) block list.
+ */
+QString RS_FilterDXFRW::internBlockName(const std::string& name) {
+    std::unordered_map<std::string, QString>::const_iterator it =
+            blockNames.find(name);
+    if (it != blockNames.end()) {
+        return it->second;
+    }
+
+    QString blkName = QString::fromUtf8(name.c_str());
+    blockNames[name] = blkName;
+    return blkName;
+}
+
+
+
+/**
+ * Forgets all names resolved during the last import.
+ */
+void RS_FilterDXFRW::clearInternedNames() {
+    layerNames.clear();
+    lineTypeNames.clear();
+    blockNames.clear();
+}
+
+
+
 /**
  * Gets the entities attributes as a DL_Attributes object.
  */
 void RS_FilterDXFRW::getEntityAttributes(DRW_Entity* ent, const RS_Entity* entity) {
 //DRW_Entity RS_FilterDXFRW::getEntityAttributes(RS_Entity* /*entity*/) {
 
-    // Layer:
-    RS_Layer* layer = entity->getLayer();
-    QString layerName;
-    if (layer!=NULL) {
-        layerName = layer->getName();
-    } else {
-        layerName = "0";
-    }
-
     RS_Pen pen = entity->getPen(false);
 
     // Color:
@@ -2915,17 +2956,68 @@ void RS_FilterDXFRW::getEntityAttributes(DRW_Entity* ent, const RS_Entity* entit
     int color = colorToNumber(pen.getColor(), &exact_rgb);
     //printf("Color is: %s -> %d\n", pen.getColor().name().toLatin1().data(), color);
 
-    // Linetype:
-    QString lineType = lineTypeToName(pen.getLineType());
-
     // Width:
     DRW_LW_Conv::lineWidth width = widthToNumber(pen.getWidth());
 
-    ent->layer = toDxfString(layerName).toUtf8().data();
+    ent->layer = exportLayerName(entity->getLayer());
     ent->color = color;
     ent->color24 = exact_rgb;
     ent->lWeight = width;
-    ent->lineType = lineType.toUtf8().data();
+    ent->lineType = exportLineTypeName(pen.getLineType());
+}
+
+
+
+/**
+ * Gets the entities attributes for the streaming writers of dxfRW.
+ * The names are referenced from the export name caches.
+ */
+dxfRW::EntityStyle RS_FilterDXFRW::getEntityStyle(const RS_Entity* entity) {
+    RS_Pen pen = entity->getPen(false);
+
+    dxfRW::EntityStyle style;
+    style.color = colorToNumber(pen.getColor(), &style.color24);
+    style.lWeight = widthToNumber(pen.getWidth());
+    style.layer = &exportLayerName(entity->getLayer());
+    style.lineType = &exportLineTypeName(pen.getLineType());
+    return style;
+}
+
+
+
+/**
+ * @return Name of the given layer as written to the file. The name of
+ * every layer is converted only once per export.
+ */
+const std::string& RS_FilterDXFRW::exportLayerName(const RS_Layer* layer) {
+    std::unordered_map<const RS_Layer*, std::string>::const_iterator it =
+            exportLayerNames.find(layer);
+    if (it != exportLayerNames.end()) {
+        return it->second;
+    }
+
+    QString layerName;
+    if (layer!=NULL) {
+        layerName = layer->getName();
+    } else {
+        layerName = "0";
+    }
+    return exportLayerNames[layer] = toDxfString(layerName).toUtf8().data();
+}
+
+
+
+/**
+ * @return Name of the given line type as written to the file.
+ */
+const std::string& RS_FilterDXFRW::exportLineTypeName(RS2::LineType lineType) {
+    std::unordered_map<int, std::string>::const_iterator it =
+            exportLineTypeNames.find(lineType);
+    if (it != exportLineTypeNames.end()) {
+        return it->second;
+    }
+
+    return exportLineTypeNames[lineType] = lineTypeToName(lineType).toUtf8().data();
 }
 
 
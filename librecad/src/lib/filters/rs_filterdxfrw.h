@@ -26,6 +26,8 @@
 #ifndef RS_FILTERDXFRW_H
 #define RS_FILTERDXFRW_H
 
+#include <unordered_map>
+
 #include "rs_filterinterface.h"
 
 #include "rs_block.h"
@@ -159,6 +161,7 @@ public:
 
     void setEntityAttributes(RS_Entity* entity, const DRW_Entity* attrib);
     void getEntityAttributes(DRW_Entity* ent, const RS_Entity* entity);
+    dxfRW::EntityStyle getEntityStyle(const RS_Entity* entity);
 
     static QString toDxfString(const QString& str);
     static QString toNativeString(const QString& data);
@@ -184,9 +187,24 @@ public:
 	
         static bool isVariableTwoDimensional(const QString& var);
 
+    /**
+     * Selects binary instead of ASCII DXF for the following exports.
+     * Binary files are smaller and load faster, but are not accepted
+     * by every application.
+     */
+    void setExportBinary(bool binary) {
+        exportBinary = binary;
+    }
+
     static RS_FilterInterface* createFilter(){return new RS_FilterDXFRW();}
 
 private:
+    RS_Layer* internLayer(const std::string& name);
+    RS2::LineType internLineType(const std::string& name);
+    QString internBlockName(const std::string& name);
+    void clearInternedNames();
+    const std::string& exportLayerName(const RS_Layer* layer);
+    const std::string& exportLineTypeName(RS2::LineType lineType);
     void prepareBlocks();
     void writeEntity(RS_Entity* e);
 #ifdef DWGSUPPORT
@@ -221,10 +239,24 @@ private:
     dxfRW *dxfW;
     /** If saved version are 2004 or above can save color in RGB value. */
     bool exactColor;
+    /** Write binary DXF on export. */
+    bool exportBinary;
     /** hash of block containers and handleBlock numbers to read dwg files */
     QHash<int, RS_EntityContainer*> blockHash;
     /** Pointer to entity container to store posible horphan entites like paper space */
     RS_EntityContainer* dummyContainer;
+    /**
+     * Names already resolved during import, keyed by the raw name as read
+     * from the file, so repeated names cost a single lookup.
+     */
+    std::unordered_map<std::string, RS_Layer*> layerNames;
+    std::unordered_map<std::string, RS2::LineType> lineTypeNames;
+    std::unordered_map<std::string, QString> blockNames;
+    /**
+     * Layer and line type names already converted during export.
+     */
+    std::unordered_map<const RS_Layer*, std::string> exportLayerNames;
+    std::unordered_map<int, std::string> exportLineTypeNames;
 };
 
 #endif
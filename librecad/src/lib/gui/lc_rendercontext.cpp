@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#include "lc_rendercontext.h"
+
+#include "rs_graphic.h"
+#include "rs_graphicview.h"
+#include "rs_layer.h"
+#include "rs_layerlist.h"
+#include "rs_painterqt.h"
+#include "rs_units.h"
+
+
+LC_RenderContext::LC_RenderContext()
+    : valid(false),
+      unitFactor(1.0),
+      paperScale(1.0),
+      widthFactor(1.0),
+      dpmm(1.0),
+      resolutionValid(false),
+      factor(1.0, 1.0),
+      offsetX(0),
+      offsetY(0),
+      width(0),
+      height(0),
+      printing(false),
+      printPreview(false),
+      draftMode(false),
+      container(NULL) {
+}
+
+
+
+/**
+ * Derives all values from the given view and painter.
+ */
+void LC_RenderContext::update(RS_GraphicView* view, RS_Painter* painter) {
+    factor = view->getFactor();
+    offsetX = view->getOffsetX();
+    offsetY = view->getOffsetY();
+    width = view->getWidth();
+    height = view->getHeight();
+    printing = view->isPrinting();
+    printPreview = view->isPrintPreview();
+    draftMode = view->isDraftMode();
+    container = view->getContainer();
+
+    unitFactor = 1.0;
+    paperScale = 1.0;
+    widthFactor = 1.0;
+    RS_Graphic* graphic = container!=NULL ? container->getGraphic() : NULL;
+    if (graphic!=NULL) {
+        unitFactor = RS_Units::convert(1.0, RS2::Millimeter, graphic->getUnit());
+        paperScale = graphic->getPaperScale();
+        if ((printing || printPreview) && paperScale>RS_TOLERANCE) {
+            widthFactor = 1.0/paperScale;
+        }
+    }
+
+    // queries without painter keep the resolution of the last painter
+    // until the first query with a painter:
+    resolutionValid = false;
+    updateResolution(painter);
+
+    viewportMin = view->toGraph(0, height);
+    viewportMax = view->toGraph(width, 0);
+
+    layerPens.clear();
+    RS_LayerList* layers = graphic!=NULL ? graphic->getLayerList() : NULL;
+    if (layers!=NULL) {
+        for (unsigned i=0; i<layers->count(); ++i) {
+            RS_Layer* l = layers->at(i);
+            layerPens.insert(l, view->getScreenPen(l->getPen(), unitFactor, widthFactor));
+        }
+    }
+    valid = true;
+}
+
+
+
+/**
+ * Takes the resolution from the given painter.
+ */
+void LC_RenderContext::updateResolution(RS_Painter* painter) {
+    if (painter!=NULL) {
+        dpmm = static_cast<RS_PainterQt*>(painter)->getDpmm();
+        resolutionValid = true;
+    }
+}
+
+
+
+/**
+ * @return true if the context is still valid for the current geometry
+ * and mode of the given view.
+ */
+bool LC_RenderContext::matches(RS_GraphicView* view) const {
+    return valid &&
+            offsetX==view->getOffsetX() && offsetY==view->getOffsetY() &&
+            factor.x==view->getFactor().x && factor.y==view->getFactor().y &&
+            width==view->getWidth() && height==view->getHeight() &&
+            printing==view->isPrinting() &&
+            printPreview==view->isPrintPreview() &&
+            draftMode==view->isDraftMode() &&
+            container==view->getContainer();
+}
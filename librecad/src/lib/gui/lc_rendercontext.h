@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** This file is part of the LibreCAD project, a 2D CAD program
+**
+** Copyright (C) 2016 LibreCAD.org
+**
+**
+** This file may be distributed and/or modified under the terms of the
+** GNU General Public License version 2 as published by the Free Software
+** Foundation and appearing in the file gpl-2.0.txt included in the
+** packaging of this file.
+**
+** This program is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with this program; if not, write to the Free Software
+** Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**
+** This copyright notice MUST APPEAR in all copies of the script!
+**
+**********************************************************************/
+
+
+#ifndef LC_RENDERCONTEXT_H
+#define LC_RENDERCONTEXT_H
+
+#include <QHash>
+#include "rs_pen.h"
+#include "rs_vector.h"
+
+class RS_EntityContainer;
+class RS_GraphicView;
+class RS_Layer;
+class RS_Painter;
+
+/**
+ * Values that are constant while a graphic view paints one frame.
+ * Entity drawing used to derive them for every entity (walking up
+ * to the graphic, converting units, mapping the viewport corners).
+ * The context is refreshed by RS_GraphicView whenever the view
+ * geometry changes and at the start of every paint. It is read-only
+ * while entities are drawn, so drawing threads can share it.
+ */
+class LC_RenderContext {
+public:
+    LC_RenderContext();
+
+    void update(RS_GraphicView* view, RS_Painter* painter);
+    void updateResolution(RS_Painter* painter);
+    bool matches(RS_GraphicView* view) const;
+    void invalidate() {
+        valid = false;
+    }
+
+    bool valid;
+
+    /** Drawing unit per millimeter of the graphic. */
+    double unitFactor;
+    /** Paper scale of the graphic (1.0 without graphic). */
+    double paperScale;
+    /** Pen width factor: 1/paperScale on print and print preview, otherwise 1. */
+    double widthFactor;
+    /** Device pixels per millimeter of the painter. */
+    double dpmm;
+    /** false until dpmm was taken from a painter of this frame. */
+    bool resolutionValid;
+
+    RS_Vector factor;
+    int offsetX;
+    int offsetY;
+    int width;
+    int height;
+    bool printing;
+    bool printPreview;
+    bool draftMode;
+    RS_EntityContainer* container;
+
+    /** Visible area in graph coordinates. */
+    RS_Vector viewportMin;
+    RS_Vector viewportMax;
+
+    /**
+     * Screen pens of entities that take color, width and line type from
+     * their layer, resolved for all layers of the graphic by update().
+     */
+    QHash<RS_Layer*, RS_Pen> layerPens;
+};
+
+#endif
@@ -31,6 +31,7 @@
 #include "rs_dialogfactory.h"
 #include "rs_commandevent.h"
 #include "rs_commands.h"
+#include "lc_profiler.h"
 
 /**
  * Constructor.
@@ -99,6 +100,7 @@ void RS_EventHandler::enter() {
  * Called by RS_GraphicView
  */
 void RS_EventHandler::mousePressEvent(QMouseEvent* e) {
+    LC_PROFILE_SCOPE("event/mouse press");
     if(hasAction()){
         currentActions.last()->mousePressEvent(e);
         e->accept();
@@ -119,6 +121,7 @@ void RS_EventHandler::mousePressEvent(QMouseEvent* e) {
  * Called by RS_GraphicView
  */
 void RS_EventHandler::mouseReleaseEvent(QMouseEvent* e) {
+    LC_PROFILE_SCOPE("event/mouse release");
     if(hasAction()){
         //    if (actionIndex>=0 && currentActions[actionIndex]!=NULL &&
         //            !currentActions[actionIndex]->isFinished()) {
@@ -145,6 +148,7 @@ void RS_EventHandler::mouseReleaseEvent(QMouseEvent* e) {
  * Called by RS_GraphicView
  */
 void RS_EventHandler::mouseMoveEvent(QMouseEvent* e) {
+    LC_PROFILE_SCOPE("event/mouse move");
     if(hasAction()){
         currentActions.last()->mouseMoveEvent(e);
         e->accept();
@@ -198,6 +202,7 @@ void RS_EventHandler::mouseEnterEvent() {
  * Called by RS_GraphicView
  */
 void RS_EventHandler::keyPressEvent(QKeyEvent* e) {
+    LC_PROFILE_SCOPE("event/key press");
 
     if(hasAction()){
         currentActions.last()->keyPressEvent(e);
@@ -219,6 +224,7 @@ void RS_EventHandler::keyPressEvent(QKeyEvent* e) {
  * Called by RS_GraphicView
  */
 void RS_EventHandler::keyReleaseEvent(QKeyEvent* e) {
+    LC_PROFILE_SCOPE("event/key release");
 
     if(hasAction()){
         currentActions.last()->keyReleaseEvent(e);
@@ -255,6 +261,7 @@ bool RS_EventHandler::cliCalculator(const QString& cmd) const
  * Handles command line events.
  */
 void RS_EventHandler::commandEvent(RS_CommandEvent* e) {
+    LC_PROFILE_SCOPE("event/command");
     RS_DEBUG->print("RS_EventHandler::commandEvent");
     QString cmd = e->getCommand();
 
@@ -25,9 +25,13 @@
 **
 **********************************************************************/
 
+#include <algorithm>
+#include <vector>
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QAction>
+#include <QImage>
+#include <QThreadPool>
 #include <limits.h>
 #include "qc_applicationwindow.h"
 #include "rs_graphicview.h"
@@ -37,16 +41,23 @@
 #include "rs_graphic.h"
 #include "rs_grid.h"
 #include "rs_painter.h"
+#include "rs_painterqt.h"
 #include "rs_mtext.h"
 #include "rs_text.h"
 #include "rs_settings.h"
 #include "rs_dialogfactory.h"
 #include "rs_layer.h"
+#include "lc_parallel.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h"
 #endif
 
+namespace {
+/** Drawings with fewer top level entities are drawn by one thread. */
+const unsigned minParallelEntities = 2000;
+}
+
 /**
  * Constructor.
  */
@@ -637,6 +648,8 @@ void RS_GraphicView::zoomAuto(bool axis, bool keepAspectRatio) {
 
 
     if (container!=NULL) {
+        // from scratch, layers may have been frozen or thawed since:
+        container->invalidateBordersDeep();
         container->calculateBorders();
 
         double sx, sy;
@@ -1113,6 +1126,8 @@ void RS_GraphicView::drawLayer1(RS_Painter *painter) {
 
 void RS_GraphicView::drawLayer2(RS_Painter *painter)
 {
+    // units, paper scale and layer pens may have changed since the last frame:
+    updateRenderContext(painter);
     drawEntity(painter, container);	//	Draw all entities.
 
     //	If not in print preview, draw the absolute zero reference.
@@ -1122,9 +1137,204 @@ void RS_GraphicView::drawLayer2(RS_Painter *painter)
 }
 
 
+/**
+ * Draws the entities like drawLayer2() does, by drawEntitiesParallel().
+ * Selected entities are drawn on top afterwards like in drawLayer2().
+ *
+ * @return false if the drawing is too small or there's only one core,
+ *         nothing is drawn then.
+ */
+bool RS_GraphicView::drawLayer2Parallel(RS_PainterQt *painter) {
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    if (container==NULL || threads<2 || LC_Parallel::inLoop() ||
+            container->count()<minParallelEntities) {
+        return false;
+    }
+
+    updateRenderContext(painter);
+
+    std::vector<RS_Entity*> visible;
+    std::vector<RS_Entity*> selected;
+    visible.reserve(container->count());
+    for (unsigned i=0; i<container->count(); ++i) {
+        RS_Entity* e = container->entityAt(i);
+        if (!e->isVisible()) {
+            continue;
+        }
+        visible.push_back(e);
+        if (e->isSelected() || (e->isContainer() &&
+                                ((RS_EntityContainer*)e)->countSelected()>0)) {
+            selected.push_back(e);
+        }
+    }
+    if (visible.size()<minParallelEntities) {
+        return false;
+    }
+
+    drawEntitiesParallel(painter, visible, 0, visible.size());
+
+    painter->setDrawSelectedOnly(true);
+    for (RS_Entity* e: selected) {
+        drawEntity(painter, e);
+    }
+
+    if (!isPrintPreview())
+        drawAbsoluteZero(painter);
+
+    return true;
+}
+
+
+
+/**
+ * Draws entities[first] to entities[last-1] unselected. They are split
+ * into ranges, every range is drawn by a worker thread into an image
+ * of its own and the images are composited in entity order. The images
+ * are kept for the next call and only cleared, they are allocated again
+ * when the size of the view changes. Too few entities for more than one
+ * range are drawn by this thread.
+ *
+ * Outdated borders are recalculated before the workers start. Entities
+ * only change themselves while being drawn (lazy sub entities, cached
+ * outlines), so entities of different ranges can be drawn at the same
+ * time.
+ */
+void RS_GraphicView::drawEntitiesParallel(RS_PainterQt *painter,
+                                          const std::vector<RS_Entity*>& entities,
+                                          size_t first, size_t last) {
+    const int threads = QThreadPool::globalInstance()->maxThreadCount();
+    const int parts = LC_Parallel::inLoop() ? 1 :
+            std::min<int>(threads, (last-first)/(minParallelEntities/2));
+    painter->setDrawSelectedOnly(false);
+    if (parts<2) {
+        for (size_t i=first; i<last; ++i) {
+            drawEntity(painter, entities[i]);
+        }
+        return;
+    }
+
+    if (container!=NULL) {
+        container->updateBorders();
+    }
+    const RS2::DrawingMode mode = painter->getDrawingMode();
+    if (parallelImages.size()<(size_t)parts) {
+        parallelImages.resize(parts);
+    }
+    LC_Parallel::forEach(parts, [&](int k) {
+        QImage& img = parallelImages[k];
+        if (img.width()!=getWidth() || img.height()!=getHeight()) {
+            img = QImage(getWidth(), getHeight(), QImage::Format_ARGB32_Premultiplied);
+        }
+        img.fill(Qt::transparent);
+
+        RS_PainterQt p(&img);
+        p.setDrawingMode(mode);
+        p.setDrawSelectedOnly(false);
+        const size_t end = first + (last-first)*(k+1)/parts;
+        for (size_t i=first + (last-first)*k/parts; i<end; ++i) {
+            drawEntity(&p, entities[i]);
+        }
+        p.end();
+    });
+
+    for (int k=0; k<parts; ++k) {
+        painter->drawImage(0, 0, parallelImages[k]);
+    }
+}
+
+
+
+/**
+ * @return true if the drawing has a construction layer. Without a
+ * drawing the layers are unknown and true is returned.
+ */
+bool RS_GraphicView::hasConstructionLayers() {
+    RS_Graphic* graphic = container!=NULL ? container->getGraphic() : NULL;
+    if (graphic==NULL) {
+        return true;
+    }
+    RS_LayerList* layers = graphic->getLayerList();
+    for (unsigned i=0; i<layers->count(); ++i) {
+        if (layers->at(i)->isConstruction()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+
+/**
+ * @return true if the entity is or contains a line on a construction
+ * layer. Those are drawn across the whole view, beyond their borders
+ * (see RS_Line::draw()). Containers cache the answer.
+ */
+bool RS_GraphicView::hasConstructionLines(RS_Entity* e) {
+    if (e->isContainer()) {
+        return static_cast<RS_EntityContainer*>(e)->hasConstructionLines();
+    }
+    return e->rtti()==RS2::EntityLine && e->isConstruction(true);
+}
+
+
+
+/**
+ * Draws the entities crossing the given rectangle of the screen, clipped
+ * to it. The caller clears the rectangle before. Used to repaint the
+ * region of modified entities instead of the whole drawing.
+ */
+void RS_GraphicView::drawLayer2Region(RS_Painter *painter, const QRect& rect) {
+    if (container==NULL || rect.isEmpty()) {
+        return;
+    }
+
+    updateRenderContext(painter);
+    painter->setClipRect(rect.x(), rect.y(), rect.width(), rect.height());
+
+    // construction lines cross the region whatever their borders are:
+    const bool construction = hasConstructionLayers();
+    std::vector<RS_Entity*> crossing;
+    for (unsigned i=0; i<container->count(); ++i) {
+        RS_Entity* e = container->entityAt(i);
+        if (!e->isVisible()) {
+            continue;
+        }
+        // bottom left and top right corner on the screen:
+        RS_Vector bl = toGui(e->getMin());
+        RS_Vector tr = toGui(e->getMax());
+        if ((tr.x<rect.left() || bl.x>rect.right()+1 ||
+                bl.y<rect.top() || tr.y>rect.bottom()+1) &&
+                (!construction || !hasConstructionLines(e))) {
+            continue;
+        }
+        crossing.push_back(e);
+    }
+
+    painter->setDrawSelectedOnly(false);
+    for (RS_Entity* e: crossing) {
+        drawEntity(painter, e);
+    }
+    painter->setDrawSelectedOnly(true);
+    for (RS_Entity* e: crossing) {
+        if (e->isSelected() || (e->isContainer() &&
+                                ((RS_EntityContainer*)e)->countSelected()>0)) {
+            drawEntity(painter, e);
+        }
+    }
+
+    if (!isPrintPreview())
+        drawAbsoluteZero(painter);
+    painter->resetClipping();
+}
+
+
+
 void RS_GraphicView::drawLayer3(RS_Painter *painter) {
     // drawing zero points:
     if (!isPrintPreview()) {
+        // refreshed by the frames drawing the entities, a mouse move only
+        // refreshes it if the view changed:
+        getRenderContext(painter);
         drawRelativeZero(painter);
         drawOverlay(painter);
     }
@@ -1157,66 +1367,66 @@ void RS_GraphicView::setPenForEntity(RS_Painter *painter,RS_Entity *e)
                                RS2::Width00, RS2::SolidLine));
     }
 
-    // Getting pen from entity (or layer)
-    RS_Pen pen = e->getPen(true);
-
-    int w = pen.getWidth();
-    if (w<0) {
-        w = 0;
+    // Entities which take all attributes from their layer share the
+    // screen pen of their layer:
+    const LC_RenderContext& rc = getRenderContext(painter);
+    RS_Layer* layer = NULL;
+    RS_Pen pen = e->getPen(false);
+    if (pen.isValid() && pen.getColor().isByLayer() &&
+            pen.getWidth()==RS2::WidthByLayer &&
+            pen.getLineType()==RS2::LineByLayer) {
+        layer = e->getLayer(true);
     }
 
-#if 1 /*TRUE*/
-	// - Scale pen width.
-	// - Notes: pen width is not scaled on print and print preview.
-        //   This is the standard (AutoCAD like) behaviour.
-    // bug# 3437941
-    // ------------------------------------------------------------
-    if (!draftMode)
-    {
-        double	uf = 1.0;	// Unit factor.
-        double	wf = 1.0;	// Width factor.
-
-        RS_Graphic* graphic = container->getGraphic();
-
-        if (graphic != NULL)
-        {
-            uf = RS_Units::convert(1.0, RS2::Millimeter, graphic->getUnit());
-
-            if (	(isPrinting() || isPrintPreview()) &&
-                                        graphic->getPaperScale() > RS_TOLERANCE )
-            {
-                wf = 1.0 / graphic->getPaperScale();
-            }
-        }
+    QHash<RS_Layer*, RS_Pen>::const_iterator it;
+    if (layer!=NULL && (it=rc.layerPens.constFind(layer))!=rc.layerPens.constEnd()) {
+        pen = it.value();
+    } else {
+        // Getting pen from entity (or layer)
+        pen = getScreenPen(e->getPen(true), rc.unitFactor, rc.widthFactor);
+    }
 
-        pen.setScreenWidth(toGuiDX(w / 100.0 * uf * wf));
+    // this entity is selected:
+    if (e->isSelected()) {
+        pen.setLineType(RS2::DotLine);
+        pen.setColor(selectedColor);
     }
-    else
-    {
-//		pen.setWidth(RS2::Width00);
-        pen.setScreenWidth(0);
+
+    // this entity is highlighted:
+    if (e->isHighlighted()) {
+        pen.setColor(highlightedColor);
     }
 
-#else
+    // deleting not drawing:
+    if (getDeleteMode()) {
+        pen.setColor(background);
+    }
 
-    // - Scale pen width.
-    // - Notes: pen width is scaled on print and print preview.
-    //   This is not the standard (AutoCAD like) behaviour.
-    // --------------------------------------------------------
-    if (!draftMode)
-    {
-        double	uf = 1.0;	//	Unit factor.
+    painter->setPen(pen);
+}
 
-        RS_Graphic* graphic = container->getGraphic();
 
-        if (graphic != NULL)
-            uf = RS_Units::convert(1.0, RS2::Millimeter, graphic->getUnit());
 
-        pen.setScreenWidth(toGuiDX(w / 100.0 * uf));
+/**
+ * @return The given resolved pen with the screen width and color used
+ * by this view.
+ */
+RS_Pen RS_GraphicView::getScreenPen(RS_Pen pen, double unitFactor, double widthFactor) {
+    int w = pen.getWidth();
+    if (w<0) {
+        w = 0;
     }
-    else
+
+    // - Scale pen width.
+    // - Notes: pen width is not scaled on print and print preview.
+    //   This is the standard (AutoCAD like) behaviour.
+    // bug# 3437941
+    // ------------------------------------------------------------
+    if (!draftMode) {
+        pen.setScreenWidth(toGuiDX(w / 100.0 * unitFactor * widthFactor));
+    } else {
         pen.setScreenWidth(0);
-#endif
+    }
 
     // prevent drawing with 1-width which is slow:
     if (RS_Math::round(pen.getScreenWidth())==1) {
@@ -1228,23 +1438,39 @@ void RS_GraphicView::setPenForEntity(RS_Painter *painter,RS_Entity *e)
         pen.setColor(foreground);
     }
 
-    // this entity is selected:
-    if (e->isSelected()) {
-        pen.setLineType(RS2::DotLine);
-        pen.setColor(selectedColor);
-    }
+    return pen;
+}
 
-    // this entity is highlighted:
-    if (e->isHighlighted()) {
-        pen.setColor(highlightedColor);
-    }
 
-    // deleting not drawing:
-    if (getDeleteMode()) {
-        pen.setColor(background);
+
+/**
+ * @return Values that are constant during the current frame. The context
+ * is refreshed if the zoom, offset, size or mode of this view changed.
+ */
+const LC_RenderContext& RS_GraphicView::getRenderContext(RS_Painter* painter) {
+    // drawLayer2Parallel() refreshes the context before its workers
+    // start, they only read it:
+    if (!renderContext.matches(this)) {
+        renderContext.update(this, painter);
+    } else if (!renderContext.resolutionValid) {
+        renderContext.updateResolution(painter);
     }
+    return renderContext;
+}
 
-    painter->setPen(pen);
+
+
+/**
+ * Refreshes the render context. Called before each frame is painted
+ * as units, paper scale or layer pens cannot be watched cheaply.
+ * Borders marked as outdated since the last frame are recalculated
+ * here too, drawing them only reads them.
+ */
+void RS_GraphicView::updateRenderContext(RS_Painter* painter) {
+    if (container!=NULL) {
+        container->updateBorders();
+    }
+    renderContext.update(this, painter);
 }
 
 
@@ -1257,23 +1483,27 @@ void RS_GraphicView::setPenForEntity(RS_Painter *painter,RS_Entity *e)
  *        lines e.g. in splines).
  * @param db Double buffering on (recommended) / off
  */
-void RS_GraphicView::drawEntity(RS_Entity* /*e*/, double& /*patternOffset*/) {
-    RS_DEBUG->print("RS_GraphicView::drawEntity(RS_Entity*,patternOffset) not supported anymore");
-    // RVT_PORT this needs to be optimized
-    // ONe way to do is to send a RS2::RedrawSelected, then teh draw routine will onyl draw all selected entities
-    // Dis-advantage is that we still need to iterate over all entities, but
-    // this might be very fast
-    // For now we just redraw the drawing untill we are going to optmize drawing
-    redraw(RS2::RedrawDrawing);
+void RS_GraphicView::drawEntity(RS_Entity* e, double& /*patternOffset*/) {
+    drawEntity(e);
 }
-void RS_GraphicView::drawEntity(RS_Entity* /*e*/ /*patternOffset*/) {
-    RS_DEBUG->print("RS_GraphicView::drawEntity(RS_Entity*,patternOffset) not supported anymore");
-    // RVT_PORT this needs to be optimized
-    // ONe way to do is to send a RS2::RedrawSelected, then teh draw routine will onyl draw all selected entities
-    // Dis-advantage is that we still need to iterate over all entities, but
-    // this might be very fast
-    // For now we just redraw the drawing untill we are going to optmize drawing
-    redraw(RS2::RedrawDrawing);
+/**
+ * Redraws the region of the drawing covered by the given entity. Entities
+ * which were changed, added or removed are passed here, removed ones
+ * before their borders change. Construction lines cover the whole view,
+ * the whole drawing is redrawn for them.
+ */
+void RS_GraphicView::drawEntity(RS_Entity* e) {
+    if (e==NULL) {
+        return;
+    }
+    if (container!=NULL && hasConstructionLayers() && hasConstructionLines(e)) {
+        redraw(RS2::RedrawDrawing);
+        return;
+    }
+    if (e->isContainer()) {
+        static_cast<RS_EntityContainer*>(e)->updateBorders();
+    }
+    redrawRegion(e->getMin(), e->getMax());
 }
 void RS_GraphicView::drawEntity(RS_Painter *painter, RS_Entity* e) {
     double offset(0.);
@@ -1405,17 +1635,23 @@ void RS_GraphicView::drawEntityPlain(RS_Painter *painter, RS_Entity* e) {
 
 }
 /**
- * Deletes an entity with the background color.
+ * Marks the part of the drawing between the corners v1 and v2 for
+ * redrawing. Views which can't repaint parts redraw everything.
+ */
+void RS_GraphicView::redrawRegion(const RS_Vector& /*v1*/, const RS_Vector& /*v2*/) {
+    redraw(RS2::RedrawDrawing);
+}
+
+
+
+/**
+ * Redraws the region of an entity which is removed from the drawing.
  * Might be recusively called e.g. for polylines.
  */
 void RS_GraphicView::deleteEntity(RS_Entity* e) {
 
-    // RVT_PORT When we delete a single entoty, we can do this but we need to remove this then also from containerEntities
-    RS_DEBUG->print("RS_GraphicView::deleteEntity will for now redraw the whole screen instead of just deleting the entity");
-    setDeleteMode(true);
+    // the entities left in its region are drawn again:
     drawEntity(e);
-    setDeleteMode(false);
-    redraw(RS2::RedrawDrawing);
 }
 
 
@@ -1662,12 +1898,8 @@ void RS_GraphicView::drawGrid(RS_Painter *painter) {
     painter->setPen(gridColor);
 
 //    grid->updatePointArray();
-    RS_Vector* pts = grid->getPoints();
-    if (pts!=NULL) {
-        for (int i=0; i<grid->count(); ++i) {
-            painter->drawGridPoint(toGui(pts[i]));
-        }
-    }
+    // all points with one call, mapped to the screen by the grid:
+    painter->drawGridPoints(grid->getScreenPoints());
 
     // draw grid info:
     //painter->setPen(Qt::white);
@@ -30,18 +30,23 @@
 
 #include "rs_entitycontainer.h"
 #include "rs_snapper.h"
+#include "lc_rendercontext.h"
 
 #include <QDateTime>
+#include <QImage>
 #include <QMap>
+#include <QRect>
 #include <QKeyEvent>
 #include <QKeyEvent>
 #include <tuple>
+#include <vector>
 
 
 class RS_ActionInterface;
 class RS_EventHandler;
 class RS_Grid;
 class RS_CommandEvent;
+class RS_PainterQt;
 struct RS_LineTypePattern;
 
 
@@ -111,6 +116,9 @@ public:
     /** This virtual method must be overwritten to redraw
       the widget. */
     virtual void redraw(RS2::RedrawMethod method=RS2::RedrawAll) = 0;
+    /** Redraws the part of the drawing between the corners v1 and v2.
+      The default implementation redraws the whole drawing. */
+    virtual void redrawRegion(const RS_Vector& v1, const RS_Vector& v2);
     /** This virtual method must be overwritten and is then
       called whenever the view changed */
     virtual void adjustOffsetControls() {}
@@ -326,6 +334,13 @@ public:
     virtual void drawWindow_DEPRECATED(RS_Vector v1, RS_Vector v2);
     virtual void drawLayer1(RS_Painter *painter);
     virtual void drawLayer2(RS_Painter *painter);
+    bool drawLayer2Parallel(RS_PainterQt *painter);
+    void drawEntitiesParallel(RS_PainterQt *painter,
+                              const std::vector<RS_Entity*>& entities,
+                              size_t first, size_t last);
+    void drawLayer2Region(RS_Painter *painter, const QRect& rect);
+    bool hasConstructionLayers();
+    static bool hasConstructionLines(RS_Entity* e);
     virtual void drawLayer3(RS_Painter *painter);
     virtual void deleteEntity(RS_Entity* e);
     virtual void drawEntity(RS_Painter *painter, RS_Entity* e, double& patternOffset);
@@ -335,6 +350,10 @@ public:
     virtual void drawEntityPlain(RS_Painter *painter, RS_Entity* e);
     virtual void drawEntityPlain(RS_Painter *painter, RS_Entity* e, double& patternOffset);
     virtual void setPenForEntity(RS_Painter *painter, RS_Entity* e );
+    RS_Pen getScreenPen(RS_Pen pen, double unitFactor, double widthFactor);
+
+    const LC_RenderContext& getRenderContext(RS_Painter* painter);
+    void updateRenderContext(RS_Painter* painter);
 
 
     virtual const RS_LineTypePattern* getPattern(RS2::LineType t);
@@ -545,6 +564,11 @@ private:
         /** if true, graphicView is under cleanup */
         bool m_bIsCleanUp;
 
+    /** Per-frame values used by entity drawing */
+    LC_RenderContext renderContext;
+    /** Images of the workers of drawEntitiesParallel(), kept between frames */
+    std::vector<QImage> parallelImages;
+
 };
 
 #endif
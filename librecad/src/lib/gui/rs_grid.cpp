@@ -30,6 +30,7 @@
 #include "rs_units.h"
 #include "rs_graphic.h"
 #include "rs_settings.h"
+#include "lc_profiler.h"
 
 #ifdef EMU_C99
 #include "emu_c99.h"
@@ -40,12 +41,10 @@
  */
 RS_Grid::RS_Grid(RS_GraphicView* graphicView): baseGrid(false) {
     this->graphicView = graphicView;
-    pt = NULL;
-    number = 0;
-    metaX = NULL;
-    numMetaX = 0;
-    metaY = NULL;
-    numMetaY = 0;
+    isometric = false;
+    crosshairType = RS2::LeftCrosshair;
+    valid = false;
+    loadSettings();
 }
 
 
@@ -53,14 +52,70 @@ RS_Grid::RS_Grid(RS_GraphicView* graphicView): baseGrid(false) {
  * Destructor.
  */
 RS_Grid::~RS_Grid() {
-    if (pt!=NULL) {
-        delete[] pt;
-    }
-    if (metaX!=NULL) {
-        delete[] metaX;
-    }
-    if (metaY!=NULL) {
-        delete[] metaY;
+}
+
+
+
+/**
+ * Reads the grid settings from /Appearance. The settings used to be
+ * read on every repaint; call this after they were changed.
+ */
+void RS_Grid::loadSettings() {
+    RS_SETTINGS->beginGroup("/Appearance");
+    scaleGrid = (bool)RS_SETTINGS->readNumEntry("/ScaleGrid", 1);
+    defaultIsometric = (bool)RS_SETTINGS->readNumEntry("/IsometricGrid", 0);
+    defaultCrosshairType=static_cast<RS2::CrosshairType>(RS_SETTINGS->readNumEntry("/CrosshairType",0));
+    defaultGridSpacing.x = RS_SETTINGS->readEntry("/GridSpacingX",QString("-1")).toDouble();
+    defaultGridSpacing.y = RS_SETTINGS->readEntry("/GridSpacingY",QString("-1")).toDouble();
+    minGridSpacing = RS_SETTINGS->readNumEntry("/MinGridSpacing", 10);
+    RS_SETTINGS->endGroup();
+    invalidate();
+}
+
+
+
+/**
+ * @return true if the grid points were computed for the current view
+ *      geometry and the given grid settings.
+ */
+bool RS_Grid::isUpToDate(const RS_Vector& userGrid, RS2::Unit unit,
+                         RS2::LinearFormat format) const {
+    return valid &&
+            lastFactor.x==graphicView->getFactor().x &&
+            lastFactor.y==graphicView->getFactor().y &&
+            lastOffsetX==graphicView->getOffsetX() &&
+            lastOffsetY==graphicView->getOffsetY() &&
+            lastWidth==graphicView->getWidth() &&
+            lastHeight==graphicView->getHeight() &&
+            lastUserGrid.x==userGrid.x && lastUserGrid.y==userGrid.y &&
+            lastUnit==unit && lastFormat==format &&
+            lastIsometric==isometric;
+}
+
+
+
+/**
+ * Removes all grid and meta grid points. The memory is kept for reuse.
+ */
+void RS_Grid::clearPoints() {
+    pt.clear();
+    metaX.clear();
+    metaY.clear();
+    screenPoints.clear();
+}
+
+
+
+/**
+ * Maps the grid points to screen coordinates once, so drawing the grid
+ * is a single call.
+ */
+void RS_Grid::updateScreenPoints() {
+    screenPoints.resize(static_cast<int>(pt.size()));
+    for (size_t i=0; i<pt.size(); ++i) {
+        screenPoints[static_cast<int>(i)] =
+                QPoint(RS_Math::round(graphicView->toGuiX(pt[i].x)),
+                       RS_Math::round(graphicView->toGuiY(pt[i].y)));
     }
 }
 
@@ -87,7 +142,8 @@ RS_Vector RS_Grid::snapGrid(const RS_Vector& coord) const {
 }
 
 /**
- * Updates the grid point array.
+ * Updates the grid point array. The points are only recomputed if the
+ * view geometry or the grid settings have changed since the last call.
  */
 void RS_Grid::updatePointArray() {
     RS_DEBUG->print("RS_Grid::update");
@@ -95,9 +151,6 @@ void RS_Grid::updatePointArray() {
 
         RS_Graphic* graphic = graphicView->getGraphic();
 
-        // auto scale grid?
-        RS_SETTINGS->beginGroup("/Appearance");
-        bool scaleGrid = (bool)RS_SETTINGS->readNumEntry("/ScaleGrid", 1);
         // get grid setting
         RS_Vector userGrid;
         if (graphic!=NULL) {
@@ -107,35 +160,10 @@ void RS_Grid::updatePointArray() {
             userGrid = graphic->getVariableVector("$GRIDUNIT",
                                                   RS_Vector(-1.0, -1.0));
         }else {
-            isometric = (bool)RS_SETTINGS->readNumEntry("/IsometricGrid", 0);
-            crosshairType=static_cast<RS2::CrosshairType>(RS_SETTINGS->readNumEntry("/CrosshairType",0));
-            userGrid.x = RS_SETTINGS->readEntry("/GridSpacingX",QString("-1")).toDouble();
-            userGrid.y = RS_SETTINGS->readEntry("/GridSpacingY",QString("-1")).toDouble();
-        }
-        int minGridSpacing = RS_SETTINGS->readNumEntry("/MinGridSpacing", 10);
-        RS_SETTINGS->endGroup();
-
-
-//        std::cout<<"Grid userGrid="<<userGrid<<std::endl;
-
-        // delete old grid:
-        if (pt!=NULL) {
-            delete[] pt;
-            pt = NULL;
-        }
-        if (metaX!=NULL) {
-            delete[] metaX;
-            metaX = NULL;
-        }
-        if (metaY!=NULL) {
-            delete[] metaY;
-            metaY = NULL;
+            isometric = defaultIsometric;
+            crosshairType = defaultCrosshairType;
+            userGrid = defaultGridSpacing;
         }
-        number = 0;
-        numMetaX = 0;
-        numMetaY = 0;
-
-        //        RS_DEBUG->print("RS_Grid::update: 001");
 
         // find out unit:
         RS2::Unit unit = RS2::None;
@@ -145,6 +173,40 @@ void RS_Grid::updatePointArray() {
             format = graphic->getLinearFormat();
         }
 
+        if (isUpToDate(userGrid, unit, format)) {
+            return;
+        }
+
+        LC_PROFILE_SCOPE("grid/update");
+        valid = true;
+        lastFactor = graphicView->getFactor();
+        lastOffsetX = graphicView->getOffsetX();
+        lastOffsetY = graphicView->getOffsetY();
+        lastWidth = graphicView->getWidth();
+        lastHeight = graphicView->getHeight();
+        lastUserGrid = userGrid;
+        lastUnit = unit;
+        lastFormat = format;
+        lastIsometric = isometric;
+
+        calculatePointArray(userGrid, unit, format);
+        updateScreenPoints();
+    }
+    //        RS_DEBUG->print("RS_Grid::update: OK");
+}
+
+
+
+/**
+ * Computes the grid points and meta grid lines for the current view.
+ */
+void RS_Grid::calculatePointArray(const RS_Vector& userGrid, RS2::Unit unit,
+                                  RS2::LinearFormat format) {
+//        std::cout<<"Grid userGrid="<<userGrid<<std::endl;
+
+        // delete old grid:
+        clearPoints();
+
         RS_Vector gridWidth;
         //        RS_Vector metaGridWidth;
 
@@ -365,12 +427,12 @@ void RS_Grid::updatePointArray() {
                 double hdx=0.5*dx;
                 double hdy=0.5*gridWidth.y;
                 int numberX = (RS_Math::round((right-left) / dx) + 1);
-                number = 2*numberX*numberY;
+                int number = 2*numberX*numberY;
                 baseGrid.set(left+remainder(-left,dx),bottom+remainder(-bottom,fabs(gridWidth.y)));
 
                 if (number>0 && number<1000000) {
 
-                    pt = new RS_Vector[number];
+                    pt.resize(number);
 
                     int i=0;
                     RS_Vector bp0(baseGrid),dbp1(hdx,hdy);
@@ -391,13 +453,13 @@ void RS_Grid::updatePointArray() {
                         RS_Vector baseMetaGrid(left+remainder(-left,metaGridWidth.x)-fabs(metaGridWidth.x),bottom+remainder(-bottom,metaGridWidth.y)-fabs(metaGridWidth.y));
 
                         // calculate number of visible meta grid lines:
-                        numMetaX = (RS_Math::round((right-left) / metaGridWidth.x) + 1);
-                        numMetaY = (RS_Math::round((top-bottom) / metaGridWidth.y) + 1);
+                        int numMetaX = (RS_Math::round((right-left) / metaGridWidth.x) + 1);
+                        int numMetaY = (RS_Math::round((top-bottom) / metaGridWidth.y) + 1);
 
                         if (numMetaX>0 && numMetaY>0) {
                             // create meta grid arrays:
-                            metaX = new double[numMetaX];
-                            metaY = new double[numMetaY];
+                            metaX.resize(numMetaX);
+                            metaY.resize(numMetaY);
 
                             double x0(baseMetaGrid.x);
                             for (int i=0; i<numMetaX; x0 += metaGridWidth.x) {
@@ -410,24 +472,17 @@ void RS_Grid::updatePointArray() {
                             return;
 
                         }
-                        numMetaX = 0;
-                        metaX = NULL;
-                        numMetaY = 0;
-                        metaY = NULL;
+                        metaX.clear();
+                        metaY.clear();
                         return;
                     }
                 }
-                number = 0;
-                pt = NULL;
-                numMetaX = 0;
-                metaX = NULL;
-                numMetaY = 0;
-                metaY = NULL;
+                clearPoints();
             }else{
                 cellV.set(fabs(gridWidth.x),fabs(gridWidth.y));
                 int numberX = (RS_Math::round((right-left) / gridWidth.x) + 1);
                 int numberY = (RS_Math::round((top-bottom) / gridWidth.y) + 1);
-                number = numberX*numberY;
+                int number = numberX*numberY;
                 //                RS_DEBUG->print("RS_Grid::update: 014");
 //                if(baseGrid.valid){//align to previous grid
 //                    baseGrid.set(left+remainder(baseGrid.x-left,dx),bottom+remainder(baseGrid.y-bottom,gridWidth.y));
@@ -441,7 +496,7 @@ void RS_Grid::updatePointArray() {
 
                 if (number>0 && number<1000000) {
 
-                    pt = new RS_Vector[number];
+                    pt.resize(number);
 
                     int i=0;
                     RS_Vector bp0(baseGrid);
@@ -473,13 +528,13 @@ void RS_Grid::updatePointArray() {
                         mbottom -= metaGridWidth.y;
 
                         // calculate number of visible meta grid lines:
-                        numMetaX = (RS_Math::round((mright-mleft) / metaGridWidth.x) + 1);
-                        numMetaY = (RS_Math::round((mtop-mbottom) / metaGridWidth.y) + 1);
+                        int numMetaX = (RS_Math::round((mright-mleft) / metaGridWidth.x) + 1);
+                        int numMetaY = (RS_Math::round((mtop-mbottom) / metaGridWidth.y) + 1);
 
                         if (numMetaX>0 && numMetaY>0) {
                             // create meta grid arrays:
-                            metaX = new double[numMetaX];
-                            metaY = new double[numMetaY];
+                            metaX.resize(numMetaX);
+                            metaY.resize(numMetaY);
 
                             int i=0;
                             for (int x=0; x<numMetaX; ++x) {
@@ -491,29 +546,17 @@ void RS_Grid::updatePointArray() {
                             }
                             return;
                         }
-                        numMetaX = 0;
-                        metaX = NULL;
-                        numMetaY = 0;
-                        metaY = NULL;
+                        metaX.clear();
+                        metaY.clear();
                     }
                     return;
 
                 }
-                number = 0;
-                pt = NULL;
-                numMetaX = 0;
-                metaX = NULL;
-                numMetaY = 0;
-                metaY = NULL;
+                clearPoints();
             }
 
             //                RS_DEBUG->print("RS_Grid::update: 015");
         }
-
-
-
-    }
-    //        RS_DEBUG->print("RS_Grid::update: OK");
 }
 
 
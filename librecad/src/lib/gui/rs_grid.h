@@ -28,6 +28,8 @@
 #ifndef RS_GRID_H
 #define RS_GRID_H
 
+#include <vector>
+#include <QPolygon>
 #include "rs_graphicview.h"
 #include "rs_vector.h"
 
@@ -42,13 +44,26 @@ public:
     RS_Grid(RS_GraphicView* graphicView);
     ~RS_Grid();
 
+    void loadSettings();
+    /**
+     * Forces the next updatePointArray() to rebuild the grid.
+     */
+    void invalidate() {
+        valid = false;
+    }
     void updatePointArray();
 
         /**
          * @return Array of all visible grid points.
          */
     RS_Vector* getPoints() {
-        return pt;
+        return pt.empty() ? NULL : &pt[0];
+    }
+    /**
+     * @return All visible grid points in screen coordinates.
+     */
+    const QPolygon& getScreenPoints() const {
+        return screenPoints;
     }
     /**
       *@return the closest grid point
@@ -59,7 +74,7 @@ public:
          * @return Number of visible grid points.
          */
     int count() {
-        return number;
+        return static_cast<int>(pt.size());
     }
     void setCrosshairType(RS2::CrosshairType chType){
         crosshairType=chType;
@@ -93,28 +108,28 @@ public:
          * @return Meta grid positions in X.
          */
         double* getMetaX() {
-                return metaX;
+                return metaX.empty() ? NULL : &metaX[0];
         }
 
         /**
          * @return Number of visible meta grid lines in X.
          */
     int countMetaX() {
-        return numMetaX;
+        return static_cast<int>(metaX.size());
     }
 
         /**
          * @return Meta grid positions in Y.
          */
         double* getMetaY() {
-                return metaY;
+                return metaY.empty() ? NULL : &metaY[0];
         }
 
         /**
          * @return Number of visible meta grid lines in Y.
          */
     int countMetaY() {
-        return numMetaY;
+        return static_cast<int>(metaY.size());
     }
     bool isIsometric() const{
         return isometric;
@@ -131,6 +146,13 @@ public:
     }
 
 protected:
+    bool isUpToDate(const RS_Vector& userGrid, RS2::Unit unit,
+                    RS2::LinearFormat format) const;
+    void calculatePointArray(const RS_Vector& userGrid, RS2::Unit unit,
+                             RS2::LinearFormat format);
+    void clearPoints();
+    void updateScreenPoints();
+
     //! Graphic view this grid is connected to.
     RS_GraphicView* graphicView;
 
@@ -139,24 +161,39 @@ protected:
         //! Current meta grid spacing
         double metaSpacing;
 
-    //! Pointer to array of grid points
-    RS_Vector* pt;
+    //! Array of grid points
+    std::vector<RS_Vector> pt;
+    //! Grid points in screen coordinates, ready for drawing
+    QPolygon screenPoints;
     RS_Vector baseGrid; // the left-bottom grid point
     RS_Vector cellV;// (dx,dy)
     RS_Vector metaGridWidth;
-    //! Number of points in the array
-    int number;
         //! Meta grid positions in X
-        double* metaX;
-        //! Number of meta grid lines in X
-        int numMetaX;
+        std::vector<double> metaX;
         //! Meta grid positions in Y
-        double* metaY;
-        //! Number of meta grid lines in Y
-        int numMetaY;
+        std::vector<double> metaY;
     bool isometric;
     RS2::CrosshairType crosshairType;
 
+    //! Settings from /Appearance, see loadSettings()
+    bool scaleGrid;
+    int minGridSpacing;
+    bool defaultIsometric;
+    RS2::CrosshairType defaultCrosshairType;
+    RS_Vector defaultGridSpacing;
+
+    //! View geometry and drawing settings the points were computed for
+    bool valid;
+    RS_Vector lastFactor;
+    int lastOffsetX;
+    int lastOffsetY;
+    int lastWidth;
+    int lastHeight;
+    RS_Vector lastUserGrid;
+    RS2::Unit lastUnit;
+    RS2::LinearFormat lastFormat;
+    bool lastIsometric;
+
 };
 
 #endif
@@ -28,6 +28,17 @@
 #include "rs_painter.h"
 
 
+/**
+ * Draws all grid points of the given array (screen coordinates).
+ * The default implementation draws the points one by one.
+ */
+void RS_Painter::drawGridPoints(const QPolygon& pts) {
+    for (int i=0; i<pts.size(); ++i) {
+        drawGridPoint(RS_Vector(pts.at(i).x(), pts.at(i).y()));
+    }
+}
+
+
 void RS_Painter::createArc(QPolygon& pa,
                              const RS_Vector& cp, double radius,
                              double a1, double a2,
@@ -33,6 +33,9 @@
 #include "rs_pen.h"
 #include "rs_vector.h"
 #include <QPainterPath>
+#include <QPolygon>
+
+class QTransform;
 
 
 /**
@@ -81,6 +84,7 @@ public:
     virtual void lineTo(int x, int y) = 0;
 
     virtual void drawGridPoint(const RS_Vector& p) = 0;
+    virtual void drawGridPoints(const QPolygon& pts);
     virtual void drawPoint(const RS_Vector& p) = 0;
     virtual void drawLine(const RS_Vector& p1, const RS_Vector& p2) = 0;
     virtual void drawRect(const RS_Vector& p1, const RS_Vector& p2);
@@ -124,6 +128,11 @@ public:
                               const RS_Vector& p3) = 0;
 
     virtual void drawPath ( const QPainterPath & path ) = 0;
+    /**
+     * Draws a path given in world coordinates through the given transformation
+     * to screen coordinates. The pen width is not affected by the transformation.
+     */
+    virtual void drawTransformedPath(const QPainterPath& path, const QTransform& transform) = 0;
     virtual void drawHandle(const RS_Vector& p, const RS_Color& c, int size=-1);
 
     virtual RS_Pen getPen() const = 0;
@@ -135,6 +144,7 @@ public:
     virtual void setBrush(const RS_Color& color) = 0;
     virtual void setBrush(const QBrush& color) = 0;
     virtual void drawPolygon(const QPolygon& a, Qt::FillRule rule=Qt::WindingFill) = 0;
+    virtual void drawPolyline(const QPolygonF& a) = 0;
     virtual void erase() = 0;
     virtual int getWidth() = 0;
     virtual int getHeight() = 0;
@@ -68,6 +68,21 @@ void RS_PainterQt::drawGridPoint(const RS_Vector& p) {
 
 
 
+/**
+ * Draws all grid points of the given array with a single call.
+ */
+void RS_PainterQt::drawGridPoints(const QPolygon& pts) {
+    int dx = toScreenX(0.0);
+    int dy = toScreenY(0.0);
+    if (dx==0 && dy==0) {
+        QPainter::drawPoints(pts);
+    } else {
+        QPainter::drawPoints(pts.translated(dx, dy));
+    }
+}
+
+
+
 /**
  * Draws a point at (x1, y1).
  */
@@ -551,10 +566,31 @@ void RS_PainterQt::drawPolygon(const QPolygon& a, Qt::FillRule rule) {
     QPainter::drawPolygon(a,rule);
 }
 
+void RS_PainterQt::drawPolyline(const QPolygonF& a) {
+    QPainter::drawPolyline(a);
+}
+
 void RS_PainterQt::drawPath ( const QPainterPath & path ) {
     QPainter::drawPath(path);
 }
 
+void RS_PainterQt::drawTransformedPath(const QPainterPath& path, const QTransform& transform) {
+    // restores only what is changed here instead of the whole state
+    // with save() / restore():
+    const QPen oldPen = QPainter::pen();
+    const QBrush oldBrush = QPainter::brush();
+    const QTransform oldTransform = worldTransform();
+    QPen p = oldPen;
+    p.setCosmetic(true);
+    QPainter::setPen(p);
+    QPainter::setBrush(Qt::NoBrush);
+    setWorldTransform(transform*QTransform::fromTranslate(offset.x, offset.y), true);
+    QPainter::drawPath(path);
+    setWorldTransform(oldTransform);
+    QPainter::setBrush(oldBrush);
+    QPainter::setPen(oldPen);
+}
+
 
 void RS_PainterQt::setClipRect(int x, int y, int w, int h) {
     QPainter::setClipRect(x, y, w, h);
@@ -46,6 +46,7 @@ public:
     virtual void moveTo(int x, int y);
     virtual void lineTo(int x, int y);
     virtual void drawGridPoint(const RS_Vector& p);
+    virtual void drawGridPoints(const QPolygon& pts);
     virtual void drawPoint(const RS_Vector& p);
     virtual void drawLine(const RS_Vector& p1, const RS_Vector& p2);
     //virtual void drawRect(const RS_Vector& p1, const RS_Vector& p2);
@@ -83,7 +84,9 @@ public:
                               const RS_Vector& p3);
 
     virtual void drawPolygon(const QPolygon& a,Qt::FillRule rule=Qt::WindingFill);
+    virtual void drawPolyline(const QPolygonF& a);
     virtual void drawPath ( const QPainterPath & path );
+    virtual void drawTransformedPath(const QPainterPath& path, const QTransform& transform);
     virtual void erase();
     virtual int getWidth();
     /** get Density per millimeter on screen/print device
@@ -226,6 +226,12 @@ RS_VectorSolutions RS_Information::getIntersection(RS_Entity* e1,
         return ret;
     }
     // a little check to avoid doing unneeded intersections, an attempt to avoid O(N^2) increasing of checking two-entity information
+    if (e1->isContainer()) {
+        static_cast<RS_EntityContainer*>(e1)->updateBorders();
+    }
+    if (e2->isContainer()) {
+        static_cast<RS_EntityContainer*>(e2)->updateBorders();
+    }
     if (onEntities &&
             (! (e1 -> isConstruction() || e2 -> isConstruction() ))
             && (
@@ -747,6 +753,7 @@ bool RS_Information::isPointInsideContour(const RS_Vector& point,
         return false;
     }
 
+    contour->updateBorders();
     if (point.x < contour->getMin().x || point.x > contour->getMax().x ||
             point.y < contour->getMin().y || point.y > contour->getMax().y) {
         return false;
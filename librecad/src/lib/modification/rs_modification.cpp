@@ -82,9 +82,9 @@ void RS_Modification::remove() {
         document->startUndoCycle();
     }
 
-    // not safe (?)
-    for (RS_Entity* e=container->firstEntity(); e!=NULL;
-            e=container->nextEntity()) {
+    QList<RS_Entity*> selection = container->getSelection();
+    for (int i=0; i<selection.size(); ++i) {
+        RS_Entity* e = selection.at(i);
 
         if (e!=NULL && e->isSelected()) {
             e->setSelected(false);
@@ -92,14 +92,13 @@ void RS_Modification::remove() {
             if (document!=NULL) {
                 document->addUndoable(e);
             }
+            graphicView->deleteEntity(e);
         }
     }
 
     if (document!=NULL) {
         document->endUndoCycle();
     }
-
-    graphicView->redraw(RS2::RedrawDrawing);
 }
 
 /**
@@ -131,10 +130,6 @@ void RS_Modification::revertDirection()
 	if (document!=NULL && handleUndo) {
 		document->endUndoCycle();
 	}
-
-	if (graphicView!=NULL) {
-		graphicView->redraw(RS2::RedrawDrawing);
-	}
 }
 
 
@@ -201,10 +196,6 @@ bool RS_Modification::changeAttributes(RS_AttributesData& data) {
         document->endUndoCycle();
     }
 
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
-
     return true;
 }
 
@@ -238,14 +229,15 @@ void RS_Modification::copy(const RS_Vector& ref, const bool cut) {
         document->startUndoCycle();
     }
 
-    // copy entities / layers / blocks
-    for (RS_Entity* e=container->firstEntity(); e!=NULL;
+    // copy entities / layers / blocks in drawing order. Stops after the
+    // last selected entity as copyEntity() deselects the originals:
+    unsigned int selected = container->countSelected();
+    for (RS_Entity* e=container->firstEntity(); e!=NULL && selected>0;
             e=container->nextEntity()) {
-        //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
 
         if (e!=NULL && e->isSelected()) {
             copyEntity(e, ref, cut);
+            --selected;
         }
     }
 
@@ -447,7 +439,7 @@ void RS_Modification::paste(const RS_PasteData& data, RS_Graphic* source) {
                 if (b->getName() !=newName) {
                     RS_DIALOGFACTORY->commandMessage( QString(
                            QObject::tr("Block %1 already exist, renamed to: %2")).arg(b->getName()).arg(newName));
-                    b->setName( newName );
+                    source->getBlockList()->rename( b, newName );
                 }
             }
         }
@@ -1458,17 +1450,17 @@ bool RS_Modification::move(RS_MoveData& data) {
         document->startUndoCycle();
     }
 
-    // Create new entites
+    // Create new entites in drawing order, stop after the last selected one
+    unsigned int selected = container->countSelected();
     for (int num=1;
             num<=data.number || (data.number==0 && num<=1);
             num++) {
-        // too slow:
-        //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
+        unsigned int found = 0;
         for (RS_Entity* e=container->firstEntity();
-                e!=NULL;
+                e!=NULL && found<selected;
                 e=container->nextEntity()) {
             if (e!=NULL && e->isSelected()) {
+                ++found;
                 RS_Entity* ec = e->clone();
 
                 ec->move(data.offset*num);
@@ -1494,10 +1486,6 @@ bool RS_Modification::move(RS_MoveData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -1559,10 +1547,6 @@ bool RS_Modification::offset(const RS_OffsetData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -1620,9 +1604,6 @@ bool RS_Modification::rotate(RS_RotateData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
 
     return true;
 }
@@ -1719,10 +1700,6 @@ bool RS_Modification::scale(RS_ScaleData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -1780,10 +1757,6 @@ bool RS_Modification::mirror(RS_MirrorData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -1845,10 +1818,6 @@ bool RS_Modification::rotate2(RS_Rotate2Data& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -1907,9 +1876,6 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
 
     return true;
 }
@@ -1923,12 +1889,9 @@ bool RS_Modification::moveRotate(RS_MoveRotateData& data) {
  */
 void RS_Modification::deselectOriginals(bool remove
                                        ) {
-    for (RS_Entity* e=container->firstEntity();
-            e!=NULL;
-            e=container->nextEntity()) {
-
-        //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
+    QList<RS_Entity*> selection = container->getSelection();
+    for (int i=0; i<selection.size(); ++i) {
+        RS_Entity* e = selection.at(i);
 
         if (e!=NULL) {
             bool selected = false;
@@ -1952,17 +1915,17 @@ void RS_Modification::deselectOriginals(bool remove
                 e->setSelected(false);
                 if (remove
                    ) {
-                    //if (graphicView!=NULL) {
-                    //    graphicView->deleteEntity(e);
-                    //}
+                    if (graphicView!=NULL) {
+                        graphicView->deleteEntity(e);
+                    }
                     e->changeUndoState();
                     if (document!=NULL && handleUndo) {
                         document->addUndoable(e);
                     }
                 } else {
-                    //if (graphicView!=NULL) {
-                    //    graphicView->drawEntity(e);
-                    //}
+                    if (graphicView!=NULL) {
+                        graphicView->drawEntity(e);
+                    }
                 }
             }
         }
@@ -1984,9 +1947,9 @@ void RS_Modification::addNewEntities(QList<RS_Entity*>& addList) {
             if (document!=NULL && handleUndo) {
                 document->addUndoable(addList.at(i));
             }
-            //if (graphicView!=NULL) {
-            //    graphicView->drawEntity(e);
-            //}
+            if (graphicView!=NULL) {
+                graphicView->drawEntity(addList.at(i));
+            }
         }
     }
 }
@@ -2448,10 +2411,6 @@ bool RS_Modification::stretch(const RS_Vector& firstCorner,
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -3056,6 +3015,9 @@ bool RS_Modification::explode() {
                 }
             } else {
                 e->setSelected(false);
+                if (graphicView!=NULL) {
+                    graphicView->drawEntity(e);
+                }
             }
         }
     }
@@ -3067,10 +3029,6 @@ bool RS_Modification::explode() {
         document->endUndoCycle();
     }
 
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
-
     return true;
 }
 
@@ -3103,6 +3061,9 @@ bool RS_Modification::explodeTextIntoLetters() {
                 explodeTextIntoLetters(text, addList);
             } else {
                 e->setSelected(false);
+                if (graphicView!=NULL) {
+                    graphicView->drawEntity(e);
+                }
             }
         }
     }
@@ -3114,10 +3075,6 @@ bool RS_Modification::explodeTextIntoLetters() {
         document->endUndoCycle();
     }
 
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
-
     return true;
 }
 
@@ -3130,6 +3087,8 @@ bool RS_Modification::explodeTextIntoLetters(RS_MText* text, QList<RS_Entity*>&
 
     if(text->isLocked() || ! text->isVisible()) return false;
 
+    text->createLetters();
+
     // iterate though lines:
     for (RS_Entity* e2 = text->firstEntity(); e2!=NULL;
             e2 = text->nextEntity()) {
@@ -3196,6 +3155,8 @@ bool RS_Modification::explodeTextIntoLetters(RS_Text* text, QList<RS_Entity*>& a
 
     if(text->isLocked() || ! text->isVisible()) return false;
 
+    text->createLetters();
+
     // iterate though letters:
     for (RS_Entity* e2 = text->firstEntity(); e2!=NULL;
             e2 = text->nextEntity()) {
@@ -3269,10 +3230,6 @@ bool RS_Modification::moveRef(RS_MoveRefData& data) {
     if (document!=NULL && handleUndo) {
         document->endUndoCycle();
     }
-
-    if (graphicView!=NULL) {
-        graphicView->redraw(RS2::RedrawDrawing);
-    }
     return true;
 }
 
@@ -79,14 +79,23 @@ void RS_Selection::selectAll(bool select) {
     }
 
     //container->setSelected(select);
-    for (RS_Entity* e=container->firstEntity();
-             e!=NULL;
-             e=container->nextEntity()) {
-    //for (unsigned i=0; i<container->count(); ++i) {
-        //RS_Entity* e = container->entityAt(i);
+    if (select) {
+        for (RS_Entity* e=container->firstEntity();
+                 e!=NULL;
+                 e=container->nextEntity()) {
 
-        if (e!=NULL && e->isVisible()) {
-            e->setSelected(select);
+            if (e!=NULL && e->isVisible()) {
+                e->setSelected(select);
+            }
+        }
+    } else {
+        // deselecting only needs to visit the current selection:
+        QList<RS_Entity*> selection = container->getSelection();
+        for (int i=0; i<selection.size(); ++i) {
+            RS_Entity* e = selection.at(i);
+            if (e!=NULL && e->isVisible()) {
+                e->setSelected(false);
+            }
         }
     }
 
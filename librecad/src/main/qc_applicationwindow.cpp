@@ -75,11 +75,14 @@
 #include "rs_mtext.h"
 #include "rs_text.h"
 #include "rs_settings.h"
+#include "rs_grid.h"
 #include "rs_staticgraphicview.h"
 #include "rs_system.h"
 #include "rs_actionlibraryinsert.h"
 #include "rs_painterqt.h"
 #include "rs_selection.h"
+#include "lc_memoryreport.h"
+#include "lc_profiler.h"
 
 #include "qg_cadtoolbar.h"
 #include "qg_snaptoolbar.h"
@@ -781,6 +784,19 @@ void QC_ApplicationWindow::initActions(void)
     connect(action, SIGNAL(triggered()),
             this, SLOT(slotFocusCommandLine()));
     menu->addAction(action);
+
+    menu->addSeparator();
+    action = new QAction(tr("&Performance Overlay"), this);
+    action->setCheckable(true);
+    action->setChecked(LC_Profiler::isEnabled() && LC_PROFILER->isOverlayVisible());
+    connect(action, SIGNAL(toggled(bool)),
+            this, SLOT(slotViewPerformanceOverlay(bool)));
+    menu->addAction(action);
+
+    action = new QAction(tr("&Dump Performance Counters..."), this);
+    connect(action, SIGNAL(triggered()),
+            this, SLOT(slotDumpPerformanceCounters()));
+    menu->addAction(action);
     //addToolBar(tb, tr("View"));
     addToolBar(Qt::TopToolBarArea, zoomToolBar); //tr("View");
 
@@ -1035,6 +1051,10 @@ void QC_ApplicationWindow::initActions(void)
     connect(testDumpUndo, SIGNAL(triggered()),
             this, SLOT(slotTestDumpUndo()));
 
+    testMemoryReport = new QAction("Memory Report", this);
+    connect(testMemoryReport, SIGNAL(triggered()),
+            this, SLOT(slotTestMemoryReport()));
+
 /* RVT_PORT    testUpdateInserts = new QAction("Update Inserts",
                                     "&Update Inserts", 0, this); */
     testUpdateInserts = new QAction("Update Inserts", this);
@@ -1174,6 +1194,7 @@ void QC_ApplicationWindow::initMenuBar() {
         testMenu->setObjectName("Debugging");
         testMenu->addAction(testDumpEntities);
         testMenu->addAction(testDumpUndo);
+        testMenu->addAction(testMemoryReport);
         testMenu->addAction(testUpdateInserts);
         testMenu->addAction(testDrawFreehand);
         testMenu->addAction(testInsertBlock);
@@ -1625,6 +1646,54 @@ void QC_ApplicationWindow::slotFocusCommandLine() {
 }
 
 
+/**
+ * Shows or hides the timers of LC_Profiler on top of the drawing.
+ * Showing them starts the profiler, hiding keeps it collecting for
+ * slotDumpPerformanceCounters().
+ */
+void QC_ApplicationWindow::slotViewPerformanceOverlay(bool on) {
+    if (on) {
+        LC_PROFILER->setEnabled(true);
+    }
+    LC_PROFILER->setOverlayVisible(on);
+
+    RS_GraphicView* gv = getGraphicView();
+    if (gv!=NULL) {
+        gv->redraw(RS2::RedrawOverlay);
+    }
+}
+
+
+
+/**
+ * Writes the timers and counters of LC_Profiler to a file, e.g. to
+ * send it to the support. If the profiler is not running yet, starts
+ * it instead, so the slow operation can be repeated first.
+ */
+void QC_ApplicationWindow::slotDumpPerformanceCounters() {
+    if (!LC_Profiler::isEnabled()) {
+        LC_PROFILER->setEnabled(true);
+        statusBar()->showMessage(tr("Performance counters started, repeat the slow "
+                                    "operation and dump them again"), 5000);
+        return;
+    }
+
+    QString fn = QFileDialog::getSaveFileName(this, tr("Dump Performance Counters"),
+                                              QDir::homePath() + "/librecad_performance.txt",
+                                              tr("Text files (*.txt)"));
+    if (fn.isEmpty()) {
+        return;
+    }
+    if (LC_PROFILER->dump(fn)) {
+        statusBar()->showMessage(tr("Performance counters written to %1").arg(fn), 2000);
+    } else {
+        QMessageBox::warning(this, tr("Warning"),
+                             tr("Cannot write the file %1").arg(fn));
+    }
+}
+
+
+
 /**
  * Shows the given error on the command line.
  */
@@ -3447,6 +3516,7 @@ void QC_ApplicationWindow::slotOptionsGeneral() {
 				gv->setStartHandleColor(startHandleColor);
 				gv->setHandleColor(handleColor);
 				gv->setEndHandleColor(endHandleColor);
+                gv->getGrid()->loadSettings();
 //                gv->updateGrid();
                 gv->redraw(RS2::RedrawGrid);
             }
@@ -3953,6 +4023,31 @@ void QC_ApplicationWindow::slotTestDumpUndo() {
 
 
 
+/**
+ * Testing function.
+ */
+void QC_ApplicationWindow::slotTestMemoryReport() {
+    RS_DEBUG->print("QC_ApplicationWindow::slotTestMemoryReport()");
+
+    RS_Document* d = getDocument();
+    if (d!=NULL) {
+        LC_MemoryReport report(d);
+        QString text = report.toString();
+        RS_DEBUG->print(RS_Debug::D_INFORMATIONAL, "%s", text.toLatin1().data());
+
+        LC_MemoryReport::Row total = report.total();
+        QMessageBox box(QMessageBox::Information, tr("Memory Report"),
+                        tr("%1 entities use %2 KiB.")
+                        .arg((qulonglong)total.count)
+                        .arg((qulonglong)(total.objectBytes+total.extraBytes)/1024),
+                        QMessageBox::Ok, this);
+        box.setDetailedText(text);
+        box.exec();
+    }
+}
+
+
+
 /**
  * Testing function.
  */
@@ -104,6 +104,8 @@ public slots:
     //void slotNext();
     void slotEnter();
     void slotFocusCommandLine();
+    void slotViewPerformanceOverlay(bool on);
+    void slotDumpPerformanceCounters();
         void slotError(const QString& msg);
 
     void slotWindowActivated(int);
@@ -190,6 +192,8 @@ public slots:
     void slotTestDumpEntities(RS_EntityContainer* d=NULL);
     /** dumps undo info to stdout */
     void slotTestDumpUndo();
+    /** prints memory used per entity type to stdout */
+    void slotTestMemoryReport();
     /** updates all inserts */
     void slotTestUpdateInserts();
     /** draws some random lines */
@@ -447,6 +451,7 @@ private:
 
     QAction *testDumpEntities;
     QAction *testDumpUndo;
+    QAction *testMemoryReport;
     QAction *testUpdateInserts;
     QAction *testDrawFreehand;
     QAction *testInsertBlock;
@@ -22,8 +22,7 @@ include(../../common.pri)
 include(./boost.pri)
 include(./muparser.pri)
 
-#uncomment to use 2D rs_vector instead of 3D
-#DEFINES += RS_VECTOR2D=1
+# to use 2D rs_vector instead of 3D run qmake with CONFIG+=vector2d (see common.pri)
 
 CONFIG += qt \
      warn_on \
@@ -123,6 +122,8 @@ HEADERS += \
     lib/actions/rs_snapper.h \
     lib/creation/rs_creation.h \
     lib/debug/rs_debug.h \
+    lib/debug/lc_memoryreport.h \
+    lib/debug/lc_profiler.h \
     lib/engine/rs.h \
     lib/engine/rs_arc.h \
     lib/engine/rs_atomicentity.h \
@@ -150,6 +151,7 @@ HEADERS += \
     lib/engine/rs_graphic.h \
     lib/engine/rs_hatch.h \
     lib/engine/lc_hyperbola.h \
+    lib/engine/lc_entitypool.h \
     lib/engine/rs_insert.h \
     lib/engine/rs_image.h \
     lib/engine/rs_layer.h \
@@ -169,6 +171,9 @@ HEADERS += \
     lib/engine/rs_solid.h \
     lib/engine/rs_spline.h \
     lib/engine/lc_splinepoints.h \
+    lib/engine/lc_vectorops.h \
+    lib/engine/lc_parallel.h \
+    lib/engine/lc_textlayout.h \
     lib/engine/rs_system.h \
     lib/engine/rs_text.h \
     lib/engine/rs_undo.h \
@@ -199,6 +204,7 @@ HEADERS += \
     lib/gui/rs_painter.h \
     lib/gui/rs_painterqt.h \
     lib/gui/rs_staticgraphicview.h \
+    lib/gui/lc_rendercontext.h \
     lib/information/rs_locale.h \
     lib/information/rs_information.h \
     lib/information/rs_infoarea.h \
@@ -222,6 +228,8 @@ SOURCES += \
     lib/actions/rs_snapper.cpp \
     lib/creation/rs_creation.cpp \
     lib/debug/rs_debug.cpp \
+    lib/debug/lc_memoryreport.cpp \
+    lib/debug/lc_profiler.cpp \
     lib/engine/rs_arc.cpp \
     lib/engine/rs_block.cpp \
     lib/engine/rs_blocklist.cpp \
@@ -243,6 +251,7 @@ SOURCES += \
     lib/engine/rs_graphic.cpp \
     lib/engine/rs_hatch.cpp \
     lib/engine/lc_hyperbola.cpp \
+    lib/engine/lc_entitypool.cpp \
     lib/engine/rs_insert.cpp \
     lib/engine/rs_image.cpp \
     lib/engine/rs_layer.cpp \
@@ -260,6 +269,8 @@ SOURCES += \
     lib/engine/rs_solid.cpp \
     lib/engine/rs_spline.cpp \
     lib/engine/lc_splinepoints.cpp \
+    lib/engine/lc_parallel.cpp \
+    lib/engine/lc_textlayout.cpp \
     lib/engine/rs_system.cpp \
     lib/engine/rs_text.cpp \
     lib/engine/rs_undo.cpp \
@@ -282,6 +293,7 @@ SOURCES += \
     lib/gui/rs_painter.cpp \
     lib/gui/rs_painterqt.cpp \
     lib/gui/rs_staticgraphicview.cpp \
+    lib/gui/lc_rendercontext.cpp \
     lib/information/rs_locale.cpp \
     lib/information/rs_information.cpp \
     lib/information/rs_infoarea.cpp \
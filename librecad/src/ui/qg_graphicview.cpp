@@ -29,6 +29,10 @@
 #include <QGridLayout>
 #include <QLabel>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
 #if QT_VERSION >= 0x050200
 #include <QNativeGestureEvent>
 #endif
@@ -41,6 +45,7 @@
 #include "rs_actionselectsingle.h"
 #include "rs_settings.h"
 #include "rs_painterqt.h"
+#include "lc_profiler.h"
 #include "qg_cadtoolbar.h"
 #include "rs_dialogfactory.h"
 #include "qg_dialogfactory.h"
@@ -50,6 +55,17 @@
 
 #define QG_SCROLLMARGIN 400
 
+namespace {
+/** Visible entities from which on the drawing is drawn progressively. */
+const size_t minProgressiveEntities = 20000;
+/** Milliseconds spent on one slice of a progressive redraw. */
+const qint64 sliceTime = 30;
+/** Largest number of entities drawn ahead as coarse preview. */
+const size_t maxCoarseEntities = 2000;
+/** Entities drawn at once in a slice at first, adapted to the speed. */
+const size_t firstChunkEntities = 1024;
+}
+
 
 /**
  * Constructor.
@@ -62,6 +78,12 @@ QG_GraphicView::QG_GraphicView(QWidget* parent, const char* name, Qt::WindowFlag
 
     redrawMethod=RS2::RedrawAll;
     isSmoothScrolling = false;
+    drawQueueNext = drawQueueSelected = 0;
+    drawChunk = firstChunkEntities;
+    sliceParallel = false;
+    sliceScheduled = false;
+    mouseMoving = false;
+    dirtyMin = dirtyMax = RS_Vector(false);
 
     PixmapLayer1=PixmapLayer2=PixmapLayer3=NULL;
 
@@ -275,13 +297,75 @@ void QG_GraphicView::updateGridStatusWidget(const QString& text) {
  * Redraws the widget.
  */
 void QG_GraphicView::redraw(RS2::RedrawMethod method) {
+        if (LC_Profiler::isEnabled()) {
+            if (method & RS2::RedrawGrid) countRedraw("grid");
+            if (method & RS2::RedrawDrawing) countRedraw("drawing");
+            if (method & RS2::RedrawOverlay) countRedraw("overlay");
+        }
         redrawMethod=(RS2::RedrawMethod ) (redrawMethod | method);
+        // the entities of an unfinished progressive redraw are outdated:
+        if (method & RS2::RedrawDrawing) {
+            drawQueue.clear();
+        }
         update(); // Paint when reeady to pain
 //	repaint(); //Paint immediate
 }
 
 
 
+/**
+ * Marks the region between v1 and v2 for repainting. Regions are
+ * joined until the next paint event.
+ */
+void QG_GraphicView::redrawRegion(const RS_Vector& v1, const RS_Vector& v2) {
+    // the queue of an unfinished progressive redraw may hold the modified
+    // or deleted entity, the redraw starts over instead:
+    if (!drawQueue.empty()) {
+        redraw(RS2::RedrawDrawing);
+        return;
+    }
+    // borders of empty containers:
+    if (!v1.valid || !v2.valid ||
+            std::max(std::fabs(v1.x), std::fabs(v1.y))>=RS_MAXDOUBLE ||
+            std::max(std::fabs(v2.x), std::fabs(v2.y))>=RS_MAXDOUBLE) {
+        return;
+    }
+    if (LC_Profiler::isEnabled()) {
+        countRedraw("region");
+    }
+    RS_Vector vMin = RS_Vector::minimum(v1, v2);
+    RS_Vector vMax = RS_Vector::maximum(v1, v2);
+    if (dirtyMin.valid) {
+        vMin = RS_Vector::minimum(vMin, dirtyMin);
+        vMax = RS_Vector::maximum(vMax, dirtyMax);
+    }
+    dirtyMin = vMin;
+    dirtyMax = vMax;
+    update();
+}
+
+
+
+/**
+ * Counts a request to repaint the given layer as
+ * "redraw/<action class>/<layer>". Requests made while a mouse move is
+ * handled are counted separately: those should only need the overlay,
+ * anything else makes the mouse feedback depend on the drawing size.
+ */
+void QG_GraphicView::countRedraw(const char* layer) {
+    RS_ActionInterface* action = getCurrentAction();
+    QByteArray name("redraw/");
+    name += action!=NULL ? action->metaObject()->className() : "none";
+    name += '/';
+    name += layer;
+    if (mouseMoving) {
+        name += " on mouse move";
+    }
+    LC_PROFILER->addCount(name, 1);
+}
+
+
+
 void QG_GraphicView::resizeEvent(QResizeEvent* /*e*/) {
     RS_DEBUG->print("QG_GraphicView::resizeEvent begin");
     adjustOffsetControls();
@@ -350,7 +434,9 @@ void QG_GraphicView::mouseMoveEvent(QMouseEvent* e) {
     //RS_DEBUG->print("QG_GraphicView::mouseMoveEvent begin");
     //QMouseEvent rsm = QG_Qt2Rs::mouseEvent(e);
 
+    mouseMoving = true;
     RS_GraphicView::mouseMoveEvent(e);
+    mouseMoving = false;
     QWidget::mouseMoveEvent(e);
 
 #ifdef Q_OS_WIN32
@@ -671,6 +757,7 @@ void QG_GraphicView::adjustOffsetControls() {
     int ox = getOffsetX();
     int oy = getOffsetY();
 
+    container->updateBorders();
     RS_Vector min = container->getMin();
     RS_Vector max = container->getMax();
 
@@ -845,10 +932,24 @@ void QG_GraphicView::layerActivated(RS_Layer *layer) {
  */
 void QG_GraphicView::paintEvent(QPaintEvent *) {
     RS_DEBUG->print("QG_GraphicView::paintEvent begin");
-
+    LC_PROFILE_SCOPE("paint");
+    // frames which don't repaint the grid or the drawing are timed apart:
+    LC_ScopedTimer frameTimer((redrawMethod & ~RS2::RedrawOverlay)==0 && !dirtyMin.valid ?
+                              "paint/overlay only" : "paint/with layers");
+
+    // an overlay update (mouse move feedback) only repaints the overlay and
+    // composites the cached grid and drawing, its cost doesn't depend on
+    // the size of the drawing:
+    bool draftMode = false;
+    bool parallel = false;
+    bool progressive = false;
+    if ((redrawMethod & RS2::RedrawDrawing) || dirtyMin.valid) {
         RS_SETTINGS->beginGroup("/Appearance");
-    bool draftMode = (bool)RS_SETTINGS->readNumEntry("/DraftMode", 0);
-    RS_SETTINGS->endGroup();
+        draftMode = (bool)RS_SETTINGS->readNumEntry("/DraftMode", 0);
+        parallel = (bool)RS_SETTINGS->readNumEntry("/ParallelRendering", 1);
+        progressive = (bool)RS_SETTINGS->readNumEntry("/ProgressiveRendering", 1);
+        RS_SETTINGS->endGroup();
+    }
 
 
         // Re-Create or get the layering pixmaps
@@ -858,6 +959,7 @@ void QG_GraphicView::paintEvent(QPaintEvent *) {
 
     // Draw Layer 1
         if (redrawMethod & RS2::RedrawGrid) {
+                LC_PROFILE_SCOPE("paint/grid");
                 PixmapLayer1->fill(background);
                 RS_PainterQt painter1(PixmapLayer1);
                 //painter1->setBackgroundMode(Qt::OpaqueMode);
@@ -869,21 +971,46 @@ void QG_GraphicView::paintEvent(QPaintEvent *) {
 
 
         if (redrawMethod & RS2::RedrawDrawing) {
+                LC_PROFILE_SCOPE("paint/entities");
                 // DRaw layer 2
                 PixmapLayer2->fill(Qt::transparent);
                 RS_PainterQt painter2(PixmapLayer2);
                 painter2.setDrawingMode(drawingMode);
                 setDraftMode(draftMode);
-        painter2.setDrawSelectedOnly(false);
-        drawLayer2((RS_Painter*)&painter2);
-        painter2.setDrawSelectedOnly(true);
-        drawLayer2((RS_Painter*)&painter2);
+        // huge drawings are drawn in slices, large ones by all cores
+        // and small ones by this thread:
+        drawQueue.clear();
+        sliceParallel = parallel;
+        if (progressive && startProgressiveDraw(&painter2)) {
+            if (!drawSlice(&painter2) && !sliceScheduled) {
+                sliceScheduled = true;
+                QTimer::singleShot(0, this, SLOT(drawNextSlice()));
+            }
+        } else if (!parallel || !drawLayer2Parallel(&painter2)) {
+            painter2.setDrawSelectedOnly(false);
+            drawLayer2((RS_Painter*)&painter2);
+            painter2.setDrawSelectedOnly(true);
+            drawLayer2((RS_Painter*)&painter2);
+        }
         //removed to solve bug #3470573
 //        setDraftMode(false);
                 painter2.end();
-        }
+        } else if (dirtyMin.valid) {
+        // only the region of modified entities:
+        LC_PROFILE_SCOPE("paint/region");
+        QRect rect = getDirtyRect();
+        RS_PainterQt painter2(PixmapLayer2);
+        painter2.setCompositionMode(QPainter::CompositionMode_Source);
+        painter2.QPainter::fillRect(rect, Qt::transparent);
+        painter2.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter2.setDrawingMode(drawingMode);
+        setDraftMode(draftMode);
+        drawLayer2Region(&painter2, rect);
+        painter2.end();
+    }
 
     if (redrawMethod & RS2::RedrawOverlay) {
+        LC_PROFILE_SCOPE("paint/overlay");
         PixmapLayer3->fill(Qt::transparent);
         RS_PainterQt painter3(PixmapLayer3);
         drawLayer3((RS_Painter*)&painter3);
@@ -896,9 +1023,223 @@ void QG_GraphicView::paintEvent(QPaintEvent *) {
         wPainter.drawPixmap(0,0,*PixmapLayer1);
         wPainter.drawPixmap(0,0,*PixmapLayer2);
         wPainter.drawPixmap(0,0,*PixmapLayer3);
+        if (LC_Profiler::isEnabled() && LC_PROFILER->isOverlayVisible()) {
+            drawProfilerOverlay(wPainter);
+        }
         wPainter.end();
 
         redrawMethod=RS2::RedrawNone;
+    dirtyMin = dirtyMax = RS_Vector(false);
     RS_DEBUG->print("QG_GraphicView::paintEvent end");
 }
 
+
+
+/**
+ * @return The dirty region on the screen, grown by half of the widest
+ * pen and a few pixels for point markers.
+ */
+QRect QG_GraphicView::getDirtyRect() {
+    const LC_RenderContext& rc = getRenderContext(NULL);
+    const double pad = 8. + toGuiDX(RS2::Width23/100.*rc.unitFactor*rc.widthFactor)/2.;
+    const double w = getWidth();
+    const double h = getHeight();
+    RS_Vector bl = toGui(dirtyMin);
+    RS_Vector tr = toGui(dirtyMax);
+    // limited to the view before converting, points may be far outside:
+    int x1 = (int)std::floor(std::max(-1., bl.x-pad));
+    int x2 = (int)std::ceil(std::min(w+1., tr.x+pad));
+    int y1 = (int)std::floor(std::max(-1., tr.y-pad));
+    int y2 = (int)std::ceil(std::min(h+1., bl.y+pad));
+    return QRect(QPoint(x1, y1), QPoint(x2, y2)).intersected(QRect(0, 0, getWidth(), getHeight()));
+}
+
+
+
+/**
+ * Starts a progressive redraw of the drawing if it has enough entities
+ * in the viewport. The entities are queued for drawSlice(): the largest
+ * ones first as coarse preview, then the others in drawing order and at
+ * last the selected ones. Every entity is drawn once, the preview ones
+ * end up below the others where they overlap.
+ *
+ * @return false if the drawing is too small, nothing is queued then.
+ */
+bool QG_GraphicView::startProgressiveDraw(RS_PainterQt* painter) {
+    if (container==NULL || container->count()<minProgressiveEntities) {
+        return false;
+    }
+
+    updateRenderContext(painter);
+    const LC_RenderContext& rc = getRenderContext(painter);
+
+    std::vector<RS_Entity*> visible;
+    std::vector<RS_Entity*> selected;
+    std::vector<std::pair<double, size_t> > sizes;
+    visible.reserve(container->count());
+    const double coarseSize = std::max(getWidth(), getHeight())/8.0;
+    const bool construction = hasConstructionLayers();
+    for (unsigned i=0; i<container->count(); ++i) {
+        RS_Entity* e = container->entityAt(i);
+        if (!e->isVisible()) {
+            continue;
+        }
+        const RS_Vector& min = e->getMin();
+        const RS_Vector& max = e->getMax();
+        // construction lines cross the view beyond their borders:
+        if ((max.x<rc.viewportMin.x || min.x>rc.viewportMax.x ||
+                max.y<rc.viewportMin.y || min.y>rc.viewportMax.y) &&
+                (!construction || !hasConstructionLines(e))) {
+            continue;
+        }
+        const double size = toGuiDX(std::max(max.x-min.x, max.y-min.y));
+        if (size>=coarseSize) {
+            sizes.push_back(std::make_pair(size, visible.size()));
+        }
+        visible.push_back(e);
+        if (e->isSelected() || (e->isContainer() &&
+                                ((RS_EntityContainer*)e)->countSelected()>0)) {
+            selected.push_back(e);
+        }
+    }
+    if (visible.size()<minProgressiveEntities) {
+        return false;
+    }
+
+    // the largest entities, in drawing order:
+    if (sizes.size()>maxCoarseEntities) {
+        std::nth_element(sizes.begin(), sizes.begin()+maxCoarseEntities, sizes.end(),
+                         [](const std::pair<double, size_t>& a,
+                            const std::pair<double, size_t>& b) {
+            return a.first>b.first;
+        });
+        sizes.resize(maxCoarseEntities);
+    }
+    std::sort(sizes.begin(), sizes.end(),
+              [](const std::pair<double, size_t>& a,
+                 const std::pair<double, size_t>& b) {
+        return a.second<b.second;
+    });
+
+    drawQueue.reserve(visible.size() + selected.size());
+    std::vector<char> coarse(visible.size(), 0);
+    for (const std::pair<double, size_t>& s: sizes) {
+        drawQueue.push_back(visible[s.second]);
+        coarse[s.second] = 1;
+    }
+    for (size_t i=0; i<visible.size(); ++i) {
+        if (!coarse[i]) {
+            drawQueue.push_back(visible[i]);
+        }
+    }
+    drawQueueSelected = drawQueue.size();
+    drawQueue.insert(drawQueue.end(), selected.begin(), selected.end());
+    drawQueueNext = 0;
+    return true;
+}
+
+
+
+/**
+ * Draws the queued entities of a progressive redraw for about
+ * sliceTime milliseconds. Unselected entities are drawn in chunks by
+ * all cores if parallel rendering is on, the chunk size follows the
+ * drawing speed so that a chunk takes a fraction of a slice.
+ *
+ * @return true if the drawing is complete.
+ */
+bool QG_GraphicView::drawSlice(RS_PainterQt* painter) {
+    LC_PROFILE_SCOPE("paint/slice");
+    QElapsedTimer timer;
+    timer.start();
+    while (drawQueueNext<drawQueueSelected) {
+        const size_t last = std::min(drawQueueSelected, drawQueueNext + drawChunk);
+        const qint64 start = timer.elapsed();
+        if (sliceParallel) {
+            drawEntitiesParallel(painter, drawQueue, drawQueueNext, last);
+        } else {
+            painter->setDrawSelectedOnly(false);
+            for (size_t i=drawQueueNext; i<last; ++i) {
+                drawEntity(painter, drawQueue[i]);
+            }
+        }
+        drawQueueNext = last;
+        const qint64 chunkTime = timer.elapsed() - start;
+        if (chunkTime*4<sliceTime && drawChunk<drawQueue.size()) {
+            drawChunk *= 2;
+        } else if (chunkTime>sliceTime && drawChunk>16) {
+            drawChunk /= 2;
+        }
+        if (timer.elapsed()>=sliceTime) {
+            return false;
+        }
+    }
+    painter->setDrawSelectedOnly(true);
+    while (drawQueueNext<drawQueue.size()) {
+        drawEntity(painter, drawQueue[drawQueueNext++]);
+        if ((drawQueueNext & 15)==0 && timer.elapsed()>=sliceTime) {
+            return false;
+        }
+    }
+
+    drawQueue.clear();
+    if (!isPrintPreview())
+        drawAbsoluteZero(painter);
+    return true;
+}
+
+
+
+/**
+ * Continues a progressive redraw and shows what's drawn so far. Events
+ * in between can change the view, that restarts the redraw.
+ */
+void QG_GraphicView::drawNextSlice() {
+    sliceScheduled = false;
+    if (drawQueue.empty() || PixmapLayer2==NULL) {
+        return;
+    }
+    // view changed without a redraw:
+    if (!renderContext.matches(this) ||
+            PixmapLayer2->width()!=getWidth() || PixmapLayer2->height()!=getHeight()) {
+        redraw(RS2::RedrawDrawing);
+        return;
+    }
+
+    RS_PainterQt painter(PixmapLayer2);
+    painter.setDrawingMode(drawingMode);
+    bool done = drawSlice(&painter);
+    painter.end();
+
+    if (!done) {
+        sliceScheduled = true;
+        QTimer::singleShot(0, this, SLOT(drawNextSlice()));
+    }
+    update();
+}
+
+
+
+/**
+ * Draws the slowest timers of LC_Profiler into the top left corner.
+ * The numbers are those of the frames before the current one.
+ */
+void QG_GraphicView::drawProfilerOverlay(QPainter& painter) {
+    QStringList lines = LC_PROFILER->summary(12);
+    if (lines.isEmpty()) {
+        lines << tr("No measurements yet");
+    }
+
+    QFontMetrics fm(painter.font());
+    int w = 0;
+    for (const QString& l: lines) {
+        w = qMax(w, fm.width(l));
+    }
+    QRect r(8, 8, w + 12, fm.height()*lines.size() + 8);
+    painter.fillRect(r, QColor(0, 0, 0, 160));
+    painter.setPen(Qt::white);
+    for (int i=0; i<lines.size(); ++i) {
+        painter.drawText(r.left() + 6, r.top() + 4 + fm.ascent() + i*fm.height(), lines.at(i));
+    }
+}
+
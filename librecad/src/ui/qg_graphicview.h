@@ -28,6 +28,7 @@
 #define QG_GRAPHICVIEW_H
 
 #include <QWidget>
+#include <vector>
 
 #include "rs_graphicview.h"
 #include "rs_layerlistlistener.h"
@@ -57,6 +58,7 @@ public:
     virtual int getWidth();
     virtual int getHeight();
 	virtual void redraw(RS2::RedrawMethod method=RS2::RedrawAll);
+    virtual void redrawRegion(const RS_Vector& v1, const RS_Vector& v2);
     virtual void adjustOffsetControls();
     virtual void adjustZoomControls();
     virtual void setBackground(const RS_Color& bg);
@@ -103,9 +105,17 @@ protected:
     void paintEvent(QPaintEvent *);
     virtual void resizeEvent(QResizeEvent* e);
 
+    void drawProfilerOverlay(QPainter& painter);
+
+    bool startProgressiveDraw(RS_PainterQt* painter);
+    bool drawSlice(RS_PainterQt* painter);
+    QRect getDirtyRect();
+    void countRedraw(const char* layer);
+
 private slots:
     void slotHScrolled(int value);
     void slotVScrolled(int value);
+    void drawNextSlice();
 
 protected:
     //! Horizontal scrollbar.
@@ -141,6 +151,27 @@ protected:
 		
     //! Keep tracks of if we are currently doing a high-resolution scrolling
     bool isSmoothScrolling;
+
+    //! Entities left to draw into PixmapLayer2, see drawSlice(). Any redraw
+    //! or region request discards them.
+    std::vector<RS_Entity*> drawQueue;
+    //! Next entry of drawQueue.
+    size_t drawQueueNext;
+    //! Entries from here on are drawn as selected.
+    size_t drawQueueSelected;
+    //! Entities drawn at once by drawSlice(), adapted to the speed.
+    size_t drawChunk;
+    //! True if drawSlice() draws the chunks by all cores.
+    bool sliceParallel;
+    //! True while drawNextSlice() is scheduled.
+    bool sliceScheduled;
+
+    //! True while a mouse move is handled, see countRedraw().
+    bool mouseMoving;
+
+    //! Corners of the region of the drawing to repaint, invalid if none.
+    RS_Vector dirtyMin;
+    RS_Vector dirtyMax;
 };
 
 #endif
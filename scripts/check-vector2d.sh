@@ -0,0 +1,21 @@
+#!/bin/sh
+
+# Builds LibreCAD with the 2D RS_Vector (qmake CONFIG+=vector2d) in a
+# separate build directory and runs the vector benchmark suite, which
+# fails if the LC_VectorOps results differ from RS_Vector.
+#
+# Usage: scripts/check-vector2d.sh [points]
+# Set QMAKE to use another qmake than the one in PATH.
+
+scriptpath="$( readlink -f "${0}" )"
+scriptpath="${scriptpath%/*}"
+points="${1:-1000000}"
+
+builddir="${scriptpath}/../build-vector2d"
+mkdir -p "${builddir}" || exit 1
+cd "${builddir}" || exit 1
+
+${QMAKE:-qmake} ../librecad.pro CONFIG+=vector2d CONFIG+=benchmarks || exit 1
+make -j$( getconf _NPROCESSORS_ONLN ) || exit 1
+
+unix/librecad_bench --filter vector --size "${points}"